@@ -360,6 +360,7 @@ macx {
 # additional flags for Linux
 unix:!macx {
     cache()
+    LIBS += -lrt   # for shm_open (sharded simulation)
 }
 
 # libraries for all OSes
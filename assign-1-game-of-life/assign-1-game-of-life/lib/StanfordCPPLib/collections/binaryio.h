@@ -0,0 +1,485 @@
+/*
+ * File: binaryio.h
+ * ----------------
+ * This file exports functions that save and load collections in a compact
+ * binary form, as a much faster alternative to the text form written by
+ * <code>operator &lt;&lt;</code> and read by <code>operator &gt;&gt;</code>.
+ * Numbers, bools, and other plain values are stored as their raw bytes,
+ * and whole rows of a Grid or runs of a Vector of them are copied in one
+ * block, so that saving and loading run at close to the speed of the
+ * stream itself.
+ *
+ * The data start with a short header naming the type of collection, so
+ * that reading a Grid&lt;int&gt; back as (say) a Vector&lt;double&gt; is
+ * reported as an error rather than producing garbage.  An optional
+ * checksum over the data catches files that were damaged after writing.
+ * Values are stored in the byte order of the machine that wrote them, and
+ * a machine of the other order refuses to read them.
+ *
+ * The element types that can be stored are: bool, char, the integer and
+ * floating-point types, std::string, other trivially copyable structs
+ * (stored byte for byte, so they must not contain pointers), and Grid,
+ * Vector, and HashMap of any of these, nested to any depth.
+ *
+ * @version 2026/10/17
+ * - sizes read from damaged data are checked against the input that is
+ *   left before anything is allocated for them
+ * @version 2026/10/16
+ * - initial version
+ */
+
+#include "private/init.h"   // ensure that Stanford C++ lib is initialized
+
+#ifndef INTERNAL_INCLUDE
+#include "private/initstudent.h"   // insert necessary included code by student
+#endif // INTERNAL_INCLUDE
+
+#ifndef _binaryio_h
+#define _binaryio_h
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+#define INTERNAL_INCLUDE 1
+#include "error.h"
+#define INTERNAL_INCLUDE 1
+#include "grid.h"
+#define INTERNAL_INCLUDE 1
+#include "hashmap.h"
+#define INTERNAL_INCLUDE 1
+#include "vector.h"
+#undef INTERNAL_INCLUDE
+
+/*
+ * Function: writeBinary
+ * Usage: writeBinary(out, collection);
+ *        writeBinary(out, collection, true);
+ * ------------------------------------------
+ * Writes the given collection to the output stream in binary form,
+ * followed by a checksum of the data if the last argument is true.  The
+ * stream should be opened in binary mode.
+ */
+template <typename T>
+void writeBinary(std::ostream& out, const T& collection, bool checksum = false);
+
+/*
+ * Function: readBinary
+ * Usage: readBinary(in, collection);
+ * ----------------------------------
+ * Reads a collection written by writeBinary from the input stream into the
+ * given collection, replacing its contents.  This function signals an
+ * error if the data were written for a different type, are cut short, or
+ * fail their checksum; the collection's contents are then unspecified.
+ */
+template <typename T>
+void readBinary(std::istream& in, T& collection);
+
+namespace stanfordcpplib {
+namespace collections {
+
+/*
+ * A running checksum of a sequence of bytes: FNV-1a taken over 64-bit
+ * words rather than single bytes, which makes it several times faster
+ * while still catching every change confined to one word.  The result
+ * does not depend on how the bytes were split up between calls.
+ */
+class BinaryChecksum {
+public:
+    BinaryChecksum();
+    void update(const void* bytes, int64_t length);
+    uint64_t value() const;
+
+private:
+    uint64_t sum;
+    uint64_t pending;      /* bytes not yet making up a whole word */
+    int pendingBytes;
+};
+
+/*
+ * Binary output that keeps a running checksum of everything written.  It
+ * goes straight to the stream's buffer, so small writes stay cheap.
+ */
+class BinaryWriter {
+public:
+    BinaryWriter(std::ostream& out, bool checksum);
+    virtual ~BinaryWriter();
+
+    void write(const void* bytes, int64_t length);
+    void writeCount(int64_t count);
+
+    /*
+     * Writes the checksum, if requested, and signals an error if any of
+     * the output failed.
+     */
+    void finish();
+
+private:
+    std::ostream& out;
+    bool checksum;
+    BinaryChecksum sum;
+
+    // forbid copying
+    BinaryWriter(const BinaryWriter&);
+    BinaryWriter& operator =(const BinaryWriter&);
+};
+
+/*
+ * The reading side of BinaryWriter.  Every method signals an error if the
+ * input ends early.  If the stream can seek, the reader also knows how
+ * many bytes are left, so that a damaged size can be caught before
+ * anything is allocated for it.
+ */
+class BinaryReader {
+public:
+    BinaryReader(std::istream& in, bool checksum);
+    virtual ~BinaryReader();
+
+    void read(void* bytes, int64_t length);
+
+    /*
+     * Reads a count written by writeCount and checks it as checkCount does.
+     */
+    int readCount(int64_t minBytes = 0);
+
+    /*
+     * Signals an error if count is too large to be the size of a
+     * collection, or if count values of at least minBytes bytes each
+     * cannot fit in the rest of the input.
+     */
+    void checkCount(int64_t count, int64_t minBytes);
+
+    /*
+     * Returns true if the reader knows how much input is left, in which
+     * case every count it has checked is known to fit in the input.
+     */
+    bool knowsLength() const;
+
+    /*
+     * Reads the checksum, if there is one, and signals an error if it does
+     * not match the data.
+     */
+    void finish();
+
+private:
+    std::istream& in;
+    bool checksum;
+    BinaryChecksum sum;
+    int64_t remaining;     /* bytes left in the input, or -1 if unknown */
+
+    void readRaw(void* bytes, int64_t length);
+
+    // forbid copying
+    BinaryReader(const BinaryReader&);
+    BinaryReader& operator =(const BinaryReader&);
+};
+
+void writeBinaryHeader(std::ostream& out, const std::string& typeCode, bool checksum);
+bool readBinaryHeader(std::istream& in, const std::string& typeCode);
+
+/*
+ * Values that are stored as their raw bytes.  Pointers are trivially
+ * copyable but mean nothing once read back, so they are left out.
+ */
+template <typename T>
+struct IsRawBinary
+        : std::integral_constant<bool, std::is_trivially_copyable<T>::value
+                                       && !std::is_pointer<T>::value> {
+};
+
+/*
+ * BinaryType<T>::code() returns a short string that names T, built up
+ * from one letter per type and the sizes of the basic types, as in "Gi4"
+ * for Grid<int>.  Types that cannot be stored have no code() and so do
+ * not compile.
+ */
+template <typename T, bool raw = IsRawBinary<T>::value>
+struct BinaryType;
+
+template <typename T>
+struct BinaryType<T, true> {
+    static std::string code() {
+        char kind = std::is_same<T, bool>::value ? 'b'
+                  : std::is_floating_point<T>::value ? 'f'
+                  : std::is_integral<T>::value ? (std::is_signed<T>::value ? 'i' : 'u')
+                  : 'p';
+        return kind + std::to_string(sizeof(T));
+    }
+};
+
+template <>
+struct BinaryType<std::string, false> {
+    static std::string code() {
+        return "s";
+    }
+};
+
+template <typename T>
+struct BinaryType<Vector<T>, false> {
+    static std::string code() {
+        return "V" + BinaryType<T>::code();
+    }
+};
+
+/*
+ * Grids of every layout are written in row-major order, so they share a
+ * code and can be read back into any layout.
+ */
+template <typename T, typename Layout>
+struct BinaryType<Grid<T, Layout>, false> {
+    static std::string code() {
+        return "G" + BinaryType<T>::code();
+    }
+};
+
+template <typename K, typename V>
+struct BinaryType<HashMap<K, V>, false> {
+    static std::string code() {
+        return "H" + BinaryType<K>::code() + BinaryType<V>::code();
+    }
+};
+
+/*
+ * Returns the fewest bytes that any value of type T takes up when written:
+ * raw values take their own size, and everything else starts with a count.
+ */
+template <typename T>
+int64_t binaryMinSize() {
+    return IsRawBinary<T>::value ? sizeof(T) : sizeof(int64_t);
+}
+
+/*
+ * Strings and vectors whose length cannot be checked against the input are
+ * read this many elements at a time, so that a damaged count makes them
+ * fail at the end of the input instead of allocating the whole count first.
+ */
+const int BINARY_READ_BLOCK = 65536;
+
+/*
+ * Implementation notes: writeValue, readValue
+ * -------------------------------------------
+ * One overload per kind of value.  Raw values and arrays of them go
+ * straight to the stream; everything else is written piece by piece,
+ * each collection as its size followed by its elements.
+ */
+template <typename T>
+void writeValue(BinaryWriter& writer, const T& value);
+template <typename T>
+void readValue(BinaryReader& reader, T& value);
+
+template <typename T>
+void writeArray(BinaryWriter& writer, const T* values, int count, std::true_type /* raw */) {
+    writer.write(values, static_cast<int64_t>(count) * sizeof(T));
+}
+
+template <typename T>
+void writeArray(BinaryWriter& writer, const T* values, int count, std::false_type /* raw */) {
+    for (int i = 0; i < count; i++) {
+        writeValue(writer, values[i]);
+    }
+}
+
+template <typename T>
+void readArray(BinaryReader& reader, T* values, int count, std::true_type /* raw */) {
+    reader.read(values, static_cast<int64_t>(count) * sizeof(T));
+}
+
+template <typename T>
+void readArray(BinaryReader& reader, T* values, int count, std::false_type /* raw */) {
+    for (int i = 0; i < count; i++) {
+        readValue(reader, values[i]);
+    }
+}
+
+template <typename T>
+void writeValueOf(BinaryWriter& writer, const T& value, std::true_type /* raw */) {
+    writer.write(&value, sizeof(T));
+}
+
+template <typename T>
+void readValueOf(BinaryReader& reader, T& value, std::true_type /* raw */) {
+    reader.read(&value, sizeof(T));
+}
+
+inline void writeValueOf(BinaryWriter& writer, const std::string& str, std::false_type) {
+    writer.writeCount(str.size());
+    writer.write(str.data(), str.size());
+}
+
+inline void readValueOf(BinaryReader& reader, std::string& str, std::false_type) {
+    int length = reader.readCount(1);
+    str.clear();
+    if (reader.knowsLength()) {
+        str.reserve(length);
+    }
+    for (int start = 0; start < length; start += BINARY_READ_BLOCK) {
+        int end = std::min(length - start, BINARY_READ_BLOCK) + start;
+        str.resize(end);
+        reader.read(&str[start], end - start);
+    }
+}
+
+template <typename T>
+void writeValueOf(BinaryWriter& writer, const Vector<T>& vec, std::false_type) {
+    int count = vec.size();
+    writer.writeCount(count);
+    if (count > 0) {
+        writeArray(writer, &vec[0], count, IsRawBinary<T>());
+    }
+}
+
+/*
+ * The vector is grown with default values first, so that the elements can
+ * then be read in place in one block.  Its full size is only reserved if
+ * the count has been checked against the input.
+ */
+template <typename T>
+void readValueOf(BinaryReader& reader, Vector<T>& vec, std::false_type) {
+    int count = reader.readCount(binaryMinSize<T>());
+    vec.clear();
+    if (reader.knowsLength()) {
+        vec.ensureCapacity(count);
+    }
+    for (int start = 0; start < count; start += BINARY_READ_BLOCK) {
+        int end = std::min(count - start, BINARY_READ_BLOCK) + start;
+        for (int i = start; i < end; i++) {
+            vec.add(T());
+        }
+        readArray(reader, &vec[start], end - start, IsRawBinary<T>());
+    }
+}
+
+template <typename T, typename Layout>
+void writeValueOf(BinaryWriter& writer, const Grid<T, Layout>& grid, std::false_type) {
+    writer.writeCount(grid.numRows());
+    writer.writeCount(grid.numCols());
+    for (int row = 0; row < grid.numRows(); row++) {
+        for (int col = 0; col < grid.numCols(); col++) {
+            writeValue(writer, grid.get(row, col));
+        }
+    }
+}
+
+template <typename T, typename Layout>
+void readValueOf(BinaryReader& reader, Grid<T, Layout>& grid, std::false_type) {
+    int numRows = reader.readCount();
+    int numCols = reader.readCount();
+    reader.checkCount(static_cast<int64_t>(numRows) * numCols, binaryMinSize<T>());
+    grid.resize(numRows, numCols);
+    T value;
+    for (int row = 0; row < numRows; row++) {
+        for (int col = 0; col < numCols; col++) {
+            readValue(reader, value);
+            grid.set(row, col, value);
+        }
+    }
+}
+
+/*
+ * Row-major grids are handled a row at a time.
+ */
+template <typename T>
+void writeValueOf(BinaryWriter& writer, const Grid<T>& grid, std::false_type) {
+    writer.writeCount(grid.numRows());
+    writer.writeCount(grid.numCols());
+    for (int row = 0; row < grid.numRows(); row++) {
+        writeArray(writer, grid.rowSpan(row).data(), grid.numCols(), IsRawBinary<T>());
+    }
+}
+
+template <typename T>
+void readValueOf(BinaryReader& reader, Grid<T>& grid, std::false_type) {
+    int numRows = reader.readCount();
+    int numCols = reader.readCount();
+    reader.checkCount(static_cast<int64_t>(numRows) * numCols, binaryMinSize<T>());
+    grid.resize(numRows, numCols);
+    for (int row = 0; row < numRows; row++) {
+        readArray(reader, grid.rowSpan(row).data(), numCols, IsRawBinary<T>());
+    }
+}
+
+/*
+ * Grids of bool are written one byte per cell, as other grids of bool are.
+ */
+inline void writeValueOf(BinaryWriter& writer, const Grid<bool>& grid, std::false_type) {
+    writer.writeCount(grid.numRows());
+    writer.writeCount(grid.numCols());
+    for (int row = 0; row < grid.numRows(); row++) {
+        for (int col = 0; col < grid.numCols(); col++) {
+            bool value = grid.get(row, col);
+            writer.write(&value, sizeof(bool));
+        }
+    }
+}
+
+inline void readValueOf(BinaryReader& reader, Grid<bool>& grid, std::false_type) {
+    int numRows = reader.readCount();
+    int numCols = reader.readCount();
+    reader.checkCount(static_cast<int64_t>(numRows) * numCols, sizeof(bool));
+    grid.resize(numRows, numCols);
+    for (int row = 0; row < numRows; row++) {
+        for (int col = 0; col < numCols; col++) {
+            unsigned char value;
+            reader.read(&value, 1);
+            grid.set(row, col, value != 0);
+        }
+    }
+}
+
+template <typename K, typename V>
+void writeValueOf(BinaryWriter& writer, const HashMap<K, V>& map, std::false_type) {
+    writer.writeCount(map.size());
+    map.mapAll([&writer](const K& key, const V& value) {
+        writeValue(writer, key);
+        writeValue(writer, value);
+    });
+}
+
+template <typename K, typename V>
+void readValueOf(BinaryReader& reader, HashMap<K, V>& map, std::false_type) {
+    int count = reader.readCount(binaryMinSize<K>() + binaryMinSize<V>());
+    map.clear();
+    K key;
+    V value;
+    for (int i = 0; i < count; i++) {
+        readValue(reader, key);
+        readValue(reader, value);
+        map.put(key, value);
+    }
+}
+
+template <typename T>
+void writeValue(BinaryWriter& writer, const T& value) {
+    writeValueOf(writer, value, IsRawBinary<T>());
+}
+
+template <typename T>
+void readValue(BinaryReader& reader, T& value) {
+    readValueOf(reader, value, IsRawBinary<T>());
+}
+
+} // namespace collections
+} // namespace stanfordcpplib
+
+template <typename T>
+void writeBinary(std::ostream& out, const T& collection, bool checksum) {
+    stanfordcpplib::collections::writeBinaryHeader(
+                out, stanfordcpplib::collections::BinaryType<T>::code(), checksum);
+    stanfordcpplib::collections::BinaryWriter writer(out, checksum);
+    stanfordcpplib::collections::writeValue(writer, collection);
+    writer.finish();
+}
+
+template <typename T>
+void readBinary(std::istream& in, T& collection) {
+    bool checksum = stanfordcpplib::collections::readBinaryHeader(
+                in, stanfordcpplib::collections::BinaryType<T>::code());
+    stanfordcpplib::collections::BinaryReader reader(in, checksum);
+    stanfordcpplib::collections::readValue(reader, collection);
+    reader.finish();
+}
+
+#endif // _binaryio_h
@@ -0,0 +1,1506 @@
+/*
+ * File: btreemap.h
+ * ----------------
+ * This file exports the template class <code>BTreeMap</code>, a sorted
+ * map with the same interface as <code>Map</code> that stores its entries
+ * in a B+ tree, for large maps where lookup speed and memory matter.
+ *
+ * @version 2026/10/17
+ * - initial version
+ * - maps whose value type is NoValue store no values in their leaves
+ * - keys without a < operator work with a client-supplied comparator
+ */
+
+#include "private/init.h"   // ensure that Stanford C++ lib is initialized
+
+#ifndef INTERNAL_INCLUDE
+#include "private/initstudent.h"   // insert necessary included code by student
+#endif // INTERNAL_INCLUDE
+
+#ifndef _btreemap_h
+#define _btreemap_h
+
+#include <cstdlib>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#define INTERNAL_INCLUDE 1
+#include "collections.h"
+#define INTERNAL_INCLUDE 1
+#include "error.h"
+#define INTERNAL_INCLUDE 1
+#include "hashcode.h"
+#define INTERNAL_INCLUDE 1
+#include "vector.h"
+#undef INTERNAL_INCLUDE
+
+namespace stanfordcpplib {
+namespace collections {
+
+/*
+ * Returns how many entries of the given size a B-tree node should hold:
+ * enough to fill about a kilobyte, but between 16 and 64.
+ */
+constexpr int btreeNodeCapacity(int bytesPerEntry) {
+    return 1024 / bytesPerEntry < 16 ? 16
+         : 1024 / bytesPerEntry > 64 ? 64
+         : 1024 / bytesPerEntry;
+}
+
+/*
+ * The values held in a B+ tree leaf, indexed like an array.  The NoValue
+ * specialization holds nothing, so the leaves of a map that is only used
+ * for its keys, like the one in BTreeSet, spend no space on values.
+ */
+template <typename ValueType, int N>
+struct BTreeLeafValues {
+    ValueType values[N];
+
+    ValueType& operator [](int i) {
+        return values[i];
+    }
+
+    const ValueType& operator [](int i) const {
+        return values[i];
+    }
+};
+
+template <int N>
+struct BTreeLeafValues<NoValue, N> {
+    NoValue& operator [](int) {
+        return value;
+    }
+
+    const NoValue& operator [](int) const {
+        return value;
+    }
+
+    NoValue value;
+};
+
+} // namespace collections
+} // namespace stanfordcpplib
+
+/*
+ * Class: BTreeMap<KeyType,ValueType>
+ * ----------------------------------
+ * This class maintains an association between <b><i>keys</i></b> and
+ * <b><i>values</i></b>, in sorted order of the keys, exactly like the
+ * <a href="Map-class.html"><code>Map</code></a> class.  The difference is
+ * the representation: a <code>Map</code> keeps one entry per tree node,
+ * while a <code>BTreeMap</code> packs between 16 and 64 entries into each
+ * node of a B+ tree.  A lookup therefore touches only a handful of nodes,
+ * searching each with a binary search over adjacent keys, and the map
+ * needs much less memory per entry.  Use it for maps with many thousands
+ * of entries or more; for small maps the two perform about the same.
+ *
+ * In addition to the <code>Map</code> interface, <code>mapRange</code>
+ * visits just the entries whose keys fall in a given range.
+ */
+template <typename KeyType, typename ValueType>
+class BTreeMap {
+public:
+    /*
+     * Constructor: BTreeMap
+     * Usage: BTreeMap<KeyType,ValueType> map;
+     * ---------------------------------------
+     * Initializes a new empty map that associates keys and values of the
+     * specified types, ordering the keys with the <code>&lt;</code>
+     * operator.
+     */
+    BTreeMap();
+
+    /*
+     * Constructor: BTreeMap
+     * Usage: BTreeMap<KeyType,ValueType> map(lessFunc);
+     * -------------------------------------------------
+     * Initializes a new empty map that uses the given "less-than" comparison
+     * function to order its keys.  The function can accept the two keys to
+     * compare either by value or by const reference.
+     */
+    BTreeMap(bool lessFunc(KeyType, KeyType));
+    BTreeMap(bool lessFunc(const KeyType&, const KeyType&));
+
+    /*
+     * Constructor: BTreeMap
+     * Usage: BTreeMap<KeyType,ValueType> map {{"a", 1}, {"b", 2}, {"c", 3}};
+     * ----------------------------------------------------------------------
+     * Initializes a new map that stores the given pairs.
+     */
+    BTreeMap(std::initializer_list<std::pair<KeyType, ValueType> > list);
+
+    /*
+     * Destructor: ~BTreeMap
+     * ---------------------
+     * Frees any heap storage associated with this map.
+     */
+    virtual ~BTreeMap();
+
+    /*
+     * Method: add
+     * Usage: map.add(key, value);
+     * ---------------------------
+     * Associates <code>key</code> with <code>value</code> in this map.
+     * A synonym for the put method.
+     */
+    void add(const KeyType& key, const ValueType& value);
+
+    /*
+     * Method: addAll
+     * Usage: map.addAll(map2);
+     * ------------------------
+     * Adds all key/value pairs from the given map to this map.
+     * If both maps contain a pair for the same key, the one from map2 will
+     * replace the one from this map.
+     * You can also pass an initializer list of pairs such as {{"a", 1}, {"b", 2}, {"c", 3}}.
+     * Returns a reference to this map.
+     * Identical in behavior to putAll.
+     */
+    BTreeMap& addAll(const BTreeMap& map2);
+    BTreeMap& addAll(std::initializer_list<std::pair<KeyType, ValueType> > list);
+
+    /*
+     * Method: back
+     * Usage: KeyType value = map.back();
+     * ----------------------------------
+     * Returns the last key in the map in order of the keys.
+     * If the map is empty, generates an error.
+     */
+    KeyType back() const;
+
+    /*
+     * Method: clear
+     * Usage: map.clear();
+     * -------------------
+     * Removes all entries from this map.
+     */
+    void clear();
+
+    /*
+     * Method: containsKey
+     * Usage: if (map.containsKey(key)) ...
+     * ------------------------------------
+     * Returns <code>true</code> if there is an entry for <code>key</code>
+     * in this map.
+     */
+    bool containsKey(const KeyType& key) const;
+
+    /*
+     * Method: equals
+     * Usage: if (map.equals(map2)) ...
+     * --------------------------------
+     * Returns <code>true</code> if the two maps contain exactly the same
+     * key/value pairs, and <code>false</code> otherwise.
+     * This is equivalent to the <code>==</code> operator.
+     */
+    bool equals(const BTreeMap& map2) const;
+
+    /*
+     * Method: front
+     * Usage: KeyType value = map.front();
+     * -----------------------------------
+     * Returns the first key in the map in order of the keys.
+     * If the map is empty, generates an error.
+     */
+    KeyType front() const;
+
+    /*
+     * Method: get
+     * Usage: ValueType value = map.get(key);
+     * --------------------------------------
+     * Returns the value associated with <code>key</code> in this map.
+     * If <code>key</code> is not found, <code>get</code> returns the
+     * default value for <code>ValueType</code>.
+     */
+    ValueType get(const KeyType& key) const;
+
+    /*
+     * Method: isEmpty
+     * Usage: if (map.isEmpty()) ...
+     * -----------------------------
+     * Returns <code>true</code> if this map contains no entries.
+     */
+    bool isEmpty() const;
+
+    /*
+     * Method: keys
+     * Usage: Vector<KeyType> keys = map.keys();
+     * -----------------------------------------
+     * Returns a collection containing all keys in this map, in sorted order.
+     */
+    Vector<KeyType> keys() const;
+
+    /*
+     * Method: mapAll
+     * Usage: map.mapAll(fn);
+     * ----------------------
+     * Iterates through the map entries and calls <code>fn(key, value)</code>
+     * for each one.  The keys are processed in ascending order, as defined
+     * by the comparison function.
+     */
+    void mapAll(void (*fn)(KeyType, ValueType)) const;
+    void mapAll(void (*fn)(const KeyType&, const ValueType&)) const;
+    template <typename FunctorType>
+    void mapAll(FunctorType fn) const;
+
+    /*
+     * Method: mapRange
+     * Usage: map.mapRange(low, high, fn);
+     * -----------------------------------
+     * Calls <code>fn(key, value)</code> for each entry whose key is at least
+     * <code>low</code> and less than <code>high</code>, in ascending order.
+     * Only the entries in the range are visited, so this takes time
+     * proportional to log <i>N</i> plus the number of entries found.
+     */
+    template <typename FunctorType>
+    void mapRange(const KeyType& low, const KeyType& high, FunctorType fn) const;
+
+    /*
+     * Method: put
+     * Usage: map.put(key, value);
+     * ---------------------------
+     * Associates <code>key</code> with <code>value</code> in this map.
+     * Any previous value associated with <code>key</code> is replaced
+     * by the new value.
+     */
+    void put(const KeyType& key, const ValueType& value);
+
+    /*
+     * Method: putAll
+     * Usage: map.putAll(map2);
+     * ------------------------
+     * Adds all key/value pairs from the given map to this map.
+     * If both maps contain a pair for the same key, the one from map2 will
+     * replace the one from this map.
+     * You can also pass an initializer list of pairs such as {{"a", 1}, {"b", 2}, {"c", 3}}.
+     * Returns a reference to this map.
+     * Identical in behavior to addAll.
+     */
+    BTreeMap& putAll(const BTreeMap& map2);
+    BTreeMap& putAll(std::initializer_list<std::pair<KeyType, ValueType> > list);
+
+    /*
+     * Method: remove
+     * Usage: map.remove(key);
+     * -----------------------
+     * Removes any entry for <code>key</code> from this map.
+     */
+    void remove(const KeyType& key);
+
+    /*
+     * Method: removeAll
+     * Usage: map.removeAll(map2);
+     * ---------------------------
+     * Removes all key/value pairs from this map that are contained in the
+     * given map.  If both maps contain the same key but it maps to different
+     * values, that pair will not be removed from this map.
+     * You can also pass an initializer list of pairs such as {{"a", 1}, {"b", 2}, {"c", 3}}.
+     * Returns a reference to this map.
+     */
+    BTreeMap& removeAll(const BTreeMap& map2);
+    BTreeMap& removeAll(std::initializer_list<std::pair<KeyType, ValueType> > list);
+
+    /*
+     * Method: retainAll
+     * Usage: map.retainAll(map2);
+     * ---------------------------
+     * Removes all key/value pairs from this map that are not contained in
+     * the given map.  If both maps contain the same key but it maps to
+     * different values, that pair will be removed from this map.
+     * You can also pass an initializer list of pairs such as {{"a", 1}, {"b", 2}, {"c", 3}}.
+     * Returns a reference to this map.
+     */
+    BTreeMap& retainAll(const BTreeMap& map2);
+    BTreeMap& retainAll(std::initializer_list<std::pair<KeyType, ValueType> > list);
+
+    /*
+     * Method: size
+     * Usage: int nEntries = map.size();
+     * ---------------------------------
+     * Returns the number of entries in this map.
+     */
+    int size() const;
+
+    /*
+     * Method: toString
+     * Usage: string str = map.toString();
+     * -----------------------------------
+     * Converts the map to a printable string representation.
+     */
+    std::string toString() const;
+
+    /*
+     * Method: values
+     * Usage: Vector<ValueType> values = map.values();
+     * -----------------------------------------------
+     * Returns a collection containing all values in this map, in the
+     * order of their keys.
+     */
+    Vector<ValueType> values() const;
+
+    /*
+     * Operator: []
+     * Usage: map[key]
+     * ---------------
+     * Selects the value associated with <code>key</code>.  This syntax
+     * makes it easy to think of a map as an "associative array"
+     * indexed by the key type.  If <code>key</code> is already present
+     * in the map, this function returns a reference to its associated
+     * value.  If key is not present in the map, a new entry is created
+     * whose value is set to the default for the value type.
+     * The reference is valid only until the next insertion or removal.
+     */
+    ValueType& operator [](const KeyType& key);
+    ValueType operator [](const KeyType& key) const;
+
+    /*
+     * Operators: ==, !=, <, <=, >, >=
+     * Usage: if (map1 == map2) ...
+     * ----------------------------
+     * Compares two maps in the same way as the corresponding
+     * <code>Map</code> operators.
+     */
+    bool operator ==(const BTreeMap& map2) const;
+    bool operator !=(const BTreeMap& map2) const;
+    bool operator <(const BTreeMap& map2) const;
+    bool operator <=(const BTreeMap& map2) const;
+    bool operator >(const BTreeMap& map2) const;
+    bool operator >=(const BTreeMap& map2) const;
+
+    /*
+     * Operators: +, +=, -, -=, *, *=
+     * Usage: map1 + map2
+     *        map1 += map2
+     * -------------------
+     * Return or apply putAll, removeAll and retainAll respectively, as for
+     * the corresponding <code>Map</code> operators.
+     */
+    BTreeMap operator +(const BTreeMap& map2) const;
+    BTreeMap operator +(std::initializer_list<std::pair<KeyType, ValueType> > list) const;
+    BTreeMap& operator +=(const BTreeMap& map2);
+    BTreeMap& operator +=(std::initializer_list<std::pair<KeyType, ValueType> > list);
+    BTreeMap operator -(const BTreeMap& map2) const;
+    BTreeMap operator -(std::initializer_list<std::pair<KeyType, ValueType> > list) const;
+    BTreeMap& operator -=(const BTreeMap& map2);
+    BTreeMap& operator -=(std::initializer_list<std::pair<KeyType, ValueType> > list);
+    BTreeMap operator *(const BTreeMap& map2) const;
+    BTreeMap operator *(std::initializer_list<std::pair<KeyType, ValueType> > list) const;
+    BTreeMap& operator *=(const BTreeMap& map2);
+    BTreeMap& operator *=(std::initializer_list<std::pair<KeyType, ValueType> > list);
+
+    /*
+     * Additional BTreeMap operations
+     * ------------------------------
+     * In addition to the methods listed in this interface, the BTreeMap
+     * class supports the following operations:
+     *
+     *   - Stream I/O using the << and >> operators
+     *   - Deep copying for the copy constructor and assignment operator
+     *   - Iteration using the range-based for statement and STL iterators
+     *
+     * All iteration is guaranteed to proceed in the order established by
+     * the comparison function passed to the constructor, which ordinarily
+     * matches the order of the key type itself.
+     */
+
+    /* Private section */
+
+    /**********************************************************************/
+    /* Note: Everything below this point in the file is logically part    */
+    /* of the implementation and should not be of interest to clients.    */
+    /**********************************************************************/
+
+    /*
+     * Implementation notes:
+     * ---------------------
+     * The map is a B+ tree.  All entries live in the leaves, which are
+     * chained together in key order for iteration and range queries; the
+     * inner nodes hold only separator keys and child pointers.  See the
+     * notes above the member definitions below for details.
+     */
+
+private:
+    /* Constant definitions */
+    static const int LEAF_CAPACITY = stanfordcpplib::collections::btreeNodeCapacity(
+            (int) (sizeof(KeyType) + sizeof(stanfordcpplib::collections::BTreeLeafValues<ValueType, 1>)));
+    static const int INNER_CAPACITY = stanfordcpplib::collections::btreeNodeCapacity(
+            (int) (sizeof(KeyType) + sizeof(void*)));
+    static const int LEAF_MINIMUM = LEAF_CAPACITY / 2;
+    static const int INNER_MINIMUM = INNER_CAPACITY / 2;
+
+    /* Type definitions for the nodes of the tree */
+    struct Node {
+        int count;               /* Number of keys in this node          */
+        bool isLeaf;
+    };
+
+    /*
+     * Each array has one spare slot so that an insertion can go in before
+     * an overfull node is split.
+     */
+    struct Leaf : Node {
+        KeyType keys[LEAF_CAPACITY + 1];
+        stanfordcpplib::collections::BTreeLeafValues<ValueType, LEAF_CAPACITY + 1> values;
+        Leaf* prev;              /* Neighbouring leaves in key order     */
+        Leaf* next;
+    };
+
+    struct Inner : Node {
+        KeyType keys[INNER_CAPACITY + 1];
+        Node* children[INNER_CAPACITY + 2];
+    };
+
+    /* Instance variables */
+    Node* root;                  // nullptr if the map is empty
+    Leaf* firstLeaf;
+    Leaf* lastLeaf;
+    int numEntries;
+    bool (*lessByValue)(KeyType, KeyType);                 // client comparison
+    bool (*lessByRef)(const KeyType&, const KeyType&);     // functions, if any
+    unsigned int m_version = 0; // structure version for detecting invalid iterators
+
+    /* Private methods */
+
+    /*
+     * Returns true if k1 comes before k2 in this map's ordering.  The
+     * std::less fallback is only compiled for key types that have a
+     * < operator; maps of other key types always have a client function.
+     */
+    bool lessThan(const KeyType& k1, const KeyType& k2) const {
+        if (lessByRef) {
+            return lessByRef(k1, k2);
+        } else if (lessByValue) {
+            return lessByValue(k1, k2);
+        }
+        return defaultLessThan(k1, k2, stanfordcpplib::collections::HasLessOperator<KeyType>());
+    }
+
+    static bool defaultLessThan(const KeyType& k1, const KeyType& k2, std::true_type) {
+        return std::less<KeyType>()(k1, k2);
+    }
+
+    static bool defaultLessThan(const KeyType&, const KeyType&, std::false_type) {
+        error("BTreeMap: key type has no < operator and no comparison function was given");
+        return false;
+    }
+
+    /*
+     * Returns the index of the first of the count keys that is not less
+     * than key, or count if there is none.
+     */
+    int lowerBound(const KeyType* keys, int count, const KeyType& key) const {
+        int low = 0;
+        int high = count;
+        while (low < high) {
+            int mid = (low + high) / 2;
+            if (lessThan(keys[mid], key)) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+    /*
+     * Returns the index of the first of the count keys that is greater
+     * than key, or count if there is none.
+     */
+    int upperBound(const KeyType* keys, int count, const KeyType& key) const {
+        int low = 0;
+        int high = count;
+        while (low < high) {
+            int mid = (low + high) / 2;
+            if (lessThan(key, keys[mid])) {
+                high = mid;
+            } else {
+                low = mid + 1;
+            }
+        }
+        return low;
+    }
+
+    /*
+     * Returns the leaf where key is or would be stored.  The map must not
+     * be empty.
+     */
+    Leaf* findLeaf(const KeyType& key) const {
+        Node* node = root;
+        while (!node->isLeaf) {
+            Inner* inner = static_cast<Inner*>(node);
+            node = inner->children[upperBound(inner->keys, inner->count, key)];
+        }
+        return static_cast<Leaf*>(node);
+    }
+
+    /*
+     * Returns a pointer to the value stored for key, or nullptr if there
+     * is none.
+     */
+    ValueType* findValue(const KeyType& key) const {
+        if (!root) {
+            return nullptr;
+        }
+        Leaf* leaf = findLeaf(key);
+        int i = lowerBound(leaf->keys, leaf->count, key);
+        if (i < leaf->count && !lessThan(key, leaf->keys[i])) {
+            return &leaf->values[i];
+        }
+        return nullptr;
+    }
+
+    /*
+     * Private method: insertKey
+     * Usage: ValueType* vp = insertKey(key);
+     * --------------------------------------
+     * Returns a pointer to the value stored for key, first adding an entry
+     * with the default value if there is none.  Grows a new root if the
+     * old one splits.
+     */
+    ValueType* insertKey(const KeyType& key) {
+        if (!root) {
+            Leaf* leaf = new Leaf();
+            leaf->isLeaf = true;
+            root = firstLeaf = lastLeaf = leaf;
+        }
+        Node* split = nullptr;
+        KeyType splitKey;
+        ValueType* vp = insertInto(root, key, split, splitKey);
+        if (split) {
+            Inner* newRoot = new Inner();
+            newRoot->isLeaf = false;
+            newRoot->count = 1;
+            newRoot->keys[0] = std::move(splitKey);
+            newRoot->children[0] = root;
+            newRoot->children[1] = split;
+            root = newRoot;
+        }
+        return vp;
+    }
+
+    /*
+     * Private method: insertInto
+     * Usage: ValueType* vp = insertInto(node, key, split, splitKey);
+     * --------------------------------------------------------------
+     * Does the work of insertKey in the subtree rooted at node.  If the node
+     * overflows, it is split in two; split is then set to the new right half
+     * and splitKey to the key that separates the halves.
+     */
+    ValueType* insertInto(Node* node, const KeyType& key, Node*& split, KeyType& splitKey) {
+        if (node->isLeaf) {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            int i = lowerBound(leaf->keys, leaf->count, key);
+            if (i < leaf->count && !lessThan(key, leaf->keys[i])) {
+                return &leaf->values[i];
+            }
+            for (int j = leaf->count; j > i; j--) {
+                leaf->keys[j] = std::move(leaf->keys[j - 1]);
+                leaf->values[j] = std::move(leaf->values[j - 1]);
+            }
+            leaf->keys[i] = key;
+            leaf->values[i] = ValueType();
+            leaf->count++;
+            numEntries++;
+            m_version++;
+            if (leaf->count <= LEAF_CAPACITY) {
+                return &leaf->values[i];
+            }
+            Leaf* right = splitLeaf(leaf);
+            split = right;
+            splitKey = right->keys[0];
+            return (i < leaf->count) ? &leaf->values[i] : &right->values[i - leaf->count];
+        }
+
+        Inner* inner = static_cast<Inner*>(node);
+        int c = upperBound(inner->keys, inner->count, key);
+        Node* childSplit = nullptr;
+        ValueType* vp = insertInto(inner->children[c], key, childSplit, splitKey);
+        if (childSplit) {
+            for (int j = inner->count; j > c; j--) {
+                inner->keys[j] = std::move(inner->keys[j - 1]);
+                inner->children[j + 1] = inner->children[j];
+            }
+            inner->keys[c] = std::move(splitKey);
+            inner->children[c + 1] = childSplit;
+            inner->count++;
+            if (inner->count > INNER_CAPACITY) {
+                split = splitInner(inner, splitKey);
+            }
+        }
+        return vp;
+    }
+
+    /*
+     * Moves the upper half of an overfull leaf into a new leaf that follows
+     * it, and returns the new leaf.
+     */
+    Leaf* splitLeaf(Leaf* leaf) {
+        Leaf* right = new Leaf();
+        right->isLeaf = true;
+        int keep = leaf->count / 2;
+        right->count = leaf->count - keep;
+        for (int i = 0; i < right->count; i++) {
+            right->keys[i] = std::move(leaf->keys[keep + i]);
+            right->values[i] = std::move(leaf->values[keep + i]);
+        }
+        leaf->count = keep;
+        right->prev = leaf;
+        right->next = leaf->next;
+        if (leaf->next) {
+            leaf->next->prev = right;
+        } else {
+            lastLeaf = right;
+        }
+        leaf->next = right;
+        return right;
+    }
+
+    /*
+     * Moves the upper half of an overfull inner node into a new node,
+     * which it returns, and sets splitKey to the middle key, which moves
+     * up to the parent.
+     */
+    Inner* splitInner(Inner* inner, KeyType& splitKey) {
+        Inner* right = new Inner();
+        right->isLeaf = false;
+        int keep = inner->count / 2;
+        splitKey = std::move(inner->keys[keep]);
+        right->count = inner->count - keep - 1;
+        for (int i = 0; i < right->count; i++) {
+            right->keys[i] = std::move(inner->keys[keep + 1 + i]);
+        }
+        for (int i = 0; i <= right->count; i++) {
+            right->children[i] = inner->children[keep + 1 + i];
+        }
+        inner->count = keep;
+        return right;
+    }
+
+    /*
+     * Private method: removeFrom
+     * Usage: bool removed = removeFrom(node, key);
+     * --------------------------------------------
+     * Removes key from the subtree rooted at node, returning false if it
+     * was not there.  A child left with too few keys is topped up from a
+     * sibling or merged with one, so only the root can end up underfull.
+     */
+    bool removeFrom(Node* node, const KeyType& key) {
+        if (node->isLeaf) {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            int i = lowerBound(leaf->keys, leaf->count, key);
+            if (i == leaf->count || lessThan(key, leaf->keys[i])) {
+                return false;
+            }
+            eraseFromLeaf(leaf, i);
+            numEntries--;
+            return true;
+        }
+
+        Inner* inner = static_cast<Inner*>(node);
+        int c = upperBound(inner->keys, inner->count, key);
+        if (!removeFrom(inner->children[c], key)) {
+            return false;
+        }
+        if (inner->children[c]->count < minimumCount(inner->children[c])) {
+            rebalance(inner, c);
+        }
+        return true;
+    }
+
+    /*
+     * Returns the fewest keys the given node may hold unless it is the root.
+     */
+    static int minimumCount(const Node* node) {
+        if (node->isLeaf) {
+            return LEAF_MINIMUM;
+        }
+        return INNER_MINIMUM;
+    }
+
+    void eraseFromLeaf(Leaf* leaf, int i) {
+        for (int j = i + 1; j < leaf->count; j++) {
+            leaf->keys[j - 1] = std::move(leaf->keys[j]);
+            leaf->values[j - 1] = std::move(leaf->values[j]);
+        }
+        leaf->count--;
+        leaf->keys[leaf->count] = KeyType();
+        leaf->values[leaf->count] = ValueType();
+    }
+
+    /*
+     * Private method: rebalance
+     * Usage: rebalance(parent, c);
+     * ----------------------------
+     * Fixes up the underfull child c of parent, by borrowing one entry from
+     * a neighbouring sibling that can spare it, or else by merging it with
+     * a sibling.  The separators in the parent are kept such that every key
+     * in children[i] is less than keys[i], which is at most every key in
+     * children[i + 1].
+     */
+    void rebalance(Inner* parent, int c) {
+        Node* child = parent->children[c];
+        Node* left = (c > 0) ? parent->children[c - 1] : nullptr;
+        Node* right = (c < parent->count) ? parent->children[c + 1] : nullptr;
+        if (left && left->count > minimumCount(child)) {
+            borrowFromLeft(parent, c);
+        } else if (right && right->count > minimumCount(child)) {
+            borrowFromRight(parent, c);
+        } else if (left) {
+            merge(parent, c - 1);
+        } else {
+            merge(parent, c);
+        }
+    }
+
+    void borrowFromLeft(Inner* parent, int c) {
+        if (parent->children[c]->isLeaf) {
+            Leaf* leaf = static_cast<Leaf*>(parent->children[c]);
+            Leaf* left = static_cast<Leaf*>(parent->children[c - 1]);
+            for (int j = leaf->count; j > 0; j--) {
+                leaf->keys[j] = std::move(leaf->keys[j - 1]);
+                leaf->values[j] = std::move(leaf->values[j - 1]);
+            }
+            left->count--;
+            leaf->keys[0] = std::move(left->keys[left->count]);
+            leaf->values[0] = std::move(left->values[left->count]);
+            leaf->count++;
+            parent->keys[c - 1] = leaf->keys[0];
+        } else {
+            Inner* inner = static_cast<Inner*>(parent->children[c]);
+            Inner* left = static_cast<Inner*>(parent->children[c - 1]);
+            for (int j = inner->count; j > 0; j--) {
+                inner->keys[j] = std::move(inner->keys[j - 1]);
+            }
+            for (int j = inner->count + 1; j > 0; j--) {
+                inner->children[j] = inner->children[j - 1];
+            }
+            inner->keys[0] = std::move(parent->keys[c - 1]);
+            inner->children[0] = left->children[left->count];
+            inner->count++;
+            left->count--;
+            parent->keys[c - 1] = std::move(left->keys[left->count]);
+        }
+    }
+
+    void borrowFromRight(Inner* parent, int c) {
+        if (parent->children[c]->isLeaf) {
+            Leaf* leaf = static_cast<Leaf*>(parent->children[c]);
+            Leaf* right = static_cast<Leaf*>(parent->children[c + 1]);
+            leaf->keys[leaf->count] = std::move(right->keys[0]);
+            leaf->values[leaf->count] = std::move(right->values[0]);
+            leaf->count++;
+            eraseFromLeaf(right, 0);
+            parent->keys[c] = right->keys[0];
+        } else {
+            Inner* inner = static_cast<Inner*>(parent->children[c]);
+            Inner* right = static_cast<Inner*>(parent->children[c + 1]);
+            inner->keys[inner->count] = std::move(parent->keys[c]);
+            inner->children[inner->count + 1] = right->children[0];
+            inner->count++;
+            parent->keys[c] = std::move(right->keys[0]);
+            for (int j = 1; j < right->count; j++) {
+                right->keys[j - 1] = std::move(right->keys[j]);
+            }
+            for (int j = 1; j <= right->count; j++) {
+                right->children[j - 1] = right->children[j];
+            }
+            right->count--;
+        }
+    }
+
+    /*
+     * Merges child i + 1 of parent into child i and removes the separator
+     * between them from the parent.
+     */
+    void merge(Inner* parent, int i) {
+        Node* node = parent->children[i];
+        Node* next = parent->children[i + 1];
+        if (node->isLeaf) {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            Leaf* right = static_cast<Leaf*>(next);
+            for (int j = 0; j < right->count; j++) {
+                leaf->keys[leaf->count + j] = std::move(right->keys[j]);
+                leaf->values[leaf->count + j] = std::move(right->values[j]);
+            }
+            leaf->count += right->count;
+            leaf->next = right->next;
+            if (right->next) {
+                right->next->prev = leaf;
+            } else {
+                lastLeaf = leaf;
+            }
+            delete right;
+        } else {
+            Inner* inner = static_cast<Inner*>(node);
+            Inner* right = static_cast<Inner*>(next);
+            inner->keys[inner->count] = std::move(parent->keys[i]);
+            for (int j = 0; j < right->count; j++) {
+                inner->keys[inner->count + 1 + j] = std::move(right->keys[j]);
+            }
+            for (int j = 0; j <= right->count; j++) {
+                inner->children[inner->count + 1 + j] = right->children[j];
+            }
+            inner->count += right->count + 1;
+            delete right;
+        }
+        for (int j = i + 1; j < parent->count; j++) {
+            parent->keys[j - 1] = std::move(parent->keys[j]);
+            parent->children[j] = parent->children[j + 1];
+        }
+        parent->count--;
+        parent->keys[parent->count] = KeyType();
+    }
+
+    void deleteTree(Node* node) {
+        if (!node) {
+            return;
+        }
+        if (node->isLeaf) {
+            delete static_cast<Leaf*>(node);
+        } else {
+            Inner* inner = static_cast<Inner*>(node);
+            for (int i = 0; i <= inner->count; i++) {
+                deleteTree(inner->children[i]);
+            }
+            delete inner;
+        }
+    }
+
+    /*
+     * Copies the subtree rooted at node, threading the copied leaves onto
+     * the list that ends at lastCopied.
+     */
+    Node* copyTree(const Node* node, Leaf*& lastCopied) {
+        if (node->isLeaf) {
+            const Leaf* leaf = static_cast<const Leaf*>(node);
+            Leaf* copy = new Leaf();
+            copy->isLeaf = true;
+            copy->count = leaf->count;
+            for (int i = 0; i < leaf->count; i++) {
+                copy->keys[i] = leaf->keys[i];
+                copy->values[i] = leaf->values[i];
+            }
+            copy->prev = lastCopied;
+            if (lastCopied) {
+                lastCopied->next = copy;
+            } else {
+                firstLeaf = copy;
+            }
+            lastCopied = copy;
+            return copy;
+        }
+        const Inner* inner = static_cast<const Inner*>(node);
+        Inner* copy = new Inner();
+        copy->isLeaf = false;
+        copy->count = inner->count;
+        for (int i = 0; i < inner->count; i++) {
+            copy->keys[i] = inner->keys[i];
+        }
+        for (int i = 0; i <= inner->count; i++) {
+            copy->children[i] = copyTree(inner->children[i], lastCopied);
+        }
+        return copy;
+    }
+
+    void deepCopy(const BTreeMap& src) {
+        root = nullptr;
+        firstLeaf = lastLeaf = nullptr;
+        if (src.root) {
+            Leaf* lastCopied = nullptr;
+            root = copyTree(src.root, lastCopied);
+            lastLeaf = lastCopied;
+        }
+        numEntries = src.numEntries;
+        lessByValue = src.lessByValue;
+        lessByRef = src.lessByRef;
+        m_version++;
+    }
+
+public:
+    /*
+     * Hidden features
+     * ---------------
+     * The remainder of this file consists of the code required to
+     * support deep copying and iteration.  Including these methods in
+     * the public portion of the interface would make that interface more
+     * difficult to understand for the average client.
+     */
+
+    /*
+     * Deep copying support
+     * --------------------
+     * This copy constructor and operator= are defined to make a
+     * deep copy, making it possible to pass/return maps by value
+     * and assign from one map to another.
+     */
+    BTreeMap& operator =(const BTreeMap& src) {
+        if (this != &src) {
+            clear();
+            deepCopy(src);
+        }
+        return *this;
+    }
+
+    BTreeMap(const BTreeMap& src) {
+        deepCopy(src);
+    }
+
+    /*
+     * Iterator support
+     * ----------------
+     * The classes in the StanfordCPPLib collection implement input
+     * iterators so that they work symmetrically with respect to the
+     * corresponding STL classes.
+     */
+    class iterator : public std::iterator<std::input_iterator_tag, KeyType> {
+    private:
+        const BTreeMap* mp;          /* Pointer to the map           */
+        Leaf* leaf;                  /* Current leaf, or nullptr at the end */
+        int index;                   /* Index of current key in leaf */
+        unsigned int itr_version;    /* Version for checking for modification */
+
+    public:
+        iterator()
+                : mp(nullptr),
+                  leaf(nullptr),
+                  index(0),
+                  itr_version(0) {
+            // empty
+        }
+
+        iterator(const BTreeMap* mp, bool end)
+                : mp(mp),
+                  leaf(end ? nullptr : mp->firstLeaf),
+                  index(0),
+                  itr_version(mp->version()) {
+            // empty
+        }
+
+        iterator(const iterator& it)
+                : mp(it.mp),
+                  leaf(it.leaf),
+                  index(it.index),
+                  itr_version(it.itr_version) {
+            // empty
+        }
+
+        iterator& operator =(const iterator& it) {
+            mp = it.mp;
+            leaf = it.leaf;
+            index = it.index;
+            itr_version = it.itr_version;
+            return *this;
+        }
+
+        iterator& operator ++() {
+            stanfordcpplib::collections::checkVersion(*mp, *this);
+            if (++index == leaf->count) {
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        iterator operator ++(int) {
+            iterator copy(*this);
+            operator++();
+            return copy;
+        }
+
+        bool operator ==(const iterator& rhs) {
+            return mp == rhs.mp && leaf == rhs.leaf && index == rhs.index;
+        }
+
+        bool operator !=(const iterator& rhs) {
+            return !(*this == rhs);
+        }
+
+        KeyType& operator *() {
+            stanfordcpplib::collections::checkVersion(*mp, *this);
+            return leaf->keys[index];
+        }
+
+        KeyType* operator ->() {
+            stanfordcpplib::collections::checkVersion(*mp, *this);
+            return &leaf->keys[index];
+        }
+
+        unsigned int version() const {
+            return itr_version;
+        }
+
+        friend class BTreeMap;
+    };
+
+    /*
+     * Returns an iterator positioned at the first key of the map.
+     */
+    iterator begin() const {
+        return iterator(this, /* end */ false);
+    }
+
+    /*
+     * Returns an iterator positioned just past the last key of the map.
+     */
+    iterator end() const {
+        return iterator(this, /* end */ true);
+    }
+
+    /*
+     * Returns the internal version of this collection.
+     * This is used to check for invalid iterators and issue error messages.
+     */
+    unsigned int version() const {
+        return m_version;
+    }
+};
+
+/*
+ * Implementation notes: BTreeMap class
+ * ------------------------------------
+ * Every node holds its keys in a sorted array and is searched by binary
+ * search.  A leaf holds up to LEAF_CAPACITY entries, with keys and values
+ * in separate arrays so that the search scans keys only; an inner node
+ * with n keys has n + 1 children, and child i holds the keys from
+ * keys[i - 1] (inclusive) up to keys[i].  The capacities are chosen from
+ * the key and value sizes so that a node is around a kilobyte, which
+ * keeps the tree three or four levels deep even for tens of millions of
+ * entries.
+ *
+ * A node that overflows on insertion is split in half and the new
+ * separator moves up into its parent, splitting that in turn if needed;
+ * the tree grows taller only when the root splits.  A node that drops
+ * below half full on removal borrows from a sibling, or merges with it
+ * if neither sibling can spare an entry, so every node but the root is
+ * always at least half full.
+ */
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType>::BTreeMap()
+        : root(nullptr),
+          firstLeaf(nullptr),
+          lastLeaf(nullptr),
+          numEntries(0),
+          lessByValue(nullptr),
+          lessByRef(nullptr) {
+    // empty
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType>::BTreeMap(bool lessFunc(KeyType, KeyType))
+        : root(nullptr),
+          firstLeaf(nullptr),
+          lastLeaf(nullptr),
+          numEntries(0),
+          lessByValue(lessFunc),
+          lessByRef(nullptr) {
+    // empty
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType>::BTreeMap(bool lessFunc(const KeyType&, const KeyType&))
+        : root(nullptr),
+          firstLeaf(nullptr),
+          lastLeaf(nullptr),
+          numEntries(0),
+          lessByValue(nullptr),
+          lessByRef(lessFunc) {
+    // empty
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType>::BTreeMap(std::initializer_list<std::pair<KeyType, ValueType> > list)
+        : root(nullptr),
+          firstLeaf(nullptr),
+          lastLeaf(nullptr),
+          numEntries(0),
+          lessByValue(nullptr),
+          lessByRef(nullptr) {
+    putAll(list);
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType>::~BTreeMap() {
+    deleteTree(root);
+}
+
+template <typename KeyType, typename ValueType>
+void BTreeMap<KeyType, ValueType>::add(const KeyType& key, const ValueType& value) {
+    put(key, value);
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType>& BTreeMap<KeyType, ValueType>::addAll(const BTreeMap& map2) {
+    return putAll(map2);
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType>& BTreeMap<KeyType, ValueType>::addAll(
+        std::initializer_list<std::pair<KeyType, ValueType> > list) {
+    return putAll(list);
+}
+
+template <typename KeyType, typename ValueType>
+KeyType BTreeMap<KeyType, ValueType>::back() const {
+    if (isEmpty()) {
+        error("BTreeMap::back: map is empty");
+    }
+    return lastLeaf->keys[lastLeaf->count - 1];
+}
+
+template <typename KeyType, typename ValueType>
+void BTreeMap<KeyType, ValueType>::clear() {
+    deleteTree(root);
+    root = nullptr;
+    firstLeaf = lastLeaf = nullptr;
+    numEntries = 0;
+    m_version++;
+}
+
+template <typename KeyType, typename ValueType>
+bool BTreeMap<KeyType, ValueType>::containsKey(const KeyType& key) const {
+    return findValue(key) != nullptr;
+}
+
+template <typename KeyType, typename ValueType>
+bool BTreeMap<KeyType, ValueType>::equals(const BTreeMap& map2) const {
+    return stanfordcpplib::collections::equalsMap(*this, map2);
+}
+
+template <typename KeyType, typename ValueType>
+KeyType BTreeMap<KeyType, ValueType>::front() const {
+    if (isEmpty()) {
+        error("BTreeMap::front: map is empty");
+    }
+    return firstLeaf->keys[0];
+}
+
+template <typename KeyType, typename ValueType>
+ValueType BTreeMap<KeyType, ValueType>::get(const KeyType& key) const {
+    ValueType* vp = findValue(key);
+    if (!vp) {
+        return ValueType();
+    }
+    return *vp;
+}
+
+template <typename KeyType, typename ValueType>
+bool BTreeMap<KeyType, ValueType>::isEmpty() const {
+    return numEntries == 0;
+}
+
+template <typename KeyType, typename ValueType>
+Vector<KeyType> BTreeMap<KeyType, ValueType>::keys() const {
+    Vector<KeyType> keyset;
+    for (Leaf* leaf = firstLeaf; leaf; leaf = leaf->next) {
+        for (int i = 0; i < leaf->count; i++) {
+            keyset.add(leaf->keys[i]);
+        }
+    }
+    return keyset;
+}
+
+template <typename KeyType, typename ValueType>
+void BTreeMap<KeyType, ValueType>::mapAll(void (*fn)(KeyType, ValueType)) const {
+    for (Leaf* leaf = firstLeaf; leaf; leaf = leaf->next) {
+        for (int i = 0; i < leaf->count; i++) {
+            fn(leaf->keys[i], leaf->values[i]);
+        }
+    }
+}
+
+template <typename KeyType, typename ValueType>
+void BTreeMap<KeyType, ValueType>::mapAll(void (*fn)(const KeyType&,
+                                                     const ValueType&)) const {
+    for (Leaf* leaf = firstLeaf; leaf; leaf = leaf->next) {
+        for (int i = 0; i < leaf->count; i++) {
+            fn(leaf->keys[i], leaf->values[i]);
+        }
+    }
+}
+
+template <typename KeyType, typename ValueType>
+template <typename FunctorType>
+void BTreeMap<KeyType, ValueType>::mapAll(FunctorType fn) const {
+    for (Leaf* leaf = firstLeaf; leaf; leaf = leaf->next) {
+        for (int i = 0; i < leaf->count; i++) {
+            fn(leaf->keys[i], leaf->values[i]);
+        }
+    }
+}
+
+template <typename KeyType, typename ValueType>
+template <typename FunctorType>
+void BTreeMap<KeyType, ValueType>::mapRange(const KeyType& low, const KeyType& high,
+                                            FunctorType fn) const {
+    if (!root) {
+        return;
+    }
+    Leaf* leaf = findLeaf(low);
+    int i = lowerBound(leaf->keys, leaf->count, low);
+    while (leaf) {
+        for (; i < leaf->count; i++) {
+            if (!lessThan(leaf->keys[i], high)) {
+                return;
+            }
+            fn(leaf->keys[i], leaf->values[i]);
+        }
+        leaf = leaf->next;
+        i = 0;
+    }
+}
+
+template <typename KeyType, typename ValueType>
+void BTreeMap<KeyType, ValueType>::put(const KeyType& key, const ValueType& value) {
+    *insertKey(key) = value;
+    m_version++;
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType>& BTreeMap<KeyType, ValueType>::putAll(const BTreeMap& map2) {
+    if (this != &map2) {
+        map2.mapAll([this](const KeyType& key, const ValueType& value) {
+            put(key, value);
+        });
+    }
+    return *this;
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType>& BTreeMap<KeyType, ValueType>::putAll(
+        std::initializer_list<std::pair<KeyType, ValueType> > list) {
+    for (const std::pair<KeyType, ValueType>& pair : list) {
+        put(pair.first, pair.second);
+    }
+    return *this;
+}
+
+template <typename KeyType, typename ValueType>
+void BTreeMap<KeyType, ValueType>::remove(const KeyType& key) {
+    if (root && removeFrom(root, key)) {
+        if (root->count == 0) {
+            Node* oldRoot = root;
+            if (root->isLeaf) {
+                root = nullptr;
+                firstLeaf = lastLeaf = nullptr;
+                delete static_cast<Leaf*>(oldRoot);
+            } else {
+                root = static_cast<Inner*>(oldRoot)->children[0];
+                delete static_cast<Inner*>(oldRoot);
+            }
+        }
+    }
+    m_version++;
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType>& BTreeMap<KeyType, ValueType>::removeAll(const BTreeMap& map2) {
+    for (const KeyType& key : map2) {
+        if (containsKey(key) && get(key) == map2.get(key)) {
+            remove(key);
+        }
+    }
+    return *this;
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType>& BTreeMap<KeyType, ValueType>::removeAll(
+        std::initializer_list<std::pair<KeyType, ValueType> > list) {
+    for (const std::pair<KeyType, ValueType>& pair : list) {
+        if (containsKey(pair.first) && get(pair.first) == pair.second) {
+            remove(pair.first);
+        }
+    }
+    return *this;
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType>& BTreeMap<KeyType, ValueType>::retainAll(const BTreeMap& map2) {
+    Vector<KeyType> toRemove;
+    for (const KeyType& key : *this) {
+        if (!map2.containsKey(key) || get(key) != map2.get(key)) {
+            toRemove.add(key);
+        }
+    }
+    for (const KeyType& key : toRemove) {
+        remove(key);
+    }
+    return *this;
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType>& BTreeMap<KeyType, ValueType>::retainAll(
+        std::initializer_list<std::pair<KeyType, ValueType> > list) {
+    BTreeMap<KeyType, ValueType> map2(list);
+    return retainAll(map2);
+}
+
+template <typename KeyType, typename ValueType>
+int BTreeMap<KeyType, ValueType>::size() const {
+    return numEntries;
+}
+
+template <typename KeyType, typename ValueType>
+std::string BTreeMap<KeyType, ValueType>::toString() const {
+    std::ostringstream os;
+    os << *this;
+    return os.str();
+}
+
+template <typename KeyType, typename ValueType>
+Vector<ValueType> BTreeMap<KeyType, ValueType>::values() const {
+    Vector<ValueType> values;
+    for (Leaf* leaf = firstLeaf; leaf; leaf = leaf->next) {
+        for (int i = 0; i < leaf->count; i++) {
+            values.add(leaf->values[i]);
+        }
+    }
+    return values;
+}
+
+template <typename KeyType, typename ValueType>
+ValueType& BTreeMap<KeyType, ValueType>::operator [](const KeyType& key) {
+    return *insertKey(key);
+}
+
+template <typename KeyType, typename ValueType>
+ValueType BTreeMap<KeyType, ValueType>::operator [](const KeyType& key) const {
+    return get(key);
+}
+
+template <typename KeyType, typename ValueType>
+bool BTreeMap<KeyType, ValueType>::operator ==(const BTreeMap& map2) const {
+    return equals(map2);
+}
+
+template <typename KeyType, typename ValueType>
+bool BTreeMap<KeyType, ValueType>::operator !=(const BTreeMap& map2) const {
+    return !equals(map2);
+}
+
+template <typename KeyType, typename ValueType>
+bool BTreeMap<KeyType, ValueType>::operator <(const BTreeMap& map2) const {
+    return stanfordcpplib::collections::compareMaps(*this, map2) < 0;
+}
+
+template <typename KeyType, typename ValueType>
+bool BTreeMap<KeyType, ValueType>::operator <=(const BTreeMap& map2) const {
+    return stanfordcpplib::collections::compareMaps(*this, map2) <= 0;
+}
+
+template <typename KeyType, typename ValueType>
+bool BTreeMap<KeyType, ValueType>::operator >(const BTreeMap& map2) const {
+    return stanfordcpplib::collections::compareMaps(*this, map2) > 0;
+}
+
+template <typename KeyType, typename ValueType>
+bool BTreeMap<KeyType, ValueType>::operator >=(const BTreeMap& map2) const {
+    return stanfordcpplib::collections::compareMaps(*this, map2) >= 0;
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType> BTreeMap<KeyType, ValueType>::operator +(const BTreeMap& map2) const {
+    BTreeMap<KeyType, ValueType> result = *this;
+    return result.putAll(map2);
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType> BTreeMap<KeyType, ValueType>::operator +(
+        std::initializer_list<std::pair<KeyType, ValueType> > list) const {
+    BTreeMap<KeyType, ValueType> result = *this;
+    return result.putAll(list);
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType>& BTreeMap<KeyType, ValueType>::operator +=(const BTreeMap& map2) {
+    return putAll(map2);
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType>& BTreeMap<KeyType, ValueType>::operator +=(
+        std::initializer_list<std::pair<KeyType, ValueType> > list) {
+    return putAll(list);
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType> BTreeMap<KeyType, ValueType>::operator -(const BTreeMap& map2) const {
+    BTreeMap<KeyType, ValueType> result = *this;
+    return result.removeAll(map2);
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType> BTreeMap<KeyType, ValueType>::operator -(
+        std::initializer_list<std::pair<KeyType, ValueType> > list) const {
+    BTreeMap<KeyType, ValueType> result = *this;
+    return result.removeAll(list);
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType>& BTreeMap<KeyType, ValueType>::operator -=(const BTreeMap& map2) {
+    return removeAll(map2);
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType>& BTreeMap<KeyType, ValueType>::operator -=(
+        std::initializer_list<std::pair<KeyType, ValueType> > list) {
+    return removeAll(list);
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType> BTreeMap<KeyType, ValueType>::operator *(const BTreeMap& map2) const {
+    BTreeMap<KeyType, ValueType> result = *this;
+    return result.retainAll(map2);
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType> BTreeMap<KeyType, ValueType>::operator *(
+        std::initializer_list<std::pair<KeyType, ValueType> > list) const {
+    BTreeMap<KeyType, ValueType> result = *this;
+    return result.retainAll(list);
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType>& BTreeMap<KeyType, ValueType>::operator *=(const BTreeMap& map2) {
+    return retainAll(map2);
+}
+
+template <typename KeyType, typename ValueType>
+BTreeMap<KeyType, ValueType>& BTreeMap<KeyType, ValueType>::operator *=(
+        std::initializer_list<std::pair<KeyType, ValueType> > list) {
+    return retainAll(list);
+}
+
+/*
+ * Implementation notes: << and >>
+ * -------------------------------
+ * The insertion and extraction operators use the template facilities in
+ * strlib.h to read and write generic values in a way that treats strings
+ * specially.
+ */
+template <typename KeyType, typename ValueType>
+std::ostream& operator <<(std::ostream& os,
+                          const BTreeMap<KeyType, ValueType>& map) {
+    return stanfordcpplib::collections::writeMap(os, map);
+}
+
+template <typename KeyType, typename ValueType>
+std::istream& operator >>(std::istream& is, BTreeMap<KeyType, ValueType>& map) {
+    KeyType key;
+    ValueType value;
+    return stanfordcpplib::collections::readMap(is, map, key, value, /* descriptor */ std::string("BTreeMap::operator >>"));
+}
+
+/*
+ * Template hash function for maps.
+ * Requires the key and value types in the BTreeMap to have a hashCode function.
+ */
+template <typename K, typename V>
+int hashCode(const BTreeMap<K, V>& map) {
+    return stanfordcpplib::collections::hashCodeMap(map);
+}
+
+#endif // _btreemap_h
@@ -0,0 +1,820 @@
+/*
+ * File: btreeset.h
+ * ----------------
+ * This file exports the <code>BTreeSet</code> class, a sorted set with the
+ * same interface as <code>Set</code> that is stored in a B+ tree.
+ *
+ * @version 2026/10/17
+ * - initial version
+ * - elements are stored in a BTreeMap with NoValue values
+ */
+
+#include "private/init.h"   // ensure that Stanford C++ lib is initialized
+
+#ifndef INTERNAL_INCLUDE
+#include "private/initstudent.h"   // insert necessary included code by student
+#endif // INTERNAL_INCLUDE
+
+#ifndef _btreeset_h
+#define _btreeset_h
+
+#include <initializer_list>
+#include <iostream>
+#include <set>
+
+#define INTERNAL_INCLUDE 1
+#include "btreemap.h"
+#define INTERNAL_INCLUDE 1
+#include "collections.h"
+#define INTERNAL_INCLUDE 1
+#include "error.h"
+#define INTERNAL_INCLUDE 1
+#include "hashcode.h"
+#define INTERNAL_INCLUDE 1
+#include "vector.h"
+#undef INTERNAL_INCLUDE
+
+/*
+ * Class: BTreeSet<ValueType>
+ * --------------------------
+ * This class stores a collection of distinct elements in sorted order,
+ * exactly like the <code>Set</code> class, but keeps them in a
+ * <code>BTreeMap</code> rather than a <code>Map</code>.  That makes
+ * lookups in large sets several times faster and the set a fraction of
+ * the size; see btreemap.h for details.
+ */
+template <typename ValueType>
+class BTreeSet {
+public:
+    /*
+     * Constructor: BTreeSet
+     * Usage: BTreeSet<ValueType> set;
+     * -------------------------------
+     * Initializes an empty set of the specified element type.
+     * Elements will be ordered according to their "natural" less-than ordering
+     * as dictated by the operator <.
+     */
+    BTreeSet();
+
+    /*
+     * Constructor: BTreeSet
+     * Usage: BTreeSet<ValueType> set(lessFunc);
+     * -----------------------------------------
+     * Initializes a new empty set that uses the given "less-than" comparison
+     * function to order its elements.  The function can accept the two
+     * elements to compare either by value or by const reference.
+     */
+    BTreeSet(bool lessFunc(ValueType, ValueType));
+    BTreeSet(bool lessFunc(const ValueType&, const ValueType&));
+
+    /*
+     * Constructor: BTreeSet
+     * Usage: BTreeSet<ValueType> set {1, 2, 3};
+     * -----------------------------------------
+     * Initializes a new set that stores the given elements.
+     */
+    BTreeSet(std::initializer_list<ValueType> list);
+
+    /*
+     * Destructor: ~BTreeSet
+     * ---------------------
+     * Frees any heap storage associated with this set.
+     */
+    virtual ~BTreeSet();
+
+    /*
+     * Method: add
+     * Usage: set.add(value);
+     * ----------------------
+     * Adds an element to this set, if it was not already there.  For
+     * compatibility with the STL <code>set</code> class, this method
+     * is also exported as <code>insert</code>.
+     */
+    void add(const ValueType& value);
+
+    /*
+     * Method: addAll
+     * Usage: set.addAll(set2);
+     * ------------------------
+     * Adds all elements of the given other set to this set.
+     * You can also pass an initializer list such as {1, 2, 3}.
+     * Returns a reference to this set.
+     * Identical in behavior to the += operator.
+     */
+    BTreeSet& addAll(const BTreeSet& set2);
+    BTreeSet& addAll(std::initializer_list<ValueType> list);
+
+    /*
+     * Method: back
+     * Usage: ValueType value = set.back();
+     * ------------------------------------
+     * Returns the last value in the set in the order established by the
+     * comparison function.
+     * If the set is empty, generates an error.
+     */
+    ValueType back() const;
+
+    /*
+     * Method: clear
+     * Usage: set.clear();
+     * -------------------
+     * Removes all elements from this set.
+     */
+    void clear();
+
+    /*
+     * Method: contains
+     * Usage: if (set.contains(value)) ...
+     * -----------------------------------
+     * Returns <code>true</code> if the specified value is in this set.
+     */
+    bool contains(const ValueType& value) const;
+
+    /*
+     * Method: containsAll
+     * Usage: if (set.containsAll(set2)) ...
+     * -------------------------------------
+     * Returns <code>true</code> if every value from the given other set
+     * is also found in this set.
+     * You can also pass an initializer list such as {1, 2, 3}.
+     * Equivalent in behavior to isSupersetOf.
+     */
+    bool containsAll(const BTreeSet& set2) const;
+    bool containsAll(std::initializer_list<ValueType> list) const;
+
+    /*
+     * Method: equals
+     * Usage: if (set.equals(set2)) ...
+     * --------------------------------
+     * Returns <code>true</code> if this set contains exactly the same values
+     * as the given other set.
+     * Identical in behavior to the == operator.
+     */
+    bool equals(const BTreeSet& set2) const;
+
+    /*
+     * Method: first
+     * Usage: ValueType value = set.first();
+     * -------------------------------------
+     * Returns the first value in the set in the order established by the
+     * comparison function.
+     * If the set is empty, generates an error.
+     * Equivalent to front.
+     */
+    ValueType first() const;
+
+    /*
+     * Method: front
+     * Usage: ValueType value = set.front();
+     * -------------------------------------
+     * Returns the first value in the set in the order established by the
+     * comparison function.
+     * If the set is empty, generates an error.
+     * Equivalent to first.
+     */
+    ValueType front() const;
+
+    /*
+     * Method: insert
+     * Usage: set.insert(value);
+     * -------------------------
+     * Adds an element to this set, if it was not already there.  This
+     * method is exported for compatibility with the STL <code>set</code> class.
+     */
+    void insert(const ValueType& value);
+
+    /*
+     * Method: isEmpty
+     * Usage: if (set.isEmpty()) ...
+     * -----------------------------
+     * Returns <code>true</code> if this set contains no elements.
+     */
+    bool isEmpty() const;
+
+    /*
+     * Method: isSubsetOf
+     * Usage: if (set.isSubsetOf(set2)) ...
+     * ------------------------------------
+     * Implements the subset relation on sets.  It returns
+     * <code>true</code> if every element of this set is
+     * contained in <code>set2</code>.
+     * You can also pass an initializer list such as {1, 2, 3}.
+     */
+    bool isSubsetOf(const BTreeSet& set2) const;
+    bool isSubsetOf(std::initializer_list<ValueType> list) const;
+
+    /*
+     * Method: isSupersetOf
+     * Usage: if (set.isSupersetOf(set2)) ...
+     * --------------------------------------
+     * Implements the superset relation on sets.  It returns
+     * <code>true</code> if every element of <code>set2</code> is
+     * contained in this set.
+     * You can also pass an initializer list such as {1, 2, 3}.
+     * Equivalent in behavior to containsAll.
+     */
+    bool isSupersetOf(const BTreeSet& set2) const;
+    bool isSupersetOf(std::initializer_list<ValueType> list) const;
+
+    /*
+     * Method: mapAll
+     * Usage: set.mapAll(fn);
+     * ----------------------
+     * Iterates through the elements of the set and calls <code>fn(value)</code>
+     * for each one.  The values are processed in ascending order, as defined
+     * by the comparison function.
+     */
+    void mapAll(void (*fn)(ValueType)) const;
+    void mapAll(void (*fn)(const ValueType&)) const;
+    template <typename FunctorType>
+    void mapAll(FunctorType fn) const;
+
+    /*
+     * Method: mapRange
+     * Usage: set.mapRange(low, high, fn);
+     * -----------------------------------
+     * Calls <code>fn(value)</code> for each element that is at least
+     * <code>low</code> and less than <code>high</code>, in ascending order,
+     * visiting only the elements in the range.
+     */
+    template <typename FunctorType>
+    void mapRange(const ValueType& low, const ValueType& high, FunctorType fn) const;
+
+    /*
+     * Method: remove
+     * Usage: set.remove(value);
+     * -------------------------
+     * Removes an element from this set.  If the value was not
+     * contained in the set, no error is generated and the set
+     * remains unchanged.
+     */
+    void remove(const ValueType& value);
+
+    /*
+     * Method: removeAll
+     * Usage: set.removeAll(set2);
+     * ---------------------------
+     * Removes all elements of the given other set from this set.
+     * You can also pass an initializer list such as {1, 2, 3}.
+     * Returns a reference to this set.
+     * Identical in behavior to the -= operator.
+     */
+    BTreeSet& removeAll(const BTreeSet& set2);
+    BTreeSet& removeAll(std::initializer_list<ValueType> list);
+
+    /*
+     * Method: retainAll
+     * Usage: set.retainAll(set2);
+     * ---------------------------
+     * Removes all elements from this set that are not contained in the given
+     * other set.
+     * You can also pass an initializer list such as {1, 2, 3}.
+     * Returns a reference to this set.
+     * Identical in behavior to the *= operator.
+     */
+    BTreeSet& retainAll(const BTreeSet& set2);
+    BTreeSet& retainAll(std::initializer_list<ValueType> list);
+
+    /*
+     * Method: size
+     * Usage: count = set.size();
+     * --------------------------
+     * Returns the number of elements in this set.
+     */
+    int size() const;
+
+    /*
+     * Method: toStlSet
+     * Usage: std::set<ValueType> set2 = set.toStlSet();
+     * -------------------------------------------------
+     * Returns an STL set object with the same elements as this set.
+     */
+    std::set<ValueType> toStlSet() const;
+
+    /*
+     * Method: toString
+     * Usage: string str = set.toString();
+     * -----------------------------------
+     * Converts the set to a printable string representation.
+     */
+    std::string toString() const;
+
+    /*
+     * Operators: ==, !=, <, <=, >, >=
+     * Usage: if (set1 == set2) ...
+     * ----------------------------
+     * Compares two sets in the same way as the corresponding
+     * <code>Set</code> operators.
+     */
+    bool operator ==(const BTreeSet& set2) const;
+    bool operator !=(const BTreeSet& set2) const;
+    bool operator <(const BTreeSet& set2) const;
+    bool operator <=(const BTreeSet& set2) const;
+    bool operator >(const BTreeSet& set2) const;
+    bool operator >=(const BTreeSet& set2) const;
+
+    /*
+     * Operators: +, *, -, +=, *=, -=
+     * Usage: set1 + set2
+     *        set1 += value
+     * --------------------
+     * Return or apply the union, intersection and difference of two sets,
+     * or add or remove a single element, as for the corresponding
+     * <code>Set</code> operators.
+     */
+    BTreeSet operator +(const BTreeSet& set2) const;
+    BTreeSet operator +(std::initializer_list<ValueType> list) const;
+    BTreeSet operator +(const ValueType& element) const;
+    BTreeSet operator *(const BTreeSet& set2) const;
+    BTreeSet operator *(std::initializer_list<ValueType> list) const;
+    BTreeSet operator -(const BTreeSet& set2) const;
+    BTreeSet operator -(std::initializer_list<ValueType> list) const;
+    BTreeSet operator -(const ValueType& element) const;
+    BTreeSet& operator +=(const BTreeSet& set2);
+    BTreeSet& operator +=(std::initializer_list<ValueType> list);
+    BTreeSet& operator +=(const ValueType& value);
+    BTreeSet& operator *=(const BTreeSet& set2);
+    BTreeSet& operator *=(std::initializer_list<ValueType> list);
+    BTreeSet& operator -=(const BTreeSet& set2);
+    BTreeSet& operator -=(std::initializer_list<ValueType> list);
+    BTreeSet& operator -=(const ValueType& value);
+
+    /*
+     * Additional BTreeSet operations
+     * ------------------------------
+     * In addition to the methods listed in this interface, the BTreeSet
+     * class supports the following operations:
+     *
+     *   - Stream I/O using the << and >> operators
+     *   - Deep copying for the copy constructor and assignment operator
+     *   - Iteration using the range-based for statement and STL iterators
+     *
+     * The iteration forms process the BTreeSet in ascending order.
+     */
+
+    /* Private section */
+
+    /**********************************************************************/
+    /* Note: Everything below this point in the file is logically part    */
+    /* of the implementation and should not be of interest to clients.    */
+    /**********************************************************************/
+
+private:
+    typedef stanfordcpplib::collections::NoValue NoValue;
+    BTreeMap<ValueType, NoValue> map;    /* Map used to store the elements */
+
+public:
+    /*
+     * Hidden features
+     * ---------------
+     * The remainder of this file consists of the code required to
+     * support iteration.  Including these methods in the public
+     * interface would make that interface more difficult to understand
+     * for the average client.
+     */
+
+    /*
+     * Iterator support
+     * ----------------
+     * The classes in the StanfordCPPLib collection implement input
+     * iterators so that they work symmetrically with respect to the
+     * corresponding STL classes.
+     */
+    class iterator : public std::iterator<std::input_iterator_tag, ValueType> {
+    private:
+        typename BTreeMap<ValueType, NoValue>::iterator mapit;
+
+    public:
+        iterator() {
+            // empty
+        }
+
+        iterator(const typename BTreeMap<ValueType, NoValue>::iterator& it) : mapit(it) {
+            // empty
+        }
+
+        iterator(const iterator& it) : mapit(it.mapit) {
+            // empty
+        }
+
+        iterator& operator =(const iterator& it) {
+            mapit = it.mapit;
+            return *this;
+        }
+
+        iterator& operator ++() {
+            ++mapit;
+            return *this;
+        }
+
+        iterator operator ++(int) {
+            iterator copy(*this);
+            operator++();
+            return copy;
+        }
+
+        bool operator ==(const iterator& rhs) {
+            return mapit == rhs.mapit;
+        }
+
+        bool operator !=(const iterator& rhs) {
+            return !(*this == rhs);
+        }
+
+        ValueType& operator *() {
+            return *mapit;
+        }
+
+        ValueType* operator ->() {
+            return &*mapit;
+        }
+    };
+
+    iterator begin() const {
+        return iterator(map.begin());
+    }
+
+    iterator end() const {
+        return iterator(map.end());
+    }
+};
+
+template <typename ValueType>
+BTreeSet<ValueType>::BTreeSet() {
+    // empty
+}
+
+template <typename ValueType>
+BTreeSet<ValueType>::BTreeSet(bool lessFunc(ValueType, ValueType))
+        : map(lessFunc) {
+    // empty
+}
+
+template <typename ValueType>
+BTreeSet<ValueType>::BTreeSet(bool lessFunc(const ValueType&, const ValueType&))
+        : map(lessFunc) {
+    // empty
+}
+
+template <typename ValueType>
+BTreeSet<ValueType>::BTreeSet(std::initializer_list<ValueType> list) {
+    addAll(list);
+}
+
+template <typename ValueType>
+BTreeSet<ValueType>::~BTreeSet() {
+    // empty
+}
+
+template <typename ValueType>
+void BTreeSet<ValueType>::add(const ValueType& value) {
+    map.put(value, NoValue());
+}
+
+template <typename ValueType>
+BTreeSet<ValueType>& BTreeSet<ValueType>::addAll(const BTreeSet& set2) {
+    map.putAll(set2.map);
+    return *this;
+}
+
+template <typename ValueType>
+BTreeSet<ValueType>& BTreeSet<ValueType>::addAll(std::initializer_list<ValueType> list) {
+    for (const ValueType& value : list) {
+        add(value);
+    }
+    return *this;
+}
+
+template <typename ValueType>
+ValueType BTreeSet<ValueType>::back() const {
+    if (isEmpty()) {
+        error("BTreeSet::back: set is empty");
+    }
+    return map.back();
+}
+
+template <typename ValueType>
+void BTreeSet<ValueType>::clear() {
+    map.clear();
+}
+
+template <typename ValueType>
+bool BTreeSet<ValueType>::contains(const ValueType& value) const {
+    return map.containsKey(value);
+}
+
+template <typename ValueType>
+bool BTreeSet<ValueType>::containsAll(const BTreeSet& set2) const {
+    return set2.isSubsetOf(*this);
+}
+
+template <typename ValueType>
+bool BTreeSet<ValueType>::containsAll(std::initializer_list<ValueType> list) const {
+    for (const ValueType& value : list) {
+        if (!contains(value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename ValueType>
+bool BTreeSet<ValueType>::equals(const BTreeSet& set2) const {
+    return stanfordcpplib::collections::equals(*this, set2);
+}
+
+template <typename ValueType>
+ValueType BTreeSet<ValueType>::first() const {
+    if (isEmpty()) {
+        error("BTreeSet::first: set is empty");
+    }
+    return map.front();
+}
+
+template <typename ValueType>
+ValueType BTreeSet<ValueType>::front() const {
+    if (isEmpty()) {
+        error("BTreeSet::front: set is empty");
+    }
+    return map.front();
+}
+
+template <typename ValueType>
+void BTreeSet<ValueType>::insert(const ValueType& value) {
+    map.put(value, NoValue());
+}
+
+template <typename ValueType>
+bool BTreeSet<ValueType>::isEmpty() const {
+    return map.isEmpty();
+}
+
+template <typename ValueType>
+bool BTreeSet<ValueType>::isSubsetOf(const BTreeSet& set2) const {
+    if (size() > set2.size()) {
+        return false;
+    }
+    for (const ValueType& value : *this) {
+        if (!set2.contains(value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename ValueType>
+bool BTreeSet<ValueType>::isSubsetOf(std::initializer_list<ValueType> list) const {
+    BTreeSet<ValueType> set2(list);
+    return isSubsetOf(set2);
+}
+
+template <typename ValueType>
+bool BTreeSet<ValueType>::isSupersetOf(const BTreeSet& set2) const {
+    return containsAll(set2);
+}
+
+template <typename ValueType>
+bool BTreeSet<ValueType>::isSupersetOf(std::initializer_list<ValueType> list) const {
+    return containsAll(list);
+}
+
+template <typename ValueType>
+void BTreeSet<ValueType>::mapAll(void (*fn)(ValueType)) const {
+    for (const ValueType& value : *this) {
+        fn(value);
+    }
+}
+
+template <typename ValueType>
+void BTreeSet<ValueType>::mapAll(void (*fn)(const ValueType&)) const {
+    for (const ValueType& value : *this) {
+        fn(value);
+    }
+}
+
+template <typename ValueType>
+template <typename FunctorType>
+void BTreeSet<ValueType>::mapAll(FunctorType fn) const {
+    for (const ValueType& value : *this) {
+        fn(value);
+    }
+}
+
+template <typename ValueType>
+template <typename FunctorType>
+void BTreeSet<ValueType>::mapRange(const ValueType& low, const ValueType& high,
+                                   FunctorType fn) const {
+    map.mapRange(low, high, [&fn](const ValueType& value, const NoValue&) {
+        fn(value);
+    });
+}
+
+template <typename ValueType>
+void BTreeSet<ValueType>::remove(const ValueType& value) {
+    map.remove(value);
+}
+
+template <typename ValueType>
+BTreeSet<ValueType>& BTreeSet<ValueType>::removeAll(const BTreeSet& set2) {
+    if (this == &set2) {
+        clear();
+        return *this;
+    }
+    for (const ValueType& value : set2) {
+        remove(value);
+    }
+    return *this;
+}
+
+template <typename ValueType>
+BTreeSet<ValueType>& BTreeSet<ValueType>::removeAll(std::initializer_list<ValueType> list) {
+    for (const ValueType& value : list) {
+        remove(value);
+    }
+    return *this;
+}
+
+template <typename ValueType>
+BTreeSet<ValueType>& BTreeSet<ValueType>::retainAll(const BTreeSet& set2) {
+    Vector<ValueType> toRemove;
+    for (const ValueType& value : *this) {
+        if (!set2.contains(value)) {
+            toRemove.add(value);
+        }
+    }
+    for (const ValueType& value : toRemove) {
+        remove(value);
+    }
+    return *this;
+}
+
+template <typename ValueType>
+BTreeSet<ValueType>& BTreeSet<ValueType>::retainAll(std::initializer_list<ValueType> list) {
+    BTreeSet<ValueType> set2(list);
+    return retainAll(set2);
+}
+
+template <typename ValueType>
+int BTreeSet<ValueType>::size() const {
+    return map.size();
+}
+
+template <typename ValueType>
+std::set<ValueType> BTreeSet<ValueType>::toStlSet() const {
+    std::set<ValueType> result;
+    for (const ValueType& value : *this) {
+        result.insert(value);
+    }
+    return result;
+}
+
+template <typename ValueType>
+std::string BTreeSet<ValueType>::toString() const {
+    std::ostringstream os;
+    os << *this;
+    return os.str();
+}
+
+template <typename ValueType>
+bool BTreeSet<ValueType>::operator ==(const BTreeSet& set2) const {
+    return equals(set2);
+}
+
+template <typename ValueType>
+bool BTreeSet<ValueType>::operator !=(const BTreeSet& set2) const {
+    return !equals(set2);
+}
+
+template <typename ValueType>
+bool BTreeSet<ValueType>::operator <(const BTreeSet& set2) const {
+    return stanfordcpplib::collections::compare(*this, set2) < 0;
+}
+
+template <typename ValueType>
+bool BTreeSet<ValueType>::operator <=(const BTreeSet& set2) const {
+    return stanfordcpplib::collections::compare(*this, set2) <= 0;
+}
+
+template <typename ValueType>
+bool BTreeSet<ValueType>::operator >(const BTreeSet& set2) const {
+    return stanfordcpplib::collections::compare(*this, set2) > 0;
+}
+
+template <typename ValueType>
+bool BTreeSet<ValueType>::operator >=(const BTreeSet& set2) const {
+    return stanfordcpplib::collections::compare(*this, set2) >= 0;
+}
+
+template <typename ValueType>
+BTreeSet<ValueType> BTreeSet<ValueType>::operator +(const BTreeSet& set2) const {
+    BTreeSet<ValueType> set = *this;
+    return set.addAll(set2);
+}
+
+template <typename ValueType>
+BTreeSet<ValueType> BTreeSet<ValueType>::operator +(std::initializer_list<ValueType> list) const {
+    BTreeSet<ValueType> set = *this;
+    return set.addAll(list);
+}
+
+template <typename ValueType>
+BTreeSet<ValueType> BTreeSet<ValueType>::operator +(const ValueType& element) const {
+    BTreeSet<ValueType> set = *this;
+    set.add(element);
+    return set;
+}
+
+template <typename ValueType>
+BTreeSet<ValueType> BTreeSet<ValueType>::operator *(const BTreeSet& set2) const {
+    BTreeSet<ValueType> set = *this;
+    return set.retainAll(set2);
+}
+
+template <typename ValueType>
+BTreeSet<ValueType> BTreeSet<ValueType>::operator *(std::initializer_list<ValueType> list) const {
+    BTreeSet<ValueType> set = *this;
+    return set.retainAll(list);
+}
+
+template <typename ValueType>
+BTreeSet<ValueType> BTreeSet<ValueType>::operator -(const BTreeSet& set2) const {
+    BTreeSet<ValueType> set = *this;
+    return set.removeAll(set2);
+}
+
+template <typename ValueType>
+BTreeSet<ValueType> BTreeSet<ValueType>::operator -(std::initializer_list<ValueType> list) const {
+    BTreeSet<ValueType> set = *this;
+    return set.removeAll(list);
+}
+
+template <typename ValueType>
+BTreeSet<ValueType> BTreeSet<ValueType>::operator -(const ValueType& element) const {
+    BTreeSet<ValueType> set = *this;
+    set.remove(element);
+    return set;
+}
+
+template <typename ValueType>
+BTreeSet<ValueType>& BTreeSet<ValueType>::operator +=(const BTreeSet& set2) {
+    return addAll(set2);
+}
+
+template <typename ValueType>
+BTreeSet<ValueType>& BTreeSet<ValueType>::operator +=(std::initializer_list<ValueType> list) {
+    return addAll(list);
+}
+
+template <typename ValueType>
+BTreeSet<ValueType>& BTreeSet<ValueType>::operator +=(const ValueType& value) {
+    add(value);
+    return *this;
+}
+
+template <typename ValueType>
+BTreeSet<ValueType>& BTreeSet<ValueType>::operator *=(const BTreeSet& set2) {
+    return retainAll(set2);
+}
+
+template <typename ValueType>
+BTreeSet<ValueType>& BTreeSet<ValueType>::operator *=(std::initializer_list<ValueType> list) {
+    return retainAll(list);
+}
+
+template <typename ValueType>
+BTreeSet<ValueType>& BTreeSet<ValueType>::operator -=(const BTreeSet& set2) {
+    return removeAll(set2);
+}
+
+template <typename ValueType>
+BTreeSet<ValueType>& BTreeSet<ValueType>::operator -=(std::initializer_list<ValueType> list) {
+    return removeAll(list);
+}
+
+template <typename ValueType>
+BTreeSet<ValueType>& BTreeSet<ValueType>::operator -=(const ValueType& value) {
+    remove(value);
+    return *this;
+}
+
+template <typename ValueType>
+std::ostream& operator <<(std::ostream& os, const BTreeSet<ValueType>& set) {
+    return stanfordcpplib::collections::writeCollection(os, set);
+}
+
+template <typename ValueType>
+std::istream& operator >>(std::istream& is, BTreeSet<ValueType>& set) {
+    ValueType element;
+    return stanfordcpplib::collections::readCollection(is, set, element, /* descriptor */ "BTreeSet::operator >>");
+}
+
+/*
+ * Template hash function for sets.
+ * Requires the element type in the BTreeSet to have a hashCode function.
+ */
+template <typename T>
+int hashCode(const BTreeSet<T>& set) {
+    return stanfordcpplib::collections::hashCodeCollection(set);
+}
+
+#endif // _btreeset_h
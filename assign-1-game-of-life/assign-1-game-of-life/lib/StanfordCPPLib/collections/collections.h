@@ -8,6 +8,10 @@
  * Used to implement comparison operators like < and >= on collections.
  *
  * @author Marty Stepp
+ * @version 2026/10/17
+ * - added NoValue and MapNodeValue for maps that only store keys
+ * - added HasLessOperator for choosing inline key comparisons
+ * - added sizeHint for sizing a collection before a bulk insertion
  * @version 2017/12/12
  * - added equalsDouble for collections of double values (can't compare with ==)
  * @version 2017/10/18
@@ -35,6 +39,8 @@
 
 #include <iostream>
 #include <sstream>
+#include <type_traits>
+#include <utility>
 
 #define INTERNAL_INCLUDE 1
 #include "error.h"
@@ -129,6 +135,88 @@ inline bool readGenericValue(std::istream& is, std::string& value) {
 namespace stanfordcpplib {
 namespace collections {
 
+/*
+ * Type: NoValue
+ * -------------
+ * The value type for a map that is only used for its keys, such as the
+ * ones inside Set and LinkedHashSet.  Entries of such a map hold no value
+ * at all.
+ */
+struct NoValue {
+    // empty
+};
+
+/*
+ * Holds the value in a map's node or entry.  The NoValue specialization is
+ * an empty base class, so it adds nothing to the size of the entry.
+ */
+template <typename ValueType>
+struct MapNodeValue {
+    ValueType value;
+
+    ValueType& getValue() {
+        return value;
+    }
+};
+
+template <>
+struct MapNodeValue<NoValue> : NoValue {
+    NoValue& getValue() {
+        return *this;
+    }
+};
+
+/*
+ * Derives from std::true_type if two values of type T can be compared
+ * with <, and from std::false_type otherwise.  Ordered collections use it
+ * to choose, at compile time, between calling std::less inline and always
+ * going through their comparator, so that a collection given its own
+ * comparator does not require its keys to have a < operator.
+ */
+struct HasLessOperatorTest {
+    template <typename T>
+    static auto test(int) -> decltype(std::declval<const T&>() < std::declval<const T&>(),
+                                      std::true_type());
+
+    template <typename T>
+    static std::false_type test(...);
+};
+
+template <typename T>
+struct HasLessOperator : decltype(HasLessOperatorTest::test<T>(0)) {
+    // empty
+};
+
+/*
+ * Returns the number of elements in the given collection if it has a
+ * size() method, as every Stanford and STL collection does, or 0 if it
+ * does not.  Hash-based collections use it to size their tables once
+ * before inserting a whole collection, since the iterators of most
+ * collections cannot be measured in advance.
+ */
+struct SizeHintTest {
+    template <typename T>
+    static auto test(int) -> decltype(std::declval<const T&>().size(), std::true_type());
+
+    template <typename T>
+    static std::false_type test(...);
+};
+
+template <typename CollectionType>
+int sizeHint(const CollectionType& collection, std::true_type) {
+    return static_cast<int>(collection.size());
+}
+
+template <typename CollectionType>
+int sizeHint(const CollectionType&, std::false_type) {
+    return 0;
+}
+
+template <typename CollectionType>
+int sizeHint(const CollectionType& collection) {
+    return sizeHint(collection, decltype(SizeHintTest::test<CollectionType>(0))());
+}
+
 #ifdef SPL_THROW_ON_INVALID_ITERATOR
 template <typename CollectionType, typename IteratorType>
 void checkVersion(const CollectionType& coll, const IteratorType& itr,
@@ -0,0 +1,855 @@
+/*
+ * File: concurrenthashmap.h
+ * -------------------------
+ * This file exports the <code>ConcurrentHashMap</code> class, a hash map
+ * that many threads can read and update at the same time.
+ *
+ * @version 2026/10/17
+ * - initial version
+ * - shards are allocated on cache-line boundaries
+ * - lookups take no lock and write nothing that other threads use; entries
+ *   and tables that writers replace are freed by epoch-based reclamation
+ * - small trivially copyable values are overwritten in place
+ * - the number of shards is limited to MAX_SHARDS
+ */
+
+#include "private/init.h"   // ensure that Stanford C++ lib is initialized
+
+#ifndef INTERNAL_INCLUDE
+#include "private/initstudent.h"   // insert necessary included code by student
+#endif // INTERNAL_INCLUDE
+
+#ifndef _concurrenthashmap_h
+#define _concurrenthashmap_h
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#define INTERNAL_INCLUDE 1
+#include "collections.h"
+#define INTERNAL_INCLUDE 1
+#include "error.h"
+#define INTERNAL_INCLUDE 1
+#include "hashcode.h"
+#define INTERNAL_INCLUDE 1
+#include "hashmap.h"
+#define INTERNAL_INCLUDE 1
+#include "vector.h"
+#undef INTERNAL_INCLUDE
+
+namespace stanfordcpplib {
+namespace collections {
+
+/*
+ * A spin lock that serializes the writers of one shard of a
+ * ConcurrentHashMap.  Critical sections are usually a single insertion or
+ * removal, so waiters spin briefly and then yield rather than block.
+ * Readers never touch it.
+ */
+class SpinLock {
+public:
+    SpinLock() : held(false) {}
+
+    void lock() {
+        while (held.exchange(true, std::memory_order_acquire)) {
+            for (int spins = 0; held.load(std::memory_order_relaxed); spins++) {
+                if (spins >= 64) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+
+    void unlock() {
+        held.store(false, std::memory_order_release);
+    }
+
+private:
+    std::atomic<bool> held;
+
+    // forbid copying
+    SpinLock(const SpinLock&);
+    SpinLock& operator =(const SpinLock&);
+};
+
+/*
+ * Epoch-based reclamation, which lets readers walk shared nodes without
+ * locking them while writers unlink and eventually free those nodes.
+ *
+ * A reader brackets each walk with pin and unpin (see EpochGuard).  Pinning
+ * records the global epoch in a slot that belongs to the calling thread
+ * alone, so readers write nothing that another reader touches.  A writer
+ * that unlinks an object hands it to a RetireList, which tags it with the
+ * epoch at that moment.  The global epoch only moves on once every pinned
+ * thread has seen the current one, so once it has moved on twice past an
+ * object's tag, no thread can still be looking at the object, and it is
+ * freed.  Pins nest, and a thread that stays pinned holds up the freeing
+ * of everything retired meanwhile, in every map.
+ */
+class EpochReclaimer {
+public:
+    static void pin();
+    static void unpin();
+
+    /*
+     * Returns the epoch with which to tag an object that has just been
+     * unlinked.
+     */
+    static uint64_t retireEpoch();
+
+    /*
+     * Moves the global epoch on if every pinned thread has seen it, and
+     * returns the global epoch.  Objects tagged two or more epochs earlier
+     * may be freed.
+     */
+    static uint64_t advance();
+};
+
+/*
+ * Keeps a thread pinned (see EpochReclaimer) until the end of a scope.
+ */
+class EpochGuard {
+public:
+    EpochGuard() { EpochReclaimer::pin(); }
+    ~EpochGuard() { EpochReclaimer::unpin(); }
+
+private:
+    // forbid copying
+    EpochGuard(const EpochGuard&);
+    EpochGuard& operator =(const EpochGuard&);
+};
+
+/*
+ * Objects that have been unlinked from a shared structure but may still be
+ * in use by readers, waiting to be freed.  Every so many retirements, the
+ * objects that no reader can reach any more are freed.  A list belongs to
+ * one writer at a time; its owner provides the locking.
+ */
+class RetireList {
+public:
+    typedef void (*Destroyer)(void* object);
+
+    RetireList();
+
+    /*
+     * Frees everything still on the list, as freeAll does.
+     */
+    ~RetireList();
+
+    /*
+     * Adds an object that has just been unlinked, to be freed later by
+     * calling destroy(object).
+     */
+    void retire(void* object, Destroyer destroy);
+
+    /*
+     * Frees the objects that no reader can reach any more.  retire calls
+     * this every so often; owners call it directly after retiring
+     * something large.
+     */
+    void collect();
+
+    /*
+     * Frees every object on the list at once.  Only safe when no thread
+     * can be reading the structure the objects came from.
+     */
+    void freeAll();
+
+private:
+    struct Entry {
+        void* object;
+        Destroyer destroy;
+        uint64_t epoch;
+    };
+
+    static const size_t COLLECT_INTERVAL = 64;
+
+    std::vector<Entry> entries;   // in order of retirement, so of epoch
+    size_t nextCollect;           // size at which to call collect
+
+    // forbid copying
+    RetireList(const RetireList&);
+    RetireList& operator =(const RetireList&);
+};
+
+/*
+ * Values that a ConcurrentHashMap overwrites in place with one atomic
+ * store rather than by linking in a new node: trivially copyable types of
+ * a size that atomics handle without a lock.
+ */
+template <typename T>
+struct IsAtomicValue
+        : std::integral_constant<bool, std::is_trivially_copyable<T>::value
+                                       && (sizeof(T) == 1 || sizeof(T) == 2
+                                           || sizeof(T) == 4 || sizeof(T) == 8)> {
+};
+
+/*
+ * The value in a node of a ConcurrentHashMap.  Most values never change
+ * once the node is linked in; atomic ones can be replaced with store.
+ */
+template <typename ValueType, bool atomic = IsAtomicValue<ValueType>::value>
+class ConcurrentValue {
+public:
+    explicit ConcurrentValue(const ValueType& value) : value(value) {}
+
+    const ValueType& load() const {
+        return value;
+    }
+
+private:
+    const ValueType value;
+};
+
+template <typename ValueType>
+class ConcurrentValue<ValueType, true> {
+public:
+    explicit ConcurrentValue(const ValueType& value) : value(value) {}
+
+    ValueType load() const {
+        return value.load(std::memory_order_acquire);
+    }
+
+    void store(const ValueType& newValue) {
+        value.store(newValue, std::memory_order_release);
+    }
+
+private:
+    std::atomic<ValueType> value;
+};
+
+} // namespace collections
+} // namespace stanfordcpplib
+
+/*
+ * Class: ConcurrentHashMap<KeyType,ValueType>
+ * -------------------------------------------
+ * This class is a <code>HashMap</code> that may be shared between threads.
+ * Lookups (<code>containsKey</code> and <code>get</code>) take no lock
+ * and write no memory that other threads use, so threads looking up keys
+ * at once, even the same key, do not contend for cache lines.  Changes
+ * are spread over a number of independent shards, each with its own lock,
+ * so threads changing keys in different shards never wait for one
+ * another.
+ *
+ * Every method is safe to call from any thread at any time.  Methods that
+ * look at the whole map, such as <code>size</code> and <code>keys</code>,
+ * visit the shards one after another and so see a mix of earlier and later
+ * states if other threads are changing the map meanwhile.
+ *
+ * Values are returned by copy rather than by reference, since a reference
+ * into a shard could be invalidated by another thread at any moment.
+ * Usage example:
+ *
+ *<pre>
+ * ConcurrentHashMap<string, int> census;
+ * ThreadPool::shared().parallelFor(0, soups.size(), [&](int first, int last) {
+ *     for (int i = first; i < last; i++) {
+ *         census.insertIfAbsent(canonicalForm(soups[i]), i);
+ *     }
+ * });
+ *</pre>
+ */
+template <typename KeyType, typename ValueType>
+class ConcurrentHashMap {
+public:
+    /*
+     * Constructor: ConcurrentHashMap
+     * Usage: ConcurrentHashMap<KeyType,ValueType> map;
+     *        ConcurrentHashMap<KeyType,ValueType> map(numShards);
+     * --------------------------------------------------------
+     * Initializes a new empty map.  The key type has the same requirements
+     * as for <code>HashMap</code>.  The number of shards is rounded up to a
+     * power of two; if it is not given, four shards per hardware thread are
+     * used, and at least 16.  Signals an error if the number of shards is
+     * negative or more than MAX_SHARDS.
+     */
+    explicit ConcurrentHashMap(int numShards = 0);
+
+    /*
+     * Destructor: ~ConcurrentHashMap
+     * ------------------------------
+     * Frees any heap storage associated with this map.  No other thread
+     * may be using the map while it is destroyed.
+     */
+    virtual ~ConcurrentHashMap();
+
+    /*
+     * Method: clear
+     * Usage: map.clear();
+     * -------------------
+     * Removes all entries from this map.
+     */
+    void clear();
+
+    /*
+     * Method: computeIfAbsent
+     * Usage: ValueType value = map.computeIfAbsent(key, fn);
+     * ------------------------------------------------------
+     * Returns the value associated with <code>key</code>.  If there is none,
+     * calls <code>fn(key)</code>, stores its result and returns it.  Even
+     * when several threads ask for the same missing key at once,
+     * <code>fn</code> is called only once for it.  The function runs while
+     * its shard is locked, so it must not use this map.
+     */
+    template <typename FunctorType>
+    ValueType computeIfAbsent(const KeyType& key, FunctorType fn);
+
+    /*
+     * Method: containsKey
+     * Usage: if (map.containsKey(key)) ...
+     * ------------------------------------
+     * Returns <code>true</code> if there is an entry for <code>key</code>
+     * in this map.
+     */
+    bool containsKey(const KeyType& key) const;
+
+    /*
+     * Method: get
+     * Usage: ValueType value = map.get(key);
+     * --------------------------------------
+     * Returns a copy of the value associated with <code>key</code> in this
+     * map.  If <code>key</code> is not found, <code>get</code> returns the
+     * default value for <code>ValueType</code>.
+     */
+    ValueType get(const KeyType& key) const;
+
+    /*
+     * Method: insertIfAbsent
+     * Usage: if (map.insertIfAbsent(key, value)) ...
+     * ----------------------------------------------
+     * Associates <code>key</code> with <code>value</code> unless this map
+     * already has an entry for <code>key</code>, in which case the map is
+     * left unchanged.  Returns <code>true</code> if the entry was added.
+     * Exactly one of several threads inserting the same key succeeds.
+     */
+    bool insertIfAbsent(const KeyType& key, const ValueType& value);
+
+    /*
+     * Method: isEmpty
+     * Usage: if (map.isEmpty()) ...
+     * -----------------------------
+     * Returns <code>true</code> if this map contains no entries.
+     */
+    bool isEmpty() const;
+
+    /*
+     * Method: keys
+     * Usage: Vector<KeyType> keys = map.keys();
+     * -----------------------------------------
+     * Returns a collection containing all keys in this map.
+     */
+    Vector<KeyType> keys() const;
+
+    /*
+     * Method: mapAll
+     * Usage: map.mapAll(fn);
+     * ----------------------
+     * Iterates through the map entries and calls <code>fn(key, value)</code>
+     * for each one.  Entries that other threads add or remove meanwhile may
+     * or may not be visited.  Memory that writers give up cannot be freed
+     * until this method returns, so <code>fn</code> should be quick.
+     */
+    template <typename FunctorType>
+    void mapAll(FunctorType fn) const;
+
+    /*
+     * Method: numShards
+     * Usage: int n = map.numShards();
+     * -------------------------------
+     * Returns the number of independently locked shards in this map.
+     */
+    int numShards() const;
+
+    /*
+     * Constant: MAX_SHARDS
+     * --------------------
+     * The largest number of shards a map may have.
+     */
+    static const int MAX_SHARDS = 1 << 16;
+
+    /*
+     * Method: put
+     * Usage: map.put(key, value);
+     * ---------------------------
+     * Associates <code>key</code> with <code>value</code> in this map.
+     * Any previous value associated with <code>key</code> is replaced
+     * by the new value.
+     */
+    void put(const KeyType& key, const ValueType& value);
+
+    /*
+     * Method: remove
+     * Usage: map.remove(key);
+     * -----------------------
+     * Removes any entry for <code>key</code> from this map.
+     * Returns <code>true</code> if there was one.
+     */
+    bool remove(const KeyType& key);
+
+    /*
+     * Method: size
+     * Usage: int nEntries = map.size();
+     * ---------------------------------
+     * Returns the number of entries in this map.
+     */
+    int size() const;
+
+    /*
+     * Method: toHashMap
+     * Usage: HashMap<KeyType,ValueType> copy = map.toHashMap();
+     * ---------------------------------------------------------
+     * Returns an ordinary single-threaded copy of this map's entries.
+     */
+    HashMap<KeyType, ValueType> toHashMap() const;
+
+    /*
+     * Method: toString
+     * Usage: string str = map.toString();
+     * -----------------------------------
+     * Converts the map to a printable string representation.
+     */
+    std::string toString() const;
+
+    /* Private section */
+
+    /**********************************************************************/
+    /* Note: Everything below this point in the file is logically part    */
+    /* of the implementation and should not be of interest to clients.    */
+    /**********************************************************************/
+
+    /*
+     * Implementation notes:
+     * ---------------------
+     * Each shard is a table of buckets, each bucket a chain of nodes.  A
+     * node's hash and key never change once it has been linked in, and
+     * every pointer that readers follow (a shard's table, a bucket, a
+     * node's next) is stored with release order after the thing it points
+     * to is complete.  So a reader needs no lock: it pins the epoch (see
+     * EpochReclaimer), follows the pointers, and copies out what it finds.
+     *
+     * Writers hold their shard's SpinLock.  Replacing a value links in a
+     * new node in place of the old one, unless the value is small enough
+     * to be stored atomically into the old node (see ConcurrentValue).
+     * Removing a key links past its node.  Either way an unlinked node
+     * keeps its next pointer, so a reader standing on it carries on along
+     * the chain.  Unlinked nodes go onto the shard's RetireList, which
+     * frees them once no reader can still reach them.
+     *
+     * A table grows by doubling, which splits each bucket in two.  Readers
+     * may still be walking the old table, so no node in it is changed: the
+     * tail of each chain whose nodes all land in the same new bucket moves
+     * over as it is, and the nodes in front of it are copied.  The new
+     * table is published with one store, and the old bucket array and the
+     * copied nodes are retired.  With short chains, most nodes move over
+     * without being copied.
+     *
+     * A key's shard is chosen from the low bits of its hashCode64 and its
+     * bucket from the high bits, so the two choices stay independent.
+     * Shards are aligned to a cache line, with the table pointer that
+     * readers load on a line of its own, away from the writers' lock and
+     * counters.  Before C++17, new does not honor that alignment, so the
+     * shards are constructed in storage aligned by hand.
+     */
+
+private:
+    static const int CACHE_LINE_SIZE = 64;
+    static const int INITIAL_BUCKETS = 8;
+    static const int MAX_BUCKETS = 1 << 30;    // largest power of two in an int
+
+    typedef stanfordcpplib::collections::ConcurrentValue<ValueType> Value;
+
+    struct Node {
+        Node(uint64_t hash, const KeyType& key, const ValueType& value, Node* next)
+                : hash(hash), key(key), value(value), next(next) {}
+
+        const uint64_t hash;
+        const KeyType key;
+        Value value;
+        std::atomic<Node*> next;
+    };
+
+    /*
+     * A shard's buckets.  Deleting a table frees only the buckets; the
+     * nodes may have moved on to a bigger table (see destroyTableAndNodes).
+     */
+    struct Table {
+        explicit Table(int numBuckets)
+                : mask(numBuckets - 1),
+                  buckets(new std::atomic<Node*>[numBuckets]()) {}
+
+        ~Table() {
+            delete[] buckets;
+        }
+
+        int indexFor(uint64_t hash) const {
+            return static_cast<int>(hash >> 32) & mask;
+        }
+
+        std::atomic<Node*>& bucketFor(uint64_t hash) const {
+            return buckets[indexFor(hash)];
+        }
+
+        const int mask;                  // number of buckets - 1
+        std::atomic<Node*>* const buckets;
+    };
+
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        Shard() : table(new Table(INITIAL_BUCKETS)), count(0) {}
+
+        ~Shard() {
+            destroyTableAndNodes(table.load(std::memory_order_relaxed));
+        }
+
+        std::atomic<Table*> table;
+        alignas(CACHE_LINE_SIZE) stanfordcpplib::collections::SpinLock lock;
+        std::atomic<int> count;
+        stanfordcpplib::collections::RetireList retired;
+    };
+
+    /*
+     * Holds a shard's lock until the end of a scope.
+     */
+    class WriteGuard {
+    public:
+        explicit WriteGuard(Shard& shard) : lock(shard.lock) { lock.lock(); }
+        ~WriteGuard() { lock.unlock(); }
+    private:
+        stanfordcpplib::collections::SpinLock& lock;
+    };
+
+    void* shardStorage;      // raw allocation holding the shards
+    Shard* shards;           // first cache-line boundary in shardStorage
+    int shardCount;          // always a power of two
+
+    Shard& shardFor(uint64_t hash) const {
+        return shards[hash & uint64_t(shardCount - 1)];
+    }
+
+    /*
+     * Returns the node for the key, or nullptr if there is none.  The caller
+     * must be pinned or hold the shard's lock.
+     */
+    static const Node* find(const Shard& shard, uint64_t hash, const KeyType& key) {
+        const Table* table = shard.table.load(std::memory_order_acquire);
+        const Node* node = table->bucketFor(hash).load(std::memory_order_acquire);
+        while (node && !(node->hash == hash && node->key == key)) {
+            node = node->next.load(std::memory_order_acquire);
+        }
+        return node;
+    }
+
+    /*
+     * Adds a node for a key that is not in the shard, growing the table
+     * first if it is half full, which keeps most chains to one node.  The
+     * caller must hold the shard's lock.
+     */
+    static void insertNode(Shard& shard, uint64_t hash, const KeyType& key, const ValueType& value) {
+        Table* table = shard.table.load(std::memory_order_relaxed);
+        int count = shard.count.load(std::memory_order_relaxed);
+        if (count >= (table->mask + 1) / 2 && table->mask + 1 < MAX_BUCKETS) {
+            table = grow(shard, table);
+        }
+        std::atomic<Node*>& bucket = table->bucketFor(hash);
+        bucket.store(new Node(hash, key, value, bucket.load(std::memory_order_relaxed)),
+                     std::memory_order_release);
+        shard.count.store(count + 1, std::memory_order_relaxed);
+    }
+
+    /*
+     * Gives the node that link points to a new value.  The caller must
+     * hold the shard's lock.
+     */
+    static void replaceValue(Shard&, std::atomic<Node*>*, Node* node, const ValueType& value,
+                             std::true_type /* atomic */) {
+        node->value.store(value);
+    }
+
+    static void replaceValue(Shard& shard, std::atomic<Node*>* link, Node* node,
+                             const ValueType& value, std::false_type /* atomic */) {
+        link->store(new Node(node->hash, node->key, value, node->next.load(std::memory_order_relaxed)),
+                    std::memory_order_release);
+        shard.retired.retire(node, destroyNode);
+    }
+
+    /*
+     * Publishes a table with twice as many buckets in place of the shard's
+     * current one (see the implementation notes).  The caller must hold the
+     * shard's lock.
+     */
+    static Table* grow(Shard& shard, Table* oldTable) {
+        Table* newTable = new Table(2 * (oldTable->mask + 1));
+        std::vector<Node*> copied;
+        for (int i = 0; i <= oldTable->mask; i++) {
+            Node* head = oldTable->buckets[i].load(std::memory_order_relaxed);
+            if (!head) {
+                continue;
+            }
+            Node* lastRun = head;
+            int lastRunIndex = newTable->indexFor(head->hash);
+            for (Node* node = head->next.load(std::memory_order_relaxed); node;
+                 node = node->next.load(std::memory_order_relaxed)) {
+                int index = newTable->indexFor(node->hash);
+                if (index != lastRunIndex) {
+                    lastRun = node;
+                    lastRunIndex = index;
+                }
+            }
+            newTable->buckets[lastRunIndex].store(lastRun, std::memory_order_relaxed);
+            for (Node* node = head; node != lastRun; node = node->next.load(std::memory_order_relaxed)) {
+                std::atomic<Node*>& bucket = newTable->bucketFor(node->hash);
+                bucket.store(new Node(node->hash, node->key, node->value.load(),
+                                      bucket.load(std::memory_order_relaxed)),
+                             std::memory_order_relaxed);
+                copied.push_back(node);
+            }
+        }
+        shard.table.store(newTable, std::memory_order_release);
+        for (Node* node : copied) {
+            shard.retired.retire(node, destroyNode);
+        }
+        shard.retired.retire(oldTable, destroyTable);
+        shard.retired.collect();
+        return newTable;
+    }
+
+    static void destroyNode(void* node) {
+        delete static_cast<Node*>(node);
+    }
+
+    static void destroyTable(void* table) {
+        delete static_cast<Table*>(table);
+    }
+
+    static void destroyTableAndNodes(void* table) {
+        Table* doomed = static_cast<Table*>(table);
+        for (int i = 0; i <= doomed->mask; i++) {
+            Node* node = doomed->buckets[i].load(std::memory_order_relaxed);
+            while (node) {
+                Node* next = node->next.load(std::memory_order_relaxed);
+                delete node;
+                node = next;
+            }
+        }
+        delete doomed;
+    }
+
+    // forbid copying
+    ConcurrentHashMap(const ConcurrentHashMap&);
+    ConcurrentHashMap& operator =(const ConcurrentHashMap&);
+};
+
+template <typename KeyType, typename ValueType>
+ConcurrentHashMap<KeyType, ValueType>::ConcurrentHashMap(int numShards) {
+    if (numShards < 0) {
+        error("ConcurrentHashMap::constructor: number of shards cannot be negative");
+    } else if (numShards > MAX_SHARDS) {
+        error("ConcurrentHashMap::constructor: number of shards cannot be more than MAX_SHARDS");
+    } else if (numShards == 0) {
+        unsigned int numThreads = std::thread::hardware_concurrency();
+        numShards = numThreads > MAX_SHARDS / 4 ? MAX_SHARDS : 4 * (int) numThreads;
+        if (numShards < 16) {
+            numShards = 16;
+        }
+    }
+    shardCount = 1;
+    while (shardCount < numShards) {
+        shardCount *= 2;
+    }
+    shardStorage = ::operator new(shardCount * sizeof(Shard) + CACHE_LINE_SIZE - 1);
+    uintptr_t first = (reinterpret_cast<uintptr_t>(shardStorage) + CACHE_LINE_SIZE - 1)
+            & ~static_cast<uintptr_t>(CACHE_LINE_SIZE - 1);
+    shards = reinterpret_cast<Shard*>(first);
+    for (int i = 0; i < shardCount; i++) {
+        new (&shards[i]) Shard();
+    }
+}
+
+template <typename KeyType, typename ValueType>
+ConcurrentHashMap<KeyType, ValueType>::~ConcurrentHashMap() {
+    for (int i = 0; i < shardCount; i++) {
+        shards[i].~Shard();
+    }
+    ::operator delete(shardStorage);
+}
+
+template <typename KeyType, typename ValueType>
+void ConcurrentHashMap<KeyType, ValueType>::clear() {
+    for (int i = 0; i < shardCount; i++) {
+        Shard& shard = shards[i];
+        WriteGuard guard(shard);
+        Table* oldTable = shard.table.load(std::memory_order_relaxed);
+        shard.table.store(new Table(INITIAL_BUCKETS), std::memory_order_release);
+        shard.count.store(0, std::memory_order_relaxed);
+        shard.retired.retire(oldTable, destroyTableAndNodes);
+        shard.retired.collect();
+    }
+}
+
+template <typename KeyType, typename ValueType>
+template <typename FunctorType>
+ValueType ConcurrentHashMap<KeyType, ValueType>::computeIfAbsent(const KeyType& key, FunctorType fn) {
+    uint64_t hash = hashCode64(key);
+    Shard& shard = shardFor(hash);
+    {
+        stanfordcpplib::collections::EpochGuard guard;
+        if (const Node* node = find(shard, hash, key)) {
+            return node->value.load();
+        }
+    }
+    WriteGuard guard(shard);
+    if (const Node* node = find(shard, hash, key)) {
+        return node->value.load();
+    }
+    ValueType value = fn(key);
+    insertNode(shard, hash, key, value);
+    return value;
+}
+
+template <typename KeyType, typename ValueType>
+bool ConcurrentHashMap<KeyType, ValueType>::containsKey(const KeyType& key) const {
+    uint64_t hash = hashCode64(key);
+    stanfordcpplib::collections::EpochGuard guard;
+    return find(shardFor(hash), hash, key) != nullptr;
+}
+
+template <typename KeyType, typename ValueType>
+ValueType ConcurrentHashMap<KeyType, ValueType>::get(const KeyType& key) const {
+    uint64_t hash = hashCode64(key);
+    stanfordcpplib::collections::EpochGuard guard;
+    const Node* node = find(shardFor(hash), hash, key);
+    return node ? node->value.load() : ValueType();
+}
+
+template <typename KeyType, typename ValueType>
+bool ConcurrentHashMap<KeyType, ValueType>::insertIfAbsent(const KeyType& key, const ValueType& value) {
+    uint64_t hash = hashCode64(key);
+    Shard& shard = shardFor(hash);
+    {
+        stanfordcpplib::collections::EpochGuard guard;
+        if (find(shard, hash, key)) {
+            return false;
+        }
+    }
+    WriteGuard guard(shard);
+    if (find(shard, hash, key)) {
+        return false;
+    }
+    insertNode(shard, hash, key, value);
+    return true;
+}
+
+template <typename KeyType, typename ValueType>
+bool ConcurrentHashMap<KeyType, ValueType>::isEmpty() const {
+    for (int i = 0; i < shardCount; i++) {
+        if (shards[i].count.load(std::memory_order_relaxed) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename KeyType, typename ValueType>
+Vector<KeyType> ConcurrentHashMap<KeyType, ValueType>::keys() const {
+    Vector<KeyType> keyset;
+    mapAll([&keyset](const KeyType& key, const ValueType&) {
+        keyset.add(key);
+    });
+    return keyset;
+}
+
+template <typename KeyType, typename ValueType>
+template <typename FunctorType>
+void ConcurrentHashMap<KeyType, ValueType>::mapAll(FunctorType fn) const {
+    stanfordcpplib::collections::EpochGuard guard;
+    for (int i = 0; i < shardCount; i++) {
+        const Table* table = shards[i].table.load(std::memory_order_acquire);
+        for (int bucket = 0; bucket <= table->mask; bucket++) {
+            const Node* node = table->buckets[bucket].load(std::memory_order_acquire);
+            for (; node; node = node->next.load(std::memory_order_acquire)) {
+                fn(node->key, node->value.load());
+            }
+        }
+    }
+}
+
+template <typename KeyType, typename ValueType>
+int ConcurrentHashMap<KeyType, ValueType>::numShards() const {
+    return shardCount;
+}
+
+template <typename KeyType, typename ValueType>
+void ConcurrentHashMap<KeyType, ValueType>::put(const KeyType& key, const ValueType& value) {
+    uint64_t hash = hashCode64(key);
+    Shard& shard = shardFor(hash);
+    WriteGuard guard(shard);
+    std::atomic<Node*>* link = &shard.table.load(std::memory_order_relaxed)->bucketFor(hash);
+    for (Node* node = link->load(std::memory_order_relaxed); node;
+         link = &node->next, node = link->load(std::memory_order_relaxed)) {
+        if (node->hash == hash && node->key == key) {
+            replaceValue(shard, link, node, value,
+                         std::integral_constant<bool, stanfordcpplib::collections::IsAtomicValue<ValueType>::value>());
+            return;
+        }
+    }
+    insertNode(shard, hash, key, value);
+}
+
+template <typename KeyType, typename ValueType>
+bool ConcurrentHashMap<KeyType, ValueType>::remove(const KeyType& key) {
+    uint64_t hash = hashCode64(key);
+    Shard& shard = shardFor(hash);
+    WriteGuard guard(shard);
+    std::atomic<Node*>* link = &shard.table.load(std::memory_order_relaxed)->bucketFor(hash);
+    for (Node* node = link->load(std::memory_order_relaxed); node;
+         link = &node->next, node = link->load(std::memory_order_relaxed)) {
+        if (node->hash == hash && node->key == key) {
+            link->store(node->next.load(std::memory_order_relaxed), std::memory_order_release);
+            shard.count.store(shard.count.load(std::memory_order_relaxed) - 1,
+                              std::memory_order_relaxed);
+            shard.retired.retire(node, destroyNode);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename KeyType, typename ValueType>
+int ConcurrentHashMap<KeyType, ValueType>::size() const {
+    int total = 0;
+    for (int i = 0; i < shardCount; i++) {
+        total += shards[i].count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+template <typename KeyType, typename ValueType>
+HashMap<KeyType, ValueType> ConcurrentHashMap<KeyType, ValueType>::toHashMap() const {
+    HashMap<KeyType, ValueType> copy;
+    mapAll([&copy](const KeyType& key, const ValueType& value) {
+        copy.put(key, value);
+    });
+    return copy;
+}
+
+template <typename KeyType, typename ValueType>
+std::string ConcurrentHashMap<KeyType, ValueType>::toString() const {
+    std::ostringstream os;
+    os << *this;
+    return os.str();
+}
+
+template <typename KeyType, typename ValueType>
+std::ostream& operator <<(std::ostream& os,
+                          const ConcurrentHashMap<KeyType, ValueType>& map) {
+    return os << map.toHashMap();
+}
+
+#endif // _concurrenthashmap_h
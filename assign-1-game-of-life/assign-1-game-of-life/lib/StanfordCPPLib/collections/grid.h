@@ -4,6 +4,13 @@
  * This file exports the <code>Grid</code> class, which offers a
  * convenient abstraction for representing a two-dimensional array.
  *
+ * @version 2026/10/16
+ * - added rowSpan and data for unchecked access to whole rows in hot loops
+ * - added bit-packed Grid<bool> with countTrue, &=, |=, ^=, flip, shift
+ * - added optional ghost border and cache-line-aligned rows (setBorder),
+ *   with fillBorder, wrapBorder, and mapStencil
+ * - added Layout template parameter with tiled storage (TiledLayout)
+ * - Grid keeps its storage when resized or assigned within its capacity
  * @version 2018/03/12
  * - added overloads that accept GridLocation: get, inBounds, locations, set, operator []
  * @version 2018/03/10
@@ -50,10 +57,13 @@
 #ifndef _grid_h
 #define _grid_h
 
+#include <cstdint>
+#include <cstring>
 #include <initializer_list>
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <utility>
 
 #define INTERNAL_INCLUDE 1
 #include "collections.h"
@@ -71,6 +81,23 @@
 #include "vector.h"
 #undef INTERNAL_INCLUDE
 
+/*
+ * Layouts: RowMajorLayout, TiledLayout<TileSize>
+ * ----------------------------------------------
+ * The optional second template parameter of Grid chooses how the cells are
+ * arranged in memory.  The default, RowMajorLayout, stores each row in turn.
+ * TiledLayout stores square tiles of TileSize x TileSize cells in turn,
+ * which keeps cells that are near one another in both directions near one
+ * another in memory as well.  TileSize must be a power of two.
+ */
+struct RowMajorLayout {};
+
+template <int TileSize = 16>
+struct TiledLayout {};
+
+template <typename ValueType, typename Layout = RowMajorLayout>
+class Grid;
+
 /*
  * Class: Grid<ValueType>
  * ----------------------
@@ -90,11 +117,22 @@
  */
 
 template <typename ValueType>
-class Grid {
+class Grid<ValueType, RowMajorLayout> {
 public:
     /* Forward reference */
     class GridRow;
     class GridRowConst;
+    template <typename ElementType>
+    class BasicRowSpan;
+    class Stencil;
+
+    /*
+     * Types: RowSpan, ConstRowSpan
+     * ----------------------------
+     * Views of a single row of a grid, returned by <code>rowSpan</code>.
+     */
+    typedef BasicRowSpan<ValueType> RowSpan;
+    typedef BasicRowSpan<const ValueType> ConstRowSpan;
 
     /*
      * Constructor: Grid
@@ -138,6 +176,25 @@ public:
      */
     ValueType back() const;
 
+    /*
+     * Method: capacity
+     * Usage: int cells = grid.capacity();
+     * -----------------------------------
+     * Returns the number of elements the grid's storage can hold, ghost
+     * cells and padding included.  Resizing or assigning to the grid
+     * allocates new storage only when the new contents need more than this.
+     */
+    int capacity() const;
+
+    /*
+     * Method: border
+     * Usage: int width = grid.border();
+     * ---------------------------------
+     * Returns the width of the grid's ghost border (see setBorder), which
+     * is 0 unless setBorder has been called.
+     */
+    int border() const;
+
     /*
      * Method: clear
      * Usage: grid.clear();
@@ -146,6 +203,20 @@ public:
      */
     void clear();
 
+    /*
+     * Method: data
+     * Usage: ValueType* elements = grid.data();
+     * -----------------------------------------
+     * Returns a pointer to the grid's element (0, 0).  The elements are
+     * stored in row-major order, one row every <code>pitch()</code> elements,
+     * so the element at (row, col) is at
+     * <code>data()[row * pitch() + col]</code>.  Accesses through the
+     * pointer are not range-checked.  The pointer is invalidated by any call
+     * that changes the grid's dimensions or border.
+     */
+    ValueType* data();
+    const ValueType* data() const;
+
     /*
      * Method: equals
      * Usage: if (grid.equals(grid2)) ...
@@ -164,6 +235,14 @@ public:
      */
     void fill(const ValueType& value);
 
+    /*
+     * Method: fillBorder
+     * Usage: grid.fillBorder(value);
+     * ------------------------------
+     * Stores the given value in every ghost cell of the grid's border.
+     */
+    void fillBorder(const ValueType& value);
+
     /*
      * Method: front
      * Usage: ValueType value = grid.front();
@@ -257,6 +336,22 @@ public:
     template <typename FunctorType>
     void mapAllColumnMajor(FunctorType fn) const;
 
+    /*
+     * Method: mapStencil
+     * Usage: grid.mapStencil(fn);
+     * ---------------------------
+     * Calls the specified function on each cell of the grid, in row-major
+     * order, as <code>fn(row, col, cell)</code>, where <code>cell</code> is
+     * a <code>Grid&lt;ValueType&gt;::Stencil</code>.  Within the function,
+     * <code>cell(dRow, dCol)</code> is the value dRow rows below and dCol
+     * columns to the right of the cell, read directly at a fixed offset;
+     * for cells along the edges the neighbours come from the border, so
+     * offsets must be no larger than <code>border()</code>.  This method
+     * signals an error if the grid has no border.
+     */
+    template <typename FunctorType>
+    void mapStencil(FunctorType fn) const;
+
     /*
      * Method: numCols
      * Usage: int nCols = grid.numCols();
@@ -275,6 +370,16 @@ public:
      */
     int numRows() const;
 
+    /*
+     * Method: pitch
+     * Usage: int pitch = grid.pitch();
+     * --------------------------------
+     * Returns the distance, in elements, from the start of one row of the
+     * grid to the start of the next (see data).  This is equal to numCols()
+     * unless the grid has a border or aligned rows.
+     */
+    int pitch() const;
+
     /*
      * Method: resize
      * Usage: grid.resize(nRows, nCols);
@@ -284,9 +389,49 @@ public:
      * the previous grid contents are retained as much as possible.
      * If 'retain' is not passed or is false, any previous grid contents
      * are discarded.
+     * Resizing with 'retain' to the grid's current dimensions does
+     * nothing, and no resize allocates memory if the grid's capacity is
+     * already large enough, so a loop may resize the same grid every time
+     * around cheaply.
      */
     void resize(int nRows, int nCols, bool retain = false);
 
+    /*
+     * Method: rowSpan
+     * Usage: Grid<ValueType>::RowSpan cells = grid.rowSpan(row);
+     * ----------------------------------------------------------
+     * Returns a view of the given row in which <code>cells[col]</code> reads
+     * or writes an element without range checking, for loops that visit
+     * every cell.  The row index is checked once, here; this method signals
+     * an error if it is outside the grid.  The span also supports
+     * <code>size</code>, <code>data</code>, and iteration, and is
+     * invalidated by any call that changes the grid's dimensions or border.
+     * If the grid has a border of width b, rows -b through numRows() + b - 1
+     * may be requested, and a span may be subscripted from -b through
+     * numCols() + b - 1.
+     */
+    RowSpan rowSpan(int row);
+    ConstRowSpan rowSpan(int row) const;
+
+    /*
+     * Method: setBorder
+     * Usage: grid.setBorder(width);
+     *        grid.setBorder(width, alignRows);
+     * ----------------------------------------
+     * Surrounds the grid with a ghost border that is the given number of
+     * cells wide on every side, so that code visiting the cells along the
+     * edges can read neighbours outside the grid without testing whether
+     * they are in bounds.  The ghost cells start out with the element type's
+     * default value; fillBorder and wrapBorder set them, as can writes
+     * through rowSpan.  They are not part of the grid's contents as seen by
+     * get, set, iteration, comparison, or toString.  If alignRows is true,
+     * each row is padded out to a whole number of 64-byte cache lines and
+     * element (0, 0) starts a cache line, provided the element size divides
+     * 64.  The grid's contents are retained, and the border and alignment
+     * carry over to later calls to resize and to copies of the grid.
+     */
+    void setBorder(int width, bool alignRows = false);
+
     /*
      * Method: set
      * Usage: grid.set(row, col, value);
@@ -342,6 +487,17 @@ public:
      */
     int width() const;
 
+    /*
+     * Method: wrapBorder
+     * Usage: grid.wrapBorder();
+     * -------------------------
+     * Fills the grid's border as if the grid wrapped around in both
+     * directions, so that the ghost cells beyond the right edge repeat the
+     * leftmost columns, those below the bottom edge repeat the top rows, and
+     * so on.  This method signals an error if the grid is empty.
+     */
+    void wrapBorder();
+
 
     /*
      * Operator: []
@@ -415,14 +571,22 @@ public:
      * rows and columns is done by arithmetic computation.  The layout
      * is in row-major order, which is to say that the entire first row
      * is laid out contiguously, followed by the entire second row,
-     * and so on.
+     * and so on.  Rows are nPitch elements apart; nPitch exceeds nCols
+     * only when there is a ghost border, whose cells lie to either side
+     * of each row and in whole rows above and below the grid, or when
+     * rows are padded for alignment.
      */
 
 private:
     /* Instance variables */
-    ValueType* elements;  /* A dynamic array of the elements   */
-    int nRows;            /* The number of rows in the grid    */
-    int nCols;            /* The number of columns in the grid */
+    ValueType* elements = nullptr;  /* Element (0, 0), inside the storage */
+    ValueType* storage = nullptr;   /* The dynamic array, border included */
+    int nCapacity = 0;    /* The number of elements in storage          */
+    int nRows;            /* The number of rows in the grid             */
+    int nCols;            /* The number of columns in the grid          */
+    int nBorder = 0;      /* The width of the ghost border on each side */
+    int nPitch = 0;       /* The distance from one row to the next      */
+    bool alignedRows = false;  /* Whether rows start on cache lines     */
     unsigned int m_version = 0;  // structure version for detecting invalid iterators
 
     /* Private method prototypes */
@@ -437,8 +601,14 @@ private:
      */
     void checkIndexes(int row, int col,
                       int rowMax, int colMax,
-                      std::string prefix) const;
+                      const char* prefix) const;
+    void checkRow(int row, const char* prefix) const;
     int gridCompare(const Grid& grid2) const;
+    int cellsPerLine() const;
+    int pitchFor(int numCols) const;
+    ValueType* cellZeroIn(ValueType* array, int pitch) const;
+    void allocate(bool reset = true);
+    void reallocate(int numRows, int numCols, bool retain);
 
     /*
      * Hidden features
@@ -463,20 +633,24 @@ private:
      * are supported.
      */
     void deepCopy(const Grid& grid) {
-        int n = grid.nRows * grid.nCols;
-        elements = new ValueType[n];
-        for (int i = 0; i < n; i++) {
-            elements[i] = grid.elements[i];
-        }
         nRows = grid.nRows;
         nCols = grid.nCols;
+        nBorder = grid.nBorder;
+        alignedRows = grid.alignedRows;
+        allocate(/* reset */ false);
+        // both grids have the same pitch, so the cells from the first ghost
+        // cell to the last are one contiguous run in each
+        int first = -(nBorder * nPitch) - nBorder;
+        int last = ((nRows + nBorder - 1) * nPitch) + nCols + nBorder;
+        for (int i = first; i < last; i++) {
+            elements[i] = grid.elements[i];
+        }
         m_version++;
     }
 
 public:
     Grid& operator =(const Grid& src) {
         if (this != &src) {
-            delete[] elements;
             deepCopy(src);
         }
         return *this;
@@ -532,12 +706,12 @@ public:
 
         ValueType& operator *() {
             stanfordcpplib::collections::checkVersion(*gp, *this);
-            return gp->elements[index];
+            return gp->elements[offset()];
         }
 
         ValueType* operator ->() {
             stanfordcpplib::collections::checkVersion(*gp, *this);
-            return &gp->elements[index];
+            return &gp->elements[offset()];
         }
 
         unsigned int version() const {
@@ -548,6 +722,13 @@ public:
         const Grid* gp;
         int index;
         unsigned int itr_version;
+
+        int offset() const {
+            if (gp->nPitch == gp->nCols) {
+                return index;
+            }
+            return (index / gp->nCols) * gp->nPitch + index % gp->nCols;
+        }
     };
 
     iterator begin() const {
@@ -579,12 +760,12 @@ public:
         ValueType& operator [](int col) {
             gp->checkIndexes(row, col, gp->nRows-1, gp->nCols-1, "operator [][]");
             gp->m_version++;
-            return gp->elements[(row * gp->nCols) + col];
+            return gp->elements[(row * gp->nPitch) + col];
         }
 
         ValueType operator [](int col) const {
             gp->checkIndexes(row, col, gp->nRows-1, gp->nCols-1, "operator [][]");
-            return gp->elements[(row * gp->nCols) + col];
+            return gp->elements[(row * gp->nPitch) + col];
         }
 
         int size() const {
@@ -611,7 +792,7 @@ public:
 
         const ValueType operator [](int col) const {
             gp->checkIndexes(row, col, gp->nRows-1, gp->nCols-1, "operator [][]");
-            return gp->elements[(row * gp->nCols) + col];
+            return gp->elements[(row * gp->nPitch) + col];
         }
 
         int size() const {
@@ -626,11 +807,78 @@ public:
         friend class Grid;
     };
     friend class GridRowConst;
+
+    /*
+     * Class: Grid<ValType>::BasicRowSpan
+     * ----------------------------------
+     * A pointer to the first element of a row and the row's width.  Nothing
+     * here is range-checked; rowSpan checks the row index when the span is
+     * made, and the column index is up to the client.
+     */
+    template <typename ElementType>
+    class BasicRowSpan {
+    public:
+        BasicRowSpan() : first(nullptr), width(0) {
+            /* Empty */
+        }
+
+        ElementType& operator [](int col) const {
+            return first[col];
+        }
+
+        ElementType* begin() const {
+            return first;
+        }
+
+        ElementType* end() const {
+            return first + width;
+        }
+
+        ElementType* data() const {
+            return first;
+        }
+
+        int size() const {
+            return width;
+        }
+
+    private:
+        BasicRowSpan(ElementType* first, int width) : first(first), width(width) {}
+
+        ElementType* first;
+        int width;
+        friend class Grid;
+    };
+
+    /*
+     * Class: Grid<ValType>::Stencil
+     * -----------------------------
+     * The neighbourhood of one cell, as passed to the function given to
+     * mapStencil: a pointer to the cell and the grid's pitch.  Code that
+     * walks data() itself can make one for any cell with a border around it.
+     */
+    class Stencil {
+    public:
+        Stencil(const ValueType* center, int pitch) : center(center), pitch(pitch) {}
+
+        const ValueType& operator ()(int dRow, int dCol) const {
+            return center[(dRow * pitch) + dCol];
+        }
+
+        const ValueType& operator *() const {
+            return *center;
+        }
+
+    private:
+        const ValueType* center;
+        int pitch;
+    };
 };
 
 template <typename ValueType>
 Grid<ValueType>::Grid()
         : elements(nullptr),
+          storage(nullptr),
           nRows(0),
           nCols(0) {
     // empty
@@ -639,6 +887,7 @@ Grid<ValueType>::Grid()
 template <typename ValueType>
 Grid<ValueType>::Grid(int numRows, int numCols)
         : elements(nullptr),
+          storage(nullptr),
           nRows(0),
           nCols(0) {
     resize(numRows, numCols);
@@ -647,6 +896,7 @@ Grid<ValueType>::Grid(int numRows, int numCols)
 template <typename ValueType>
 Grid<ValueType>::Grid(int numRows, int numCols, const ValueType& value)
         : elements(nullptr),
+          storage(nullptr),
           nRows(0),
           nCols(0) {
     resize(numRows, numCols);
@@ -656,6 +906,7 @@ Grid<ValueType>::Grid(int numRows, int numCols, const ValueType& value)
 template <typename ValueType>
 Grid<ValueType>::Grid(std::initializer_list<std::initializer_list<ValueType> > list)
         : elements(nullptr),
+          storage(nullptr),
           nRows(0),
           nCols(0) {
     // create the grid at the proper size
@@ -682,8 +933,9 @@ Grid<ValueType>::Grid(std::initializer_list<std::initializer_list<ValueType> > l
 
 template <typename ValueType>
 Grid<ValueType>::~Grid() {
-    if (elements) {
-        delete[] elements;
+    if (storage) {
+        delete[] storage;
+        storage = nullptr;
         elements = nullptr;
     }
 }
@@ -696,6 +948,16 @@ ValueType Grid<ValueType>::back() const {
     return get(nRows - 1, nCols - 1);
 }
 
+template <typename ValueType>
+int Grid<ValueType>::border() const {
+    return nBorder;
+}
+
+template <typename ValueType>
+int Grid<ValueType>::capacity() const {
+    return nCapacity;
+}
+
 template <typename ValueType>
 void Grid<ValueType>::clear() {
     ValueType defaultValue = ValueType();
@@ -706,6 +968,17 @@ void Grid<ValueType>::clear() {
     }
 }
 
+template <typename ValueType>
+ValueType* Grid<ValueType>::data() {
+    m_version++;
+    return elements;
+}
+
+template <typename ValueType>
+const ValueType* Grid<ValueType>::data() const {
+    return elements;
+}
+
 template <typename ValueType>
 bool Grid<ValueType>::equals(const Grid<ValueType>& grid2) const {
     // optimization: if literally same grid, stop
@@ -735,6 +1008,24 @@ void Grid<ValueType>::fill(const ValueType& value) {
     }
 }
 
+template <typename ValueType>
+void Grid<ValueType>::fillBorder(const ValueType& value) {
+    for (int row = -nBorder; row < nRows + nBorder; row++) {
+        ValueType* cur = elements + (row * nPitch);
+        if (row < 0 || row >= nRows) {
+            for (int col = -nBorder; col < nCols + nBorder; col++) {
+                cur[col] = value;
+            }
+        } else {
+            for (int i = 1; i <= nBorder; i++) {
+                cur[-i] = value;
+                cur[nCols - 1 + i] = value;
+            }
+        }
+    }
+    m_version++;
+}
+
 template <typename ValueType>
 ValueType Grid<ValueType>::front() const {
     if (isEmpty()) {
@@ -746,13 +1037,13 @@ ValueType Grid<ValueType>::front() const {
 template <typename ValueType>
 ValueType Grid<ValueType>::get(int row, int col) {
     checkIndexes(row, col, nRows-1, nCols-1, "get");
-    return elements[(row * nCols) + col];
+    return elements[(row * nPitch) + col];
 }
 
 template <typename ValueType>
 const ValueType& Grid<ValueType>::get(int row, int col) const {
     checkIndexes(row, col, nRows-1, nCols-1, "get");
-    return elements[(row * nCols) + col];
+    return elements[(row * nPitch) + col];
 }
 
 template <typename ValueType>
@@ -846,6 +1137,20 @@ void Grid<ValueType>::mapAllColumnMajor(FunctorType fn) const {
     }
 }
 
+template <typename ValueType>
+template <typename FunctorType>
+void Grid<ValueType>::mapStencil(FunctorType fn) const {
+    if (nBorder == 0) {
+        error("Grid::mapStencil: grid has no border; call setBorder first");
+    }
+    for (int row = 0; row < nRows; row++) {
+        const ValueType* cur = elements + (row * nPitch);
+        for (int col = 0; col < nCols; col++) {
+            fn(row, col, Stencil(cur + col, nPitch));
+        }
+    }
+}
+
 template <typename ValueType>
 int Grid<ValueType>::numCols() const {
     return nCols;
@@ -856,6 +1161,11 @@ int Grid<ValueType>::numRows() const {
     return nRows;
 }
 
+template <typename ValueType>
+int Grid<ValueType>::pitch() const {
+    return nPitch;
+}
+
 template <typename ValueType>
 void Grid<ValueType>::resize(int numRows, int numCols, bool retain) {
     if (numRows < 0 || numCols < 0) {
@@ -869,48 +1179,165 @@ void Grid<ValueType>::resize(int numRows, int numCols, bool retain) {
     if (numRows == this->nRows && numCols == this->nCols && retain) {
         return;
     }
-    
+    reallocate(numRows, numCols, retain);
+}
+
+/*
+ * Implementation notes: allocate, reallocate
+ * ------------------------------------------
+ * allocate sets up storage for the current dimensions, border, and
+ * alignment, and points elements at cell (0, 0) within it.  The storage
+ * the grid already has is kept if it has room and replaced otherwise;
+ * either way every element, ghost cells included, starts out with the
+ * default value unless reset is false, when the caller is about to
+ * overwrite them all.  For aligned rows the pitch is rounded up to whole
+ * cache lines, and up to one line of slack is allocated so that element
+ * (0, 0) can be moved forward onto a line boundary.
+ *
+ * reallocate changes the dimensions, possibly retaining the old contents.
+ * If it can do so without moving element (0, 0) or changing the pitch,
+ * the retained cells are already where they belong and only the others
+ * are reset.  Otherwise the contents are copied into new storage and the
+ * old storage is freed.
+ */
+template <typename ValueType>
+int Grid<ValueType>::cellsPerLine() const {
+    const int cacheLineSize = 64;
+    if (alignedRows && cacheLineSize % sizeof(ValueType) == 0) {
+        return cacheLineSize / sizeof(ValueType);
+    }
+    return 1;
+}
+
+template <typename ValueType>
+int Grid<ValueType>::pitchFor(int numCols) const {
+    int perLine = cellsPerLine();
+    return (numCols + 2 * nBorder + perLine - 1) / perLine * perLine;
+}
+
+template <typename ValueType>
+ValueType* Grid<ValueType>::cellZeroIn(ValueType* array, int pitch) const {
+    ValueType* cellZero = array + (nBorder * pitch) + nBorder;
+    int perLine = cellsPerLine();
+    if (perLine > 1) {
+        int lineSize = perLine * sizeof(ValueType);
+        int misalignment = static_cast<int>(reinterpret_cast<uintptr_t>(cellZero) % lineSize);
+        if (misalignment != 0) {
+            cellZero += (lineSize - misalignment) / sizeof(ValueType);
+        }
+    }
+    return cellZero;
+}
+
+template <typename ValueType>
+void Grid<ValueType>::allocate(bool reset) {
+    nPitch = pitchFor(nCols);
+    int needed = (nRows + 2 * nBorder) * nPitch + cellsPerLine() - 1;
+    if (!storage || needed > nCapacity) {
+        delete[] storage;
+        storage = nullptr;
+        nCapacity = 0;
+        storage = new ValueType[needed]();
+        nCapacity = needed;
+    } else if (reset) {
+        ValueType defaultValue = ValueType();
+        for (int i = 0; i < needed; i++) {
+            storage[i] = defaultValue;
+        }
+    }
+    elements = cellZeroIn(storage, nPitch);
+}
+
+template <typename ValueType>
+void Grid<ValueType>::reallocate(int numRows, int numCols, bool retain) {
     // save backup of old array/size
+    ValueType* oldStorage = this->storage;
     ValueType* oldElements = this->elements;
     int oldnRows = this->nRows;
     int oldnCols = this->nCols;
-    
-    // create new empty array and set new size
+    int oldPitch = this->nPitch;
+    int minRows = oldnRows < numRows ? oldnRows : numRows;
+    int minCols = oldnCols < numCols ? oldnCols : numCols;
+
+    // retain the old contents in place if they need not move
+    int newPitch = pitchFor(numCols);
+    int needed = (numRows + 2 * nBorder) * newPitch + cellsPerLine() - 1;
+    if (retain && storage && needed <= nCapacity && newPitch == oldPitch
+            && cellZeroIn(storage, newPitch) == oldElements) {
+        this->nRows = numRows;
+        this->nCols = numCols;
+        ValueType defaultValue = ValueType();
+        for (int row = -nBorder; row < nRows + nBorder; row++) {
+            ValueType* cur = elements + (row * nPitch);
+            int kept = (row >= 0 && row < minRows) ? minCols : 0;
+            for (int col = -nBorder; col < nCols + nBorder; col++) {
+                if (col < 0 || col >= kept) {
+                    cur[col] = defaultValue;
+                }
+            }
+        }
+        m_version++;
+        return;
+    }
+
+    // set the new size, keeping the old array to copy from if retaining
     this->nRows = numRows;
     this->nCols = numCols;
-    this->elements = new ValueType[numRows * numCols];
-    
-    // initialize to empty/default state
-    ValueType value = ValueType();
-    for (int i = 0; i < numRows * numCols; i++) {
-        this->elements[i] = value;
+    if (retain) {
+        this->storage = nullptr;
+        this->nCapacity = 0;
     }
-    
+    allocate();
+
     // possibly retain old contents
     if (retain) {
-        int minRows = oldnRows < numRows ? oldnRows : numRows;
-        int minCols = oldnCols < numCols ? oldnCols : numCols;
         for (int row = 0; row < minRows; row++) {
             for (int col = 0; col < minCols; col++) {
-                this->elements[(row * numCols) + col] = oldElements[(row * oldnCols) + col];
+                this->elements[(row * nPitch) + col] = oldElements[(row * oldPitch) + col];
             }
         }
+
+        // free old array memory
+        if (oldStorage) {
+            delete[] oldStorage;
+        }
     }
-    
-    // free old array memory
-    if (oldElements) {
-        delete[] oldElements;
-    }
     m_version++;
 }
 
+template <typename ValueType>
+typename Grid<ValueType>::RowSpan Grid<ValueType>::rowSpan(int row) {
+    checkRow(row, "rowSpan");
+    m_version++;
+    return RowSpan(elements + row * nPitch, nCols);
+}
+
+template <typename ValueType>
+typename Grid<ValueType>::ConstRowSpan Grid<ValueType>::rowSpan(int row) const {
+    checkRow(row, "rowSpan");
+    return ConstRowSpan(elements + row * nPitch, nCols);
+}
+
 template <typename ValueType>
 void Grid<ValueType>::set(int row, int col, const ValueType& value) {
     checkIndexes(row, col, nRows - 1, nCols - 1, "set");
-    elements[(row * nCols) + col] = value;
+    elements[(row * nPitch) + col] = value;
     m_version++;
 }
 
+template <typename ValueType>
+void Grid<ValueType>::setBorder(int width, bool alignRows) {
+    if (width < 0) {
+        error("Grid::setBorder: border width cannot be negative");
+    }
+    if (width == nBorder && alignRows == alignedRows) {
+        return;
+    }
+    nBorder = width;
+    alignedRows = alignRows;
+    reallocate(nRows, nCols, /* retain */ true);
+}
+
 template <typename ValueType>
 void Grid<ValueType>::set(const GridLocation& loc, const ValueType& value) {
     set(loc.row, loc.col, value);
@@ -963,6 +1390,39 @@ int Grid<ValueType>::width() const {
     return nCols;
 }
 
+/*
+ * Implementation notes: wrapBorder
+ * --------------------------------
+ * The ghost cells to either side of each row are filled first, and then
+ * whole padded rows are copied into the ghost rows, which takes care of
+ * the corners.  Indexes are reduced modulo the grid size so that borders
+ * wider than the grid itself still wrap correctly.
+ */
+template <typename ValueType>
+void Grid<ValueType>::wrapBorder() {
+    if (isEmpty()) {
+        error("Grid::wrapBorder: grid is empty");
+    }
+    for (int row = 0; row < nRows; row++) {
+        ValueType* cur = elements + (row * nPitch);
+        for (int i = 1; i <= nBorder; i++) {
+            cur[-i] = cur[((-i % nCols) + nCols) % nCols];
+            cur[nCols - 1 + i] = cur[(i - 1) % nCols];
+        }
+    }
+    for (int i = 1; i <= nBorder; i++) {
+        ValueType* above = elements - (i * nPitch);
+        ValueType* below = elements + ((nRows - 1 + i) * nPitch);
+        const ValueType* aboveSource = elements + ((((-i % nRows) + nRows) % nRows) * nPitch);
+        const ValueType* belowSource = elements + (((i - 1) % nRows) * nPitch);
+        for (int col = -nBorder; col < nCols + nBorder; col++) {
+            above[col] = aboveSource[col];
+            below[col] = belowSource[col];
+        }
+    }
+    m_version++;
+}
+
 template <typename ValueType>
 typename Grid<ValueType>::GridRow Grid<ValueType>::operator [](int row) {
     return GridRow(this, row);
@@ -971,7 +1431,7 @@ typename Grid<ValueType>::GridRow Grid<ValueType>::operator [](int row) {
 template <typename ValueType>
 ValueType& Grid<ValueType>::operator [](const GridLocation& loc) {
     checkIndexes(loc.row, loc.col, nRows-1, nCols-1, "operator []");
-    return elements[(loc.row * nCols) + loc.col];
+    return elements[(loc.row * nPitch) + loc.col];
 }
 
 template <typename ValueType>
@@ -983,7 +1443,7 @@ Grid<ValueType>::operator [](int row) const {
 template <typename ValueType>
 const ValueType& Grid<ValueType>::operator [](const GridLocation& loc) const {
     checkIndexes(loc.row, loc.col, nRows-1, nCols-1, "operator []");
-    return elements[(loc.row * nCols) + loc.col];
+    return elements[(loc.row * nPitch) + loc.col];
 }
 
 template <typename ValueType>
@@ -1019,7 +1479,7 @@ bool Grid<ValueType>::operator >=(const Grid& grid2) const {
 template <typename ValueType>
 void Grid<ValueType>::checkIndexes(int row, int col,
                                    int rowMax, int colMax,
-                                   std::string prefix) const {
+                                   const char* prefix) const {
     const int rowMin = 0;
     const int colMin = 0;
     if (row < rowMin || row > rowMax || col < colMin || col > colMax) {
@@ -1037,6 +1497,19 @@ void Grid<ValueType>::checkIndexes(int row, int col,
     }
 }
 
+template <typename ValueType>
+void Grid<ValueType>::checkRow(int row, const char* prefix) const {
+    if (row < -nBorder || row >= nRows + nBorder) {
+        std::ostringstream out;
+        out << "Grid::" << prefix << ": row " << row << " is outside of valid range [";
+        if (nRows + 2 * nBorder > 0) {
+            out << -nBorder << ".." << (nRows + nBorder - 1);
+        } // else empty grid, no range
+        out << "]";
+        error(out.str());
+    }
+}
+
 template <typename ValueType>
 int Grid<ValueType>::gridCompare(const Grid& grid2) const {
     int h1 = height();
@@ -1076,8 +1549,8 @@ int Grid<ValueType>::gridCompare(const Grid& grid2) const {
  * strlib.h to read and write generic values in a way that treats strings
  * specially.
  */
-template <typename ValueType>
-std::ostream& operator <<(std::ostream& os, const Grid<ValueType>& grid) {
+template <typename ValueType, typename Layout>
+std::ostream& operator <<(std::ostream& os, const Grid<ValueType, Layout>& grid) {
     os << "{";
     int nRows = grid.numRows();
     int nCols = grid.numCols();
@@ -1097,8 +1570,8 @@ std::ostream& operator <<(std::ostream& os, const Grid<ValueType>& grid) {
     return os << "}";
 }
 
-template <typename ValueType>
-std::istream& operator >>(std::istream& is, Grid<ValueType>& grid) {
+template <typename ValueType, typename Layout>
+std::istream& operator >>(std::istream& is, Grid<ValueType, Layout>& grid) {
     Vector<Vector<ValueType> > vec2d;
     if (!(is >> vec2d)) {
         is.setstate(std::ios_base::failbit);
@@ -1118,38 +1591,1635 @@ std::istream& operator >>(std::istream& is, Grid<ValueType>& grid) {
 }
 
 /*
- * Template hash function for grids.
- * Requires the element type in the Grid to have a hashCode function.
+ * Class: Grid<bool>
+ * -----------------
+ * Grids of bool are stored packed, 64 cells to a 64-bit word.  Each row
+ * starts on a fresh word, and the bits past the last column of a row are
+ * always kept zero, so whole rows can be counted, compared, combined, and
+ * shifted a word at a time.  The interface is that of the general Grid,
+ * except that <code>grid[row][col]</code> and the iterators yield proxy
+ * references (as std::vector&lt;bool&gt; does) rather than bool&amp;, and
+ * <code>rowSpan</code> and <code>data</code> are replaced by
+ * <code>rowWords</code>, which gives access to the packed words of a row.
+ * Grids of bool have no ghost border, so setBorder and its companions are
+ * not available.
+ * Grids of bool also support the following whole-grid operations:
+ *
+ *   - countTrue, which counts the cells that are true
+ *   - &=, |=, ^= (and &, |, ^) between grids of the same dimensions
+ *   - flip, which negates every cell
+ *   - shift, which moves the contents of the grid by a row/column offset
  */
-template <typename T>
-int hashCode(const Grid<T>& g) {
-    return stanfordcpplib::collections::hashCodeCollection(g);
-}
+template <>
+class Grid<bool> {
+public:
+    /* Forward reference */
+    class BitReference;
+    class GridRow;
+    class GridRowConst;
 
-/*
- * Function: randomElement
- * Usage: element = randomElement(grid);
- * -------------------------------------
- * Returns a randomly chosen element of the given grid.
- * Throws an error if the grid is empty.
- */
-template <typename T>
-const T& randomElement(const Grid<T>& grid) {
-    if (grid.isEmpty()) {
-        error("randomElement: empty grid was passed");
-    }
+    /*
+     * The type of one packed word, and the number of cells it holds.
+     * Column c of a row is bit (c % 64) of word (c / 64) of that row.
+     */
+    typedef uint64_t WordType;
+    static const int kBitsPerWord = 64;
 
-    int randomIndex = randomInteger(0, grid.size() - 1);
-    int row = randomIndex / grid.numCols();
-    int col = randomIndex % grid.numCols();
-    return grid.get(row, col);
+    Grid();
+    Grid(int nRows, int nCols);
+    Grid(int nRows, int nCols, bool value);
+    Grid(std::initializer_list<std::initializer_list<bool> > list);
+    virtual ~Grid();
+
+    bool back() const;
+    void clear();
+    bool equals(const Grid<bool>& grid2) const;
+    void fill(bool value);
+    bool front() const;
+    bool get(int row, int col) const;
+    bool get(const GridLocation& loc) const;
+    int height() const;
+    bool inBounds(int row, int col) const;
+    bool inBounds(const GridLocation& loc) const;
+    bool isEmpty() const;
+    GridLocationRange locations(bool rowMajor = true) const;
+    void mapAll(void (*fn)(bool value)) const;
+    void mapAll(void (*fn)(const bool& value)) const;
+    template <typename FunctorType>
+    void mapAll(FunctorType fn) const;
+    void mapAllColumnMajor(void (*fn)(bool value)) const;
+    void mapAllColumnMajor(void (*fn)(const bool& value)) const;
+    template <typename FunctorType>
+    void mapAllColumnMajor(FunctorType fn) const;
+    int numCols() const;
+    int numRows() const;
+    void resize(int nRows, int nCols, bool retain = false);
+    void set(int row, int col, bool value);
+    void set(const GridLocation& loc, bool value);
+    int size() const;
+    std::string toString() const;
+    std::string toString2D(
+            std::string rowStart = "{",
+            std::string rowEnd = "}",
+            std::string colSeparator = ", ",
+            std::string rowSeparator = ",\n ") const;
+    int width() const;
+
+    /*
+     * Method: countTrue
+     * Usage: int n = grid.countTrue();
+     * --------------------------------
+     * Returns the number of cells in the grid that are true.
+     */
+    int countTrue() const;
+
+    /*
+     * Method: flip
+     * Usage: grid.flip();
+     * -------------------
+     * Negates every cell of the grid.
+     */
+    void flip();
+
+    /*
+     * Method: shift
+     * Usage: grid.shift(dRows, dCols);
+     * --------------------------------
+     * Moves the contents of the grid so that the value at (row, col) ends
+     * up at (row + dRows, col + dCols).  Values moved past the edges of the
+     * grid are discarded, and the cells left behind become false.
+     */
+    void shift(int dRows, int dCols);
+
+    /*
+     * Method: rowWords
+     * Usage: Grid<bool>::WordType* words = grid.rowWords(row);
+     * --------------------------------------------------------
+     * Returns a pointer to the packed words of the given row, of which
+     * there are <code>wordsPerRow()</code>.  This method signals an error if
+     * the row is outside the grid; accesses through the pointer are not
+     * checked.  Clients that write through the pointer must leave the bits
+     * past the last column zero.
+     */
+    WordType* rowWords(int row);
+    const WordType* rowWords(int row) const;
+    int wordsPerRow() const;
+
+    GridRow operator [](int row);
+    const GridRowConst operator [](int row) const;
+    BitReference operator [](const GridLocation& loc);
+    bool operator [](const GridLocation& loc) const;
+
+    /*
+     * Operators: &=, |=, ^=
+     * Usage: grid1 &= grid2;
+     * ----------------------
+     * Combine each cell of this grid with the corresponding cell of the
+     * given grid, one word at a time.  These operators signal an error if
+     * the grids do not have the same dimensions.
+     */
+    Grid<bool>& operator &=(const Grid<bool>& grid2);
+    Grid<bool>& operator |=(const Grid<bool>& grid2);
+    Grid<bool>& operator ^=(const Grid<bool>& grid2);
+
+    bool operator ==(const Grid& grid2) const;
+    bool operator !=(const Grid& grid2) const;
+    bool operator <(const Grid& grid2) const;
+    bool operator <=(const Grid& grid2) const;
+    bool operator >(const Grid& grid2) const;
+    bool operator >=(const Grid& grid2) const;
+
+    /* Private section */
+
+    /**********************************************************************/
+    /* Note: Everything below this point in the file is logically part    */
+    /* of the implementation and should not be of interest to clients.    */
+    /**********************************************************************/
+
+private:
+    /* Instance variables */
+    WordType* words;      /* The packed rows, wordsInRow words each */
+    int nRows;            /* The number of rows in the grid         */
+    int nCols;            /* The number of columns in the grid      */
+    int wordsInRow;       /* The number of words in each row        */
+    unsigned int m_version = 0;  // structure version for detecting invalid iterators
+
+    /* Private method prototypes */
+    void checkIndexes(int row, int col,
+                      int rowMax, int colMax,
+                      const char* prefix) const;
+    void checkSameSize(const Grid& grid2, const char* prefix) const;
+    int gridCompare(const Grid& grid2) const;
+    WordType lastWordMask() const;
+    static int popCount(WordType word);
+    static void shiftRowBits(WordType* row, int numWords, int dCols);
+
+    void deepCopy(const Grid& grid) {
+        int n = grid.nRows * grid.wordsInRow;
+        words = new WordType[n];
+        for (int i = 0; i < n; i++) {
+            words[i] = grid.words[i];
+        }
+        nRows = grid.nRows;
+        nCols = grid.nCols;
+        wordsInRow = grid.wordsInRow;
+        m_version++;
+    }
+
+public:
+    Grid& operator =(const Grid& src) {
+        if (this != &src) {
+            delete[] words;
+            deepCopy(src);
+        }
+        return *this;
+    }
+
+    Grid(const Grid& src) {
+        deepCopy(src);
+    }
+
+    /*
+     * Class: Grid<bool>::BitReference
+     * -------------------------------
+     * Stands in for a bool& to a single packed cell.
+     */
+    class BitReference {
+    public:
+        operator bool() const {
+            return (*word >> bit) & 1;
+        }
+
+        BitReference& operator =(bool value) {
+            if (value) {
+                *word |= WordType(1) << bit;
+            } else {
+                *word &= ~(WordType(1) << bit);
+            }
+            return *this;
+        }
+
+        BitReference& operator =(const BitReference& other) {
+            return *this = static_cast<bool>(other);
+        }
+
+    private:
+        BitReference(WordType* word, int bit) : word(word), bit(bit) {}
+
+        WordType* word;
+        int bit;
+        friend class Grid;
+    };
+
+    class iterator : public std::iterator<std::input_iterator_tag, bool> {
+    public:
+        iterator(const Grid* theGp, int theIndex)
+                : gp(theGp),
+                  index(theIndex),
+                  itr_version(theGp->version()) {
+            // empty
+        }
+
+        iterator& operator ++() {
+            stanfordcpplib::collections::checkVersion(*gp, *this);
+            index++;
+            return *this;
+        }
+
+        iterator operator ++(int) {
+            stanfordcpplib::collections::checkVersion(*gp, *this);
+            iterator copy(*this);
+            operator++();
+            return copy;
+        }
+
+        bool operator ==(const iterator& rhs) {
+            return gp == rhs.gp && index == rhs.index;
+        }
+
+        bool operator !=(const iterator& rhs) {
+            return !(*this == rhs);
+        }
+
+        BitReference operator *() {
+            stanfordcpplib::collections::checkVersion(*gp, *this);
+            int row = index / gp->nCols;
+            int col = index % gp->nCols;
+            return BitReference(gp->words + row * gp->wordsInRow + col / kBitsPerWord,
+                                col % kBitsPerWord);
+        }
+
+        unsigned int version() const {
+            return itr_version;
+        }
+
+    private:
+        const Grid* gp;
+        int index;
+        unsigned int itr_version;
+    };
+
+    iterator begin() const {
+        return iterator(this, 0);
+    }
+
+    iterator end() const {
+        return iterator(this, nRows * nCols);
+    }
+
+    unsigned int version() const;
+
+    class GridRow {
+    public:
+        GridRow() : gp(nullptr), row(0) {
+            /* Empty */
+        }
+
+        BitReference operator [](int col) {
+            gp->checkIndexes(row, col, gp->nRows-1, gp->nCols-1, "operator [][]");
+            gp->m_version++;
+            return BitReference(gp->words + row * gp->wordsInRow + col / kBitsPerWord,
+                                col % kBitsPerWord);
+        }
+
+        bool operator [](int col) const {
+            return gp->get(row, col);
+        }
+
+        int size() const {
+            return gp->width();
+        }
+
+    private:
+        GridRow(Grid* gridRef, int index) : gp(gridRef), row(index) {}
+
+        Grid* gp;
+        int row;
+        friend class Grid;
+    };
+    friend class GridRow;
+
+    class GridRowConst {
+    public:
+        GridRowConst() : gp(nullptr), row(0) {
+            /* Empty */
+        }
+
+        bool operator [](int col) const {
+            return gp->get(row, col);
+        }
+
+        int size() const {
+            return gp->width();
+        }
+
+    private:
+        GridRowConst(const Grid* gridRef, int index) : gp(gridRef), row(index) {}
+
+        const Grid* const gp;
+        const int row;
+        friend class Grid;
+    };
+    friend class GridRowConst;
+};
+
+inline Grid<bool>::Grid()
+        : words(nullptr),
+          nRows(0),
+          nCols(0),
+          wordsInRow(0) {
+    // empty
+}
+
+inline Grid<bool>::Grid(int numRows, int numCols)
+        : words(nullptr),
+          nRows(0),
+          nCols(0),
+          wordsInRow(0) {
+    resize(numRows, numCols);
+}
+
+inline Grid<bool>::Grid(int numRows, int numCols, bool value)
+        : words(nullptr),
+          nRows(0),
+          nCols(0),
+          wordsInRow(0) {
+    resize(numRows, numCols);
+    fill(value);
+}
+
+inline Grid<bool>::Grid(std::initializer_list<std::initializer_list<bool> > list)
+        : words(nullptr),
+          nRows(0),
+          nCols(0),
+          wordsInRow(0) {
+    int numRows = list.size();
+    int numCols = list.begin() != list.end() ? list.begin()->size() : 0;
+    resize(numRows, numCols);
+    auto rowItr = list.begin();
+    for (int row = 0; row < nRows; row++) {
+        if (static_cast<int>(rowItr->size()) != nCols) {
+            error("Grid::constructor: initializer list is not rectangular (must have same # cols in each row)");
+        }
+        auto colItr = rowItr->begin();
+        for (int col = 0; col < nCols; col++) {
+            set(row, col, *colItr);
+            colItr++;
+        }
+        rowItr++;
+    }
+}
+
+inline Grid<bool>::~Grid() {
+    if (words) {
+        delete[] words;
+        words = nullptr;
+    }
+}
+
+inline bool Grid<bool>::back() const {
+    if (isEmpty()) {
+        error("Grid::back: grid is empty");
+    }
+    return get(nRows - 1, nCols - 1);
+}
+
+inline void Grid<bool>::clear() {
+    fill(false);
+}
+
+inline bool Grid<bool>::equals(const Grid<bool>& grid2) const {
+    if (this == &grid2) {
+        return true;
+    }
+    if (nRows != grid2.nRows || nCols != grid2.nCols) {
+        return false;
+    }
+    for (int i = 0; i < nRows * wordsInRow; i++) {
+        if (words[i] != grid2.words[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline void Grid<bool>::fill(bool value) {
+    if (nCols == 0) {
+        return;
+    }
+    WordType pattern = value ? ~WordType(0) : 0;
+    for (int row = 0; row < nRows; row++) {
+        WordType* w = words + row * wordsInRow;
+        for (int i = 0; i < wordsInRow; i++) {
+            w[i] = pattern;
+        }
+        w[wordsInRow - 1] &= lastWordMask();
+    }
+    m_version++;
+}
+
+inline bool Grid<bool>::front() const {
+    if (isEmpty()) {
+        error("Grid::front: grid is empty");
+    }
+    return get(0, 0);
+}
+
+inline bool Grid<bool>::get(int row, int col) const {
+    checkIndexes(row, col, nRows-1, nCols-1, "get");
+    return (words[row * wordsInRow + col / kBitsPerWord] >> (col % kBitsPerWord)) & 1;
+}
+
+inline bool Grid<bool>::get(const GridLocation& loc) const {
+    return get(loc.row, loc.col);
+}
+
+inline int Grid<bool>::height() const {
+    return nRows;
+}
+
+inline bool Grid<bool>::inBounds(int row, int col) const {
+    return row >= 0 && col >= 0 && row < nRows && col < nCols;
+}
+
+inline bool Grid<bool>::inBounds(const GridLocation& loc) const {
+    return inBounds(loc.row, loc.col);
+}
+
+inline bool Grid<bool>::isEmpty() const {
+    return nRows == 0 || nCols == 0;
+}
+
+inline GridLocationRange Grid<bool>::locations(bool rowMajor) const {
+    return GridLocationRange(0, 0, numRows() - 1, numCols() - 1, rowMajor);
+}
+
+inline void Grid<bool>::mapAll(void (*fn)(bool value)) const {
+    for (int i = 0; i < nRows; i++) {
+        for (int j = 0; j < nCols; j++) {
+            fn(get(i, j));
+        }
+    }
+}
+
+inline void Grid<bool>::mapAll(void (*fn)(const bool& value)) const {
+    for (int i = 0; i < nRows; i++) {
+        for (int j = 0; j < nCols; j++) {
+            fn(get(i, j));
+        }
+    }
+}
+
+template <typename FunctorType>
+void Grid<bool>::mapAll(FunctorType fn) const {
+    for (int i = 0; i < nRows; i++) {
+        for (int j = 0; j < nCols; j++) {
+            fn(get(i, j));
+        }
+    }
+}
+
+inline void Grid<bool>::mapAllColumnMajor(void (*fn)(bool value)) const {
+    for (int j = 0; j < nCols; j++) {
+        for (int i = 0; i < nRows; i++) {
+            fn(get(i, j));
+        }
+    }
+}
+
+inline void Grid<bool>::mapAllColumnMajor(void (*fn)(const bool& value)) const {
+    for (int j = 0; j < nCols; j++) {
+        for (int i = 0; i < nRows; i++) {
+            fn(get(i, j));
+        }
+    }
+}
+
+template <typename FunctorType>
+void Grid<bool>::mapAllColumnMajor(FunctorType fn) const {
+    for (int j = 0; j < nCols; j++) {
+        for (int i = 0; i < nRows; i++) {
+            fn(get(i, j));
+        }
+    }
+}
+
+inline int Grid<bool>::numCols() const {
+    return nCols;
+}
+
+inline int Grid<bool>::numRows() const {
+    return nRows;
+}
+
+inline void Grid<bool>::resize(int numRows, int numCols, bool retain) {
+    if (numRows < 0 || numCols < 0) {
+        std::ostringstream out;
+        out << "Grid::resize: Attempt to resize grid to invalid size ("
+               << numRows << ", " << numCols << ")";
+        error(out.str());
+    }
+
+    // optimization: don't do the resize if we are already that size
+    if (numRows == this->nRows && numCols == this->nCols && retain) {
+        return;
+    }
+
+    WordType* oldWords = this->words;
+    int oldnRows = this->nRows;
+    int oldWordsInRow = this->wordsInRow;
+
+    this->nRows = numRows;
+    this->nCols = numCols;
+    this->wordsInRow = (numCols + kBitsPerWord - 1) / kBitsPerWord;
+    this->words = new WordType[numRows * wordsInRow]();
+
+    // possibly retain old contents; the old rows' unused bits are zero,
+    // so only a narrower grid needs masking
+    if (retain && wordsInRow > 0) {
+        int minRows = oldnRows < numRows ? oldnRows : numRows;
+        int minWords = oldWordsInRow < wordsInRow ? oldWordsInRow : wordsInRow;
+        for (int row = 0; row < minRows; row++) {
+            WordType* w = words + row * wordsInRow;
+            for (int i = 0; i < minWords; i++) {
+                w[i] = oldWords[row * oldWordsInRow + i];
+            }
+            w[wordsInRow - 1] &= lastWordMask();
+        }
+    }
+
+    if (oldWords) {
+        delete[] oldWords;
+    }
+    m_version++;
+}
+
+inline void Grid<bool>::set(int row, int col, bool value) {
+    checkIndexes(row, col, nRows - 1, nCols - 1, "set");
+    BitReference(words + row * wordsInRow + col / kBitsPerWord, col % kBitsPerWord) = value;
+    m_version++;
+}
+
+inline void Grid<bool>::set(const GridLocation& loc, bool value) {
+    set(loc.row, loc.col, value);
+}
+
+inline int Grid<bool>::size() const {
+    return nRows * nCols;
+}
+
+inline std::string Grid<bool>::toString() const {
+    std::ostringstream os;
+    os << *this;
+    return os.str();
+}
+
+inline std::string Grid<bool>::toString2D(
+        std::string rowStart, std::string rowEnd,
+        std::string colSeparator, std::string rowSeparator) const {
+    std::ostringstream os;
+    os << rowStart;
+    for (int i = 0; i < nRows; i++) {
+        if (i > 0) {
+            os << rowSeparator;
+        }
+        os << rowStart;
+        for (int j = 0; j < nCols; j++) {
+            if (j > 0) {
+                os << colSeparator;
+            }
+            writeGenericValue(os, get(i, j), /* forceQuotes */ true);
+        }
+        os << rowEnd;
+    }
+    os << rowEnd;
+    return os.str();
+}
+
+inline unsigned int Grid<bool>::version() const {
+    return m_version;
+}
+
+inline int Grid<bool>::width() const {
+    return nCols;
+}
+
+inline int Grid<bool>::countTrue() const {
+    int count = 0;
+    for (int i = 0; i < nRows * wordsInRow; i++) {
+        count += popCount(words[i]);
+    }
+    return count;
+}
+
+inline void Grid<bool>::flip() {
+    if (nCols == 0) {
+        return;
+    }
+    for (int row = 0; row < nRows; row++) {
+        WordType* w = words + row * wordsInRow;
+        for (int i = 0; i < wordsInRow; i++) {
+            w[i] = ~w[i];
+        }
+        w[wordsInRow - 1] &= lastWordMask();
+    }
+    m_version++;
+}
+
+/*
+ * Implementation notes: shift
+ * ---------------------------
+ * Whole rows move with a single memmove; columns move within each row a
+ * word at a time, each new word being put together from the two old words
+ * that straddle it.
+ */
+inline void Grid<bool>::shift(int dRows, int dCols) {
+    if (isEmpty() || (dRows == 0 && dCols == 0)) {
+        return;
+    }
+    if (dRows >= nRows || -dRows >= nRows || dCols >= nCols || -dCols >= nCols) {
+        clear();
+        return;
+    }
+    size_t rowBytes = sizeof(WordType) * wordsInRow;
+    if (dRows > 0) {
+        memmove(words + dRows * wordsInRow, words, rowBytes * (nRows - dRows));
+        memset(words, 0, rowBytes * dRows);
+    } else if (dRows < 0) {
+        memmove(words, words - dRows * wordsInRow, rowBytes * (nRows + dRows));
+        memset(words + (nRows + dRows) * wordsInRow, 0, rowBytes * -dRows);
+    }
+    if (dCols != 0) {
+        for (int row = 0; row < nRows; row++) {
+            WordType* w = words + row * wordsInRow;
+            shiftRowBits(w, wordsInRow, dCols);
+            w[wordsInRow - 1] &= lastWordMask();
+        }
+    }
+    m_version++;
+}
+
+inline Grid<bool>::WordType* Grid<bool>::rowWords(int row) {
+    checkIndexes(row, 0, nRows - 1, 0, "rowWords");
+    m_version++;
+    return words + row * wordsInRow;
+}
+
+inline const Grid<bool>::WordType* Grid<bool>::rowWords(int row) const {
+    checkIndexes(row, 0, nRows - 1, 0, "rowWords");
+    return words + row * wordsInRow;
+}
+
+inline int Grid<bool>::wordsPerRow() const {
+    return wordsInRow;
+}
+
+inline Grid<bool>::GridRow Grid<bool>::operator [](int row) {
+    return GridRow(this, row);
+}
+
+inline const Grid<bool>::GridRowConst Grid<bool>::operator [](int row) const {
+    return GridRowConst(this, row);
+}
+
+inline Grid<bool>::BitReference Grid<bool>::operator [](const GridLocation& loc) {
+    checkIndexes(loc.row, loc.col, nRows-1, nCols-1, "operator []");
+    m_version++;
+    return BitReference(words + loc.row * wordsInRow + loc.col / kBitsPerWord,
+                        loc.col % kBitsPerWord);
+}
+
+inline bool Grid<bool>::operator [](const GridLocation& loc) const {
+    return get(loc.row, loc.col);
+}
+
+inline Grid<bool>& Grid<bool>::operator &=(const Grid<bool>& grid2) {
+    checkSameSize(grid2, "operator &=");
+    for (int i = 0; i < nRows * wordsInRow; i++) {
+        words[i] &= grid2.words[i];
+    }
+    m_version++;
+    return *this;
+}
+
+inline Grid<bool>& Grid<bool>::operator |=(const Grid<bool>& grid2) {
+    checkSameSize(grid2, "operator |=");
+    for (int i = 0; i < nRows * wordsInRow; i++) {
+        words[i] |= grid2.words[i];
+    }
+    m_version++;
+    return *this;
+}
+
+inline Grid<bool>& Grid<bool>::operator ^=(const Grid<bool>& grid2) {
+    checkSameSize(grid2, "operator ^=");
+    for (int i = 0; i < nRows * wordsInRow; i++) {
+        words[i] ^= grid2.words[i];
+    }
+    m_version++;
+    return *this;
+}
+
+inline bool Grid<bool>::operator ==(const Grid& grid2) const {
+    return equals(grid2);
+}
+
+inline bool Grid<bool>::operator !=(const Grid& grid2) const {
+    return !equals(grid2);
+}
+
+inline bool Grid<bool>::operator <(const Grid& grid2) const {
+    return gridCompare(grid2) < 0;
+}
+
+inline bool Grid<bool>::operator <=(const Grid& grid2) const {
+    return gridCompare(grid2) <= 0;
+}
+
+inline bool Grid<bool>::operator >(const Grid& grid2) const {
+    return gridCompare(grid2) > 0;
+}
+
+inline bool Grid<bool>::operator >=(const Grid& grid2) const {
+    return gridCompare(grid2) >= 0;
+}
+
+inline void Grid<bool>::checkIndexes(int row, int col,
+                                     int rowMax, int colMax,
+                                     const char* prefix) const {
+    const int rowMin = 0;
+    const int colMin = 0;
+    if (row < rowMin || row > rowMax || col < colMin || col > colMax) {
+        std::ostringstream out;
+        out << "Grid::" << prefix << ": (" << row << ", " << col << ")"
+            << " is outside of valid range [";
+        if (rowMin < rowMax && colMin < colMax) {
+            out << "(" << rowMin << ", " << colMin <<  ")..("
+                << rowMax << ", " << colMax << ")";
+        } else if (rowMin == rowMax && colMin == colMax) {
+            out << "(" << rowMin << ", " << colMin <<  ")";
+        } // else min > max, no range, empty grid
+        out << "]";
+        error(out.str());
+    }
+}
+
+inline void Grid<bool>::checkSameSize(const Grid& grid2, const char* prefix) const {
+    if (nRows != grid2.nRows || nCols != grid2.nCols) {
+        std::ostringstream out;
+        out << "Grid::" << prefix << ": grids have different dimensions ("
+            << nRows << "x" << nCols << " and " << grid2.nRows << "x" << grid2.nCols << ")";
+        error(out.str());
+    }
+}
+
+inline int Grid<bool>::gridCompare(const Grid& grid2) const {
+    int h1 = height();
+    int w1 = width();
+    int h2 = grid2.height();
+    int w2 = grid2.width();
+    int rows = h1 > h2 ? h1 : h2;
+    int cols = w1 > w2 ? w1 : w2;
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            if (r >= h1) {
+                return -1;
+            } else if (r >= h2) {
+                return 1;
+            }
+
+            if (c >= w1) {
+                return -1;
+            } else if (c >= w2) {
+                return 1;
+            }
+
+            if (get(r, c) != grid2.get(r, c)) {
+                return grid2.get(r, c) ? -1 : 1;
+            }
+        }
+    }
+    return 0;
+}
+
+inline Grid<bool>::WordType Grid<bool>::lastWordMask() const {
+    int usedBits = nCols % kBitsPerWord;
+    return usedBits == 0 ? ~WordType(0) : (WordType(1) << usedBits) - 1;
+}
+
+inline int Grid<bool>::popCount(WordType word) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return static_cast<int>((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+inline void Grid<bool>::shiftRowBits(WordType* row, int numWords, int dCols) {
+    if (dCols > 0) {
+        int wordShift = dCols / kBitsPerWord;
+        int bitShift = dCols % kBitsPerWord;
+        for (int i = numWords - 1; i >= 0; i--) {
+            int src = i - wordShift;
+            WordType value = 0;
+            if (src >= 0) {
+                value = row[src] << bitShift;
+                if (bitShift != 0 && src > 0) {
+                    value |= row[src - 1] >> (kBitsPerWord - bitShift);
+                }
+            }
+            row[i] = value;
+        }
+    } else {
+        int wordShift = -dCols / kBitsPerWord;
+        int bitShift = -dCols % kBitsPerWord;
+        for (int i = 0; i < numWords; i++) {
+            int src = i + wordShift;
+            WordType value = 0;
+            if (src < numWords) {
+                value = row[src] >> bitShift;
+                if (bitShift != 0 && src + 1 < numWords) {
+                    value |= row[src + 1] << (kBitsPerWord - bitShift);
+                }
+            }
+            row[i] = value;
+        }
+    }
+}
+
+/*
+ * Operators: &, |, ^
+ * Usage: Grid<bool> both = grid1 & grid2;
+ * ---------------------------------------
+ * Return a new grid combining the corresponding cells of two grids of bool
+ * with the same dimensions.
+ */
+inline Grid<bool> operator &(const Grid<bool>& grid1, const Grid<bool>& grid2) {
+    Grid<bool> result = grid1;
+    result &= grid2;
+    return result;
+}
+
+inline Grid<bool> operator |(const Grid<bool>& grid1, const Grid<bool>& grid2) {
+    Grid<bool> result = grid1;
+    result |= grid2;
+    return result;
+}
+
+inline Grid<bool> operator ^(const Grid<bool>& grid1, const Grid<bool>& grid2) {
+    Grid<bool> result = grid1;
+    result ^= grid2;
+    return result;
+}
+
+/*
+ * Class: Grid<ValueType, TiledLayout<TileSize> >
+ * ----------------------------------------------
+ * Grids with the tiled layout store their cells in square tiles of
+ * TileSize x TileSize cells: the tiles are laid out left to right and top
+ * to bottom, and the cells within each tile likewise.  A cell's neighbours
+ * above and below are then usually in the same tile, a few cache lines
+ * away, rather than a whole row of the grid away, which helps code that
+ * reads small 2-D neighbourhoods or walks the grid by columns on wide
+ * grids.  The tiles along the bottom and right edges are padded out to
+ * full size; the padding cells hold the default value and are never
+ * visited.
+ *
+ * The interface is that of the general Grid, except that iterators and
+ * mapAll visit the cells tile by tile, in the order they lie in memory,
+ * rather than row by row, and that the operations that depend on rows
+ * being contiguous (rowSpan, data, pitch, and the ghost border) are not
+ * available.
+ */
+template <typename ValueType, int TileSize>
+class Grid<ValueType, TiledLayout<TileSize> > {
+    static_assert(TileSize > 0 && (TileSize & (TileSize - 1)) == 0,
+                  "Grid: TiledLayout tile size must be a power of two");
+
+public:
+    /* Forward reference */
+    class GridRow;
+    class GridRowConst;
+
+    /*
+     * The number of rows and columns in each tile.
+     */
+    static const int kTileSize = TileSize;
+
+    Grid();
+    Grid(int nRows, int nCols);
+    Grid(int nRows, int nCols, const ValueType& value);
+    Grid(std::initializer_list<std::initializer_list<ValueType> > list);
+    virtual ~Grid();
+
+    ValueType back() const;
+    void clear();
+    bool equals(const Grid& grid2) const;
+    void fill(const ValueType& value);
+    ValueType front() const;
+    ValueType get(int row, int col);
+    const ValueType& get(int row, int col) const;
+    ValueType get(const GridLocation& loc);
+    const ValueType& get(const GridLocation& loc) const;
+    int height() const;
+    bool inBounds(int row, int col) const;
+    bool inBounds(const GridLocation& loc) const;
+    bool isEmpty() const;
+    GridLocationRange locations(bool rowMajor = true) const;
+    void mapAll(void (*fn)(ValueType value)) const;
+    void mapAll(void (*fn)(const ValueType& value)) const;
+    template <typename FunctorType>
+    void mapAll(FunctorType fn) const;
+    void mapAllColumnMajor(void (*fn)(ValueType value)) const;
+    void mapAllColumnMajor(void (*fn)(const ValueType& value)) const;
+    template <typename FunctorType>
+    void mapAllColumnMajor(FunctorType fn) const;
+    int numCols() const;
+    int numRows() const;
+    void resize(int nRows, int nCols, bool retain = false);
+    void set(int row, int col, const ValueType& value);
+    void set(const GridLocation& loc, const ValueType& value);
+    int size() const;
+    std::string toString() const;
+    std::string toString2D(
+            std::string rowStart = "{",
+            std::string rowEnd = "}",
+            std::string colSeparator = ", ",
+            std::string rowSeparator = ",\n ") const;
+    int width() const;
+
+    GridRow operator [](int row);
+    const GridRowConst operator [](int row) const;
+    ValueType& operator [](const GridLocation& loc);
+    const ValueType& operator [](const GridLocation& loc) const;
+
+    bool operator ==(const Grid& grid2) const;
+    bool operator !=(const Grid& grid2) const;
+    bool operator <(const Grid& grid2) const;
+    bool operator <=(const Grid& grid2) const;
+    bool operator >(const Grid& grid2) const;
+    bool operator >=(const Grid& grid2) const;
+
+    /* Private section */
+
+    /**********************************************************************/
+    /* Note: Everything below this point in the file is logically part    */
+    /* of the implementation and should not be of interest to clients.    */
+    /**********************************************************************/
+
+private:
+    static const int kTileCells = TileSize * TileSize;
+
+    /* Instance variables */
+    ValueType* elements;  /* The tiles, kTileCells elements each  */
+    int nRows;            /* The number of rows in the grid       */
+    int nCols;            /* The number of columns in the grid    */
+    int tilesPerRow;      /* The number of tiles across the grid  */
+    int nTiles;           /* The number of tiles in the grid      */
+    unsigned int m_version = 0;  // structure version for detecting invalid iterators
+
+    /* Private method prototypes */
+    void checkIndexes(int row, int col,
+                      int rowMax, int colMax,
+                      const char* prefix) const;
+    int gridCompare(const Grid& grid2) const;
+
+    /*
+     * Returns the index in elements of cell (row, col), which must be
+     * inside the grid.  The arithmetic is unsigned so that the divisions
+     * by the tile size compile to shifts and masks.
+     */
+    int offset(int row, int col) const {
+        unsigned int r = static_cast<unsigned int>(row);
+        unsigned int c = static_cast<unsigned int>(col);
+        unsigned int tile = (r / TileSize) * static_cast<unsigned int>(tilesPerRow) + c / TileSize;
+        return static_cast<int>(tile * kTileCells + (r % TileSize) * TileSize + c % TileSize);
+    }
+
+    void deepCopy(const Grid& grid) {
+        int n = grid.nTiles * kTileCells;
+        elements = new ValueType[n];
+        for (int i = 0; i < n; i++) {
+            elements[i] = grid.elements[i];
+        }
+        nRows = grid.nRows;
+        nCols = grid.nCols;
+        tilesPerRow = grid.tilesPerRow;
+        nTiles = grid.nTiles;
+        m_version++;
+    }
+
+public:
+    Grid& operator =(const Grid& src) {
+        if (this != &src) {
+            delete[] elements;
+            deepCopy(src);
+        }
+        return *this;
+    }
+
+    Grid(const Grid& src) {
+        deepCopy(src);
+    }
+
+    /*
+     * The iterator walks the elements array in order, stepping over the
+     * padding cells of the tiles along the bottom and right edges.
+     */
+    class iterator : public std::iterator<std::input_iterator_tag, ValueType> {
+    public:
+        iterator(const Grid* theGp, int theIndex)
+                : gp(theGp),
+                  index(theIndex),
+                  itr_version(theGp->version()) {
+            skipPadding();
+        }
+
+        iterator& operator ++() {
+            stanfordcpplib::collections::checkVersion(*gp, *this);
+            index++;
+            skipPadding();
+            return *this;
+        }
+
+        iterator operator ++(int) {
+            stanfordcpplib::collections::checkVersion(*gp, *this);
+            iterator copy(*this);
+            operator++();
+            return copy;
+        }
+
+        bool operator ==(const iterator& rhs) {
+            return gp == rhs.gp && index == rhs.index;
+        }
+
+        bool operator !=(const iterator& rhs) {
+            return !(*this == rhs);
+        }
+
+        ValueType& operator *() {
+            stanfordcpplib::collections::checkVersion(*gp, *this);
+            return gp->elements[index];
+        }
+
+        ValueType* operator ->() {
+            stanfordcpplib::collections::checkVersion(*gp, *this);
+            return &gp->elements[index];
+        }
+
+        unsigned int version() const {
+            return itr_version;
+        }
+
+    private:
+        const Grid* gp;
+        int index;
+        unsigned int itr_version;
+
+        void skipPadding() {
+            int end = gp->nTiles * kTileCells;
+            while (index < end) {
+                int tile = index / kTileCells;
+                int inTile = index % kTileCells;
+                int row = (tile / gp->tilesPerRow) * TileSize + inTile / TileSize;
+                int col = (tile % gp->tilesPerRow) * TileSize + inTile % TileSize;
+                if (row < gp->nRows && col < gp->nCols) {
+                    break;
+                }
+                index++;
+            }
+        }
+    };
+
+    iterator begin() const {
+        return iterator(this, 0);
+    }
+
+    iterator end() const {
+        return iterator(this, nTiles * kTileCells);
+    }
+
+    unsigned int version() const;
+
+    class GridRow {
+    public:
+        GridRow() : gp(nullptr), row(0) {
+            /* Empty */
+        }
+
+        ValueType& operator [](int col) {
+            gp->checkIndexes(row, col, gp->nRows-1, gp->nCols-1, "operator [][]");
+            gp->m_version++;
+            return gp->elements[gp->offset(row, col)];
+        }
+
+        ValueType operator [](int col) const {
+            return gp->get(row, col);
+        }
+
+        int size() const {
+            return gp->width();
+        }
+
+    private:
+        GridRow(Grid* gridRef, int index) : gp(gridRef), row(index) {}
+
+        Grid* gp;
+        int row;
+        friend class Grid;
+    };
+    friend class GridRow;
+
+    class GridRowConst {
+    public:
+        GridRowConst() : gp(nullptr), row(0) {
+            /* Empty */
+        }
+
+        const ValueType operator [](int col) const {
+            return gp->get(row, col);
+        }
+
+        int size() const {
+            return gp->width();
+        }
+
+    private:
+        GridRowConst(const Grid* gridRef, int index) : gp(gridRef), row(index) {}
+
+        const Grid* const gp;
+        const int row;
+        friend class Grid;
+    };
+    friend class GridRowConst;
+};
+
+template <typename ValueType, int TileSize>
+Grid<ValueType, TiledLayout<TileSize> >::Grid()
+        : elements(nullptr),
+          nRows(0),
+          nCols(0),
+          tilesPerRow(0),
+          nTiles(0) {
+    // empty
+}
+
+template <typename ValueType, int TileSize>
+Grid<ValueType, TiledLayout<TileSize> >::Grid(int numRows, int numCols)
+        : elements(nullptr),
+          nRows(0),
+          nCols(0),
+          tilesPerRow(0),
+          nTiles(0) {
+    resize(numRows, numCols);
+}
+
+template <typename ValueType, int TileSize>
+Grid<ValueType, TiledLayout<TileSize> >::Grid(int numRows, int numCols, const ValueType& value)
+        : elements(nullptr),
+          nRows(0),
+          nCols(0),
+          tilesPerRow(0),
+          nTiles(0) {
+    resize(numRows, numCols);
+    fill(value);
+}
+
+template <typename ValueType, int TileSize>
+Grid<ValueType, TiledLayout<TileSize> >::Grid(
+        std::initializer_list<std::initializer_list<ValueType> > list)
+        : elements(nullptr),
+          nRows(0),
+          nCols(0),
+          tilesPerRow(0),
+          nTiles(0) {
+    int numRows = list.size();
+    int numCols = list.begin() != list.end() ? list.begin()->size() : 0;
+    resize(numRows, numCols);
+    auto rowItr = list.begin();
+    for (int row = 0; row < nRows; row++) {
+        if (static_cast<int>(rowItr->size()) != nCols) {
+            error("Grid::constructor: initializer list is not rectangular (must have same # cols in each row)");
+        }
+        auto colItr = rowItr->begin();
+        for (int col = 0; col < nCols; col++) {
+            set(row, col, *colItr);
+            colItr++;
+        }
+        rowItr++;
+    }
+}
+
+template <typename ValueType, int TileSize>
+Grid<ValueType, TiledLayout<TileSize> >::~Grid() {
+    if (elements) {
+        delete[] elements;
+        elements = nullptr;
+    }
+}
+
+template <typename ValueType, int TileSize>
+ValueType Grid<ValueType, TiledLayout<TileSize> >::back() const {
+    if (isEmpty()) {
+        error("Grid::back: grid is empty");
+    }
+    return get(nRows - 1, nCols - 1);
+}
+
+template <typename ValueType, int TileSize>
+void Grid<ValueType, TiledLayout<TileSize> >::clear() {
+    fill(ValueType());
+}
+
+template <typename ValueType, int TileSize>
+bool Grid<ValueType, TiledLayout<TileSize> >::equals(const Grid& grid2) const {
+    // optimization: if literally same grid, stop
+    if (this == &grid2) {
+        return true;
+    }
+    if (nRows != grid2.nRows || nCols != grid2.nCols) {
+        return false;
+    }
+    // same dimensions means the same tiles, and the padding always holds
+    // the default value, so the arrays can be compared cell for cell
+    int n = nTiles * kTileCells;
+    for (int i = 0; i < n; i++) {
+        if (elements[i] != grid2.elements[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename ValueType, int TileSize>
+void Grid<ValueType, TiledLayout<TileSize> >::fill(const ValueType& value) {
+    for (int row = 0; row < nRows; row++) {
+        for (int col = 0; col < nCols; col++) {
+            elements[offset(row, col)] = value;
+        }
+    }
+    m_version++;
+}
+
+template <typename ValueType, int TileSize>
+ValueType Grid<ValueType, TiledLayout<TileSize> >::front() const {
+    if (isEmpty()) {
+        error("Grid::front: grid is empty");
+    }
+    return get(0, 0);
+}
+
+template <typename ValueType, int TileSize>
+ValueType Grid<ValueType, TiledLayout<TileSize> >::get(int row, int col) {
+    checkIndexes(row, col, nRows-1, nCols-1, "get");
+    return elements[offset(row, col)];
+}
+
+template <typename ValueType, int TileSize>
+const ValueType& Grid<ValueType, TiledLayout<TileSize> >::get(int row, int col) const {
+    checkIndexes(row, col, nRows-1, nCols-1, "get");
+    return elements[offset(row, col)];
+}
+
+template <typename ValueType, int TileSize>
+ValueType Grid<ValueType, TiledLayout<TileSize> >::get(const GridLocation& loc) {
+    return get(loc.row, loc.col);
+}
+
+template <typename ValueType, int TileSize>
+const ValueType& Grid<ValueType, TiledLayout<TileSize> >::get(const GridLocation& loc) const {
+    return get(loc.row, loc.col);
+}
+
+template <typename ValueType, int TileSize>
+int Grid<ValueType, TiledLayout<TileSize> >::height() const {
+    return nRows;
+}
+
+template <typename ValueType, int TileSize>
+bool Grid<ValueType, TiledLayout<TileSize> >::inBounds(int row, int col) const {
+    return row >= 0 && col >= 0 && row < nRows && col < nCols;
+}
+
+template <typename ValueType, int TileSize>
+bool Grid<ValueType, TiledLayout<TileSize> >::inBounds(const GridLocation& loc) const {
+    return inBounds(loc.row, loc.col);
+}
+
+template <typename ValueType, int TileSize>
+bool Grid<ValueType, TiledLayout<TileSize> >::isEmpty() const {
+    return nRows == 0 || nCols == 0;
+}
+
+template <typename ValueType, int TileSize>
+GridLocationRange Grid<ValueType, TiledLayout<TileSize> >::locations(bool rowMajor) const {
+    return GridLocationRange(0, 0, numRows() - 1, numCols() - 1, rowMajor);
+}
+
+template <typename ValueType, int TileSize>
+void Grid<ValueType, TiledLayout<TileSize> >::mapAll(void (*fn)(ValueType value)) const {
+    mapAll<void (*)(ValueType)>(fn);
+}
+
+template <typename ValueType, int TileSize>
+void Grid<ValueType, TiledLayout<TileSize> >::mapAll(void (*fn)(const ValueType& value)) const {
+    mapAll<void (*)(const ValueType&)>(fn);
+}
+
+template <typename ValueType, int TileSize>
+template <typename FunctorType>
+void Grid<ValueType, TiledLayout<TileSize> >::mapAll(FunctorType fn) const {
+    for (int tile = 0; tile < nTiles; tile++) {
+        int firstRow = (tile / tilesPerRow) * TileSize;
+        int firstCol = (tile % tilesPerRow) * TileSize;
+        int rows = nRows - firstRow < TileSize ? nRows - firstRow : TileSize;
+        int cols = nCols - firstCol < TileSize ? nCols - firstCol : TileSize;
+        const ValueType* cur = elements + tile * kTileCells;
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                fn(cur[j]);
+            }
+            cur += TileSize;
+        }
+    }
+}
+
+template <typename ValueType, int TileSize>
+void Grid<ValueType, TiledLayout<TileSize> >::mapAllColumnMajor(void (*fn)(ValueType value)) const {
+    mapAllColumnMajor<void (*)(ValueType)>(fn);
+}
+
+template <typename ValueType, int TileSize>
+void Grid<ValueType, TiledLayout<TileSize> >::mapAllColumnMajor(void (*fn)(const ValueType& value)) const {
+    mapAllColumnMajor<void (*)(const ValueType&)>(fn);
+}
+
+template <typename ValueType, int TileSize>
+template <typename FunctorType>
+void Grid<ValueType, TiledLayout<TileSize> >::mapAllColumnMajor(FunctorType fn) const {
+    for (int col = 0; col < nCols; col++) {
+        for (int row = 0; row < nRows; row++) {
+            fn(elements[offset(row, col)]);
+        }
+    }
+}
+
+template <typename ValueType, int TileSize>
+int Grid<ValueType, TiledLayout<TileSize> >::numCols() const {
+    return nCols;
+}
+
+template <typename ValueType, int TileSize>
+int Grid<ValueType, TiledLayout<TileSize> >::numRows() const {
+    return nRows;
+}
+
+template <typename ValueType, int TileSize>
+void Grid<ValueType, TiledLayout<TileSize> >::resize(int numRows, int numCols, bool retain) {
+    if (numRows < 0 || numCols < 0) {
+        std::ostringstream out;
+        out << "Grid::resize: Attempt to resize grid to invalid size ("
+               << numRows << ", " << numCols << ")";
+        error(out.str());
+    }
+
+    // optimization: don't do the resize if we are already that size
+    if (numRows == nRows && numCols == nCols && retain) {
+        return;
+    }
+
+    // save backup of old array/size, then make a new array of default values
+    Grid old;
+    std::swap(elements, old.elements);
+    std::swap(nRows, old.nRows);
+    std::swap(nCols, old.nCols);
+    std::swap(tilesPerRow, old.tilesPerRow);
+    std::swap(nTiles, old.nTiles);
+    nRows = numRows;
+    nCols = numCols;
+    tilesPerRow = (numCols + TileSize - 1) / TileSize;
+    nTiles = tilesPerRow * ((numRows + TileSize - 1) / TileSize);
+    elements = new ValueType[nTiles * kTileCells]();
+
+    // possibly retain old contents
+    if (retain) {
+        int minRows = old.nRows < numRows ? old.nRows : numRows;
+        int minCols = old.nCols < numCols ? old.nCols : numCols;
+        for (int row = 0; row < minRows; row++) {
+            for (int col = 0; col < minCols; col++) {
+                elements[offset(row, col)] = old.elements[old.offset(row, col)];
+            }
+        }
+    }
+    m_version++;
+}
+
+template <typename ValueType, int TileSize>
+void Grid<ValueType, TiledLayout<TileSize> >::set(int row, int col, const ValueType& value) {
+    checkIndexes(row, col, nRows - 1, nCols - 1, "set");
+    elements[offset(row, col)] = value;
+    m_version++;
+}
+
+template <typename ValueType, int TileSize>
+void Grid<ValueType, TiledLayout<TileSize> >::set(const GridLocation& loc, const ValueType& value) {
+    set(loc.row, loc.col, value);
+}
+
+template <typename ValueType, int TileSize>
+int Grid<ValueType, TiledLayout<TileSize> >::size() const {
+    return nRows * nCols;
+}
+
+template <typename ValueType, int TileSize>
+std::string Grid<ValueType, TiledLayout<TileSize> >::toString() const {
+    std::ostringstream os;
+    os << *this;
+    return os.str();
+}
+
+template <typename ValueType, int TileSize>
+std::string Grid<ValueType, TiledLayout<TileSize> >::toString2D(
+        std::string rowStart, std::string rowEnd,
+        std::string colSeparator, std::string rowSeparator) const {
+    std::ostringstream os;
+    os << rowStart;
+    for (int i = 0; i < nRows; i++) {
+        if (i > 0) {
+            os << rowSeparator;
+        }
+        os << rowStart;
+        for (int j = 0; j < nCols; j++) {
+            if (j > 0) {
+                os << colSeparator;
+            }
+            writeGenericValue(os, get(i, j), /* forceQuotes */ true);
+        }
+        os << rowEnd;
+    }
+    os << rowEnd;
+    return os.str();
+}
+
+template <typename ValueType, int TileSize>
+unsigned int Grid<ValueType, TiledLayout<TileSize> >::version() const {
+    return m_version;
+}
+
+template <typename ValueType, int TileSize>
+int Grid<ValueType, TiledLayout<TileSize> >::width() const {
+    return nCols;
+}
+
+template <typename ValueType, int TileSize>
+typename Grid<ValueType, TiledLayout<TileSize> >::GridRow
+Grid<ValueType, TiledLayout<TileSize> >::operator [](int row) {
+    return GridRow(this, row);
+}
+
+template <typename ValueType, int TileSize>
+const typename Grid<ValueType, TiledLayout<TileSize> >::GridRowConst
+Grid<ValueType, TiledLayout<TileSize> >::operator [](int row) const {
+    return GridRowConst(this, row);
+}
+
+template <typename ValueType, int TileSize>
+ValueType& Grid<ValueType, TiledLayout<TileSize> >::operator [](const GridLocation& loc) {
+    checkIndexes(loc.row, loc.col, nRows-1, nCols-1, "operator []");
+    m_version++;
+    return elements[offset(loc.row, loc.col)];
+}
+
+template <typename ValueType, int TileSize>
+const ValueType& Grid<ValueType, TiledLayout<TileSize> >::operator [](const GridLocation& loc) const {
+    checkIndexes(loc.row, loc.col, nRows-1, nCols-1, "operator []");
+    return elements[offset(loc.row, loc.col)];
+}
+
+template <typename ValueType, int TileSize>
+bool Grid<ValueType, TiledLayout<TileSize> >::operator ==(const Grid& grid2) const {
+    return equals(grid2);
+}
+
+template <typename ValueType, int TileSize>
+bool Grid<ValueType, TiledLayout<TileSize> >::operator !=(const Grid& grid2) const {
+    return !equals(grid2);
+}
+
+template <typename ValueType, int TileSize>
+bool Grid<ValueType, TiledLayout<TileSize> >::operator <(const Grid& grid2) const {
+    return gridCompare(grid2) < 0;
+}
+
+template <typename ValueType, int TileSize>
+bool Grid<ValueType, TiledLayout<TileSize> >::operator <=(const Grid& grid2) const {
+    return gridCompare(grid2) <= 0;
+}
+
+template <typename ValueType, int TileSize>
+bool Grid<ValueType, TiledLayout<TileSize> >::operator >(const Grid& grid2) const {
+    return gridCompare(grid2) > 0;
+}
+
+template <typename ValueType, int TileSize>
+bool Grid<ValueType, TiledLayout<TileSize> >::operator >=(const Grid& grid2) const {
+    return gridCompare(grid2) >= 0;
+}
+
+template <typename ValueType, int TileSize>
+void Grid<ValueType, TiledLayout<TileSize> >::checkIndexes(int row, int col,
+                                                           int rowMax, int colMax,
+                                                           const char* prefix) const {
+    if (row < 0 || row > rowMax || col < 0 || col > colMax) {
+        std::ostringstream out;
+        out << "Grid::" << prefix << ": (" << row << ", " << col << ")"
+            << " is outside of valid range [";
+        if (0 < rowMax && 0 < colMax) {
+            out << "(0, 0)..(" << rowMax << ", " << colMax << ")";
+        } else if (rowMax == 0 && colMax == 0) {
+            out << "(0, 0)";
+        } // else min > max, no range, empty grid
+        out << "]";
+        error(out.str());
+    }
+}
+
+template <typename ValueType, int TileSize>
+int Grid<ValueType, TiledLayout<TileSize> >::gridCompare(const Grid& grid2) const {
+    int rows = nRows > grid2.nRows ? nRows : grid2.nRows;
+    int cols = nCols > grid2.nCols ? nCols : grid2.nCols;
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            if (r >= nRows) {
+                return -1;
+            } else if (r >= grid2.nRows) {
+                return 1;
+            }
+
+            if (c >= nCols) {
+                return -1;
+            } else if (c >= grid2.nCols) {
+                return 1;
+            }
+
+            if (get(r, c) < grid2.get(r, c)) {
+                return -1;
+            } else if (grid2.get(r, c) < get(r, c)) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * Template hash function for grids.
+ * Requires the element type in the Grid to have a hashCode function.
+ */
+template <typename T, typename Layout>
+int hashCode(const Grid<T, Layout>& g) {
+    return stanfordcpplib::collections::hashCodeCollection(g);
+}
+
+/*
+ * Function: randomElement
+ * Usage: element = randomElement(grid);
+ * -------------------------------------
+ * Returns a randomly chosen element of the given grid.
+ * Throws an error if the grid is empty.
+ */
+template <typename T, typename Layout>
+const T& randomElement(const Grid<T, Layout>& grid) {
+    if (grid.isEmpty()) {
+        error("randomElement: empty grid was passed");
+    }
+
+    int randomIndex = randomInteger(0, grid.size() - 1);
+    int row = randomIndex / grid.numCols();
+    int col = randomIndex % grid.numCols();
+    return grid.get(row, col);
+}
+
+/*
+ * Grids of bool hand out their cells by value, not by reference.
+ */
+inline bool randomElement(const Grid<bool>& grid) {
+    if (grid.isEmpty()) {
+        error("randomElement: empty grid was passed");
+    }
+
+    int randomIndex = randomInteger(0, grid.size() - 1);
+    return grid.get(randomIndex / grid.numCols(), randomIndex % grid.numCols());
 }
 
 /*
  * Randomly rearranges the elements of the given grid.
  */
-template <typename T>
-void shuffle(Grid<T>& grid) {
+template <typename T, typename Layout>
+void shuffle(Grid<T, Layout>& grid) {
     int rows = grid.numRows();
     int cols = grid.numCols();
     int length = rows * cols;
@@ -15,6 +15,11 @@
  *
  * See gridlocation.cpp for the implementation of each member.
  *
+ * @version 2026/10/17
+ * - range iterators no longer check bounds on each step; hot members are inline
+ * - ranges are rectangles: fixed contains and isEmpty for ranges with no columns
+ * - added colMajor, intersect, numCols, numRows, rowMajor, size
+ * - added hashCode64
  * @version 2018/03/12
  * - initial version
  */
@@ -28,6 +33,7 @@
 #ifndef _gridlocation_h
 #define _gridlocation_h
 
+#include <cstdint>
 #include <iostream>
 #include <iterator>
 #include <string>
@@ -69,6 +75,13 @@ public:
  */
 int hashCode(const GridLocation& loc);
 
+/*
+ * Returns a seeded 64-bit hash code for this grid location (see hashcode.h).
+ * The row and column are packed into one word and mixed together, so
+ * neighbouring locations get unrelated hashes.
+ */
+uint64_t hashCode64(const GridLocation& loc);
+
 /*
  * Relational operators for comparing grid locations.
  */
@@ -101,52 +114,59 @@ std::istream& operator >>(std::istream& input, GridLocation& loc);
  * object that you can loop over directly.
  *
  * for (GridLocation loc : grid.locations()) { ... }
+ *
+ * A range is a rectangle: it holds every location whose row is between
+ * its start and end rows and whose column is between its start and end
+ * columns, inclusive.  Ranges can be narrowed with intersect and handed
+ * to parallelForEach (see parallelgrid.h) to be processed on several
+ * threads.
  */
 class GridLocationRange {
 private:
     /*
      * Internal iterator over range of indexes.
+     * The iterator carries its own copy of the bounds it needs, so stepping
+     * it is just an increment and a compare, the same as the inner loop of
+     * a pair of nested for loops.
      */
     class GridLocationRangeIterator : public std::iterator<std::input_iterator_tag, GridLocation> {
     private:
         const GridLocationRange* glr;
         GridLocation loc;
+        int firstMinor;     // first column (row-major) or row (column-major)
+        int lastMinor;      // last column (row-major) or row (column-major)
+        bool rowMajor;
 
     public:
         GridLocationRangeIterator(const GridLocationRange* glr, bool end)
-                : glr(glr) {
-            if (end) {
-                loc.row = glr->endRow() + 1;
-                loc.col = glr->endCol() + 1;
+                : glr(glr),
+                  firstMinor(glr->_isRowMajor ? glr->_start.col : glr->_start.row),
+                  lastMinor(glr->_isRowMajor ? glr->_end.col : glr->_end.row),
+                  rowMajor(glr->_isRowMajor) {
+            if (end || glr->isEmpty()) {
+                // one past the last location in traversal order
+                if (rowMajor) {
+                    loc = GridLocation(glr->_end.row + 1, glr->_start.col);
+                } else {
+                    loc = GridLocation(glr->_start.row, glr->_end.col + 1);
+                }
             } else {
-                loc = glr->startLocation();
+                loc = glr->_start;
             }
         }
 
-        GridLocationRangeIterator(const GridLocationRangeIterator& itr)
-                : glr(itr.glr),
-                  loc(itr.loc) {
-            // empty
-        }
-
         GridLocationRangeIterator& operator ++() {
-            if (glr->isRowMajor()) {
-                loc.col++;
-                if (loc.col > glr->endCol()) {
-                    loc.col = glr->startCol();
+            if (rowMajor) {
+                if (++loc.col > lastMinor) {
+                    loc.col = firstMinor;
                     loc.row++;
                 }
             } else {
-                loc.row++;
-                if (loc.row > glr->endRow()) {
-                    loc.row = glr->startRow();
+                if (++loc.row > lastMinor) {
+                    loc.row = firstMinor;
                     loc.col++;
                 }
             }
-            if (!glr->contains(loc)) {
-                loc.row = glr->endRow() + 1;
-                loc.col = glr->endCol() + 1;
-            }
             return *this;
         }
 
@@ -157,16 +177,14 @@ private:
         }
 
         GridLocationRangeIterator& operator --() {
-            if (glr->isRowMajor()) {
-                loc.col--;
-                if (loc.col < glr->startCol()) {
-                    loc.col = glr->endCol();
+            if (rowMajor) {
+                if (--loc.col < firstMinor) {
+                    loc.col = lastMinor;
                     loc.row--;
                 }
             } else {
-                loc.row--;
-                if (loc.row < glr->startRow()) {
-                    loc.row = glr->endRow();
+                if (--loc.row < firstMinor) {
+                    loc.row = lastMinor;
                     loc.col--;
                 }
             }
@@ -180,39 +198,44 @@ private:
         }
 
         bool operator ==(const GridLocationRangeIterator& rhs) const {
-            return loc == rhs.loc;
+            // written without && so that GCC keeps both coordinates in
+            // registers instead of comparing them as one word in memory
+            return ((loc.row ^ rhs.loc.row) | (loc.col ^ rhs.loc.col)) == 0;
         }
 
         bool operator !=(const GridLocationRangeIterator& rhs) const {
             return !(*this == rhs);
         }
 
+        /*
+         * Iterators compare by their position in the traversal order.
+         */
         bool operator <(const GridLocationRangeIterator& rhs) const {
             if (glr != rhs.glr) {
                 error("GridLocationRange Iterator::operator <: Iterators are in different ranges");
             }
-            return loc < rhs.loc;
+            return precedes(rhs);
         }
 
         bool operator <=(const GridLocationRangeIterator& rhs) const {
             if (glr != rhs.glr) {
                 error("GridLocationRange Iterator::operator <=: Iterators are in different ranges");
             }
-            return loc <= rhs.loc;
+            return !rhs.precedes(*this);
         }
 
         bool operator >(const GridLocationRangeIterator& rhs) const {
             if (glr != rhs.glr) {
                 error("GridLocationRange Iterator::operator >: Iterators are in different ranges");
             }
-            return loc > rhs.loc;
+            return rhs.precedes(*this);
         }
 
         bool operator >=(const GridLocationRangeIterator& rhs) const {
             if (glr != rhs.glr) {
                 error("GridLocationRange Iterator::operator >=: Iterators are in different ranges");
             }
-            return loc >= rhs.loc;
+            return !precedes(rhs);
         }
 
         const GridLocation& operator *() const {
@@ -222,6 +245,11 @@ private:
         const GridLocation* operator ->() const {
             return &loc;
         }
+
+    private:
+        bool precedes(const GridLocationRangeIterator& rhs) const {
+            return rowMajor ? loc < rhs.loc : GridLocation(loc.col, loc.row) < GridLocation(rhs.loc.col, rhs.loc.row);
+        }
     };
 
     GridLocation _start;
@@ -249,7 +277,12 @@ public:
     GridLocationRangeIterator begin() const;
 
     /*
-     * Returns true if this range entirely contains the given other range.
+     * Returns a copy of this range that is traversed in column-major order.
+     */
+    GridLocationRange colMajor() const;
+
+    /*
+     * Returns true if the given location lies inside this range.
      */
     bool contains(const GridLocation& loc) const;
 
@@ -273,6 +306,13 @@ public:
      */
     int endRow() const;
 
+    /*
+     * Returns the locations that lie in both this range and the given one,
+     * traversed in this range's order.  The result may be empty.
+     * Usage: for (GridLocation loc : grid.locations().intersect(window)) ...
+     */
+    GridLocationRange intersect(const GridLocationRange& other) const;
+
     /*
      * Returns true if this range contains no rows or columns.
      */
@@ -284,6 +324,26 @@ public:
      */
     bool isRowMajor() const;
 
+    /*
+     * Returns the number of columns in this range, or 0 if it is empty.
+     */
+    int numCols() const;
+
+    /*
+     * Returns the number of rows in this range, or 0 if it is empty.
+     */
+    int numRows() const;
+
+    /*
+     * Returns a copy of this range that is traversed in row-major order.
+     */
+    GridLocationRange rowMajor() const;
+
+    /*
+     * Returns the number of locations in this range.
+     */
+    int size() const;
+
     /*
      * Returns the first column in this range.
      */
@@ -306,6 +366,45 @@ public:
     std::string toString() const;
 };
 
+/*
+ * Implementation notes: inline members
+ * ------------------------------------
+ * The members used by every range-based for loop are defined here rather
+ * than in gridlocation.cpp so that the compiler can see through them and
+ * reduce such a loop to plain index arithmetic.
+ */
+inline GridLocation::GridLocation(int row, int col)
+        : row(row),
+          col(col) {
+    // empty
+}
+
+inline GridLocationRange::GridLocationRange(int startRow, int startCol, int endRow, int endCol, bool isRowMajor)
+        : _start(startRow, startCol),
+          _end(endRow, endCol),
+          _isRowMajor(isRowMajor) {
+    // empty
+}
+
+inline GridLocationRange::GridLocationRange(const GridLocation& startLoc, const GridLocation& endLoc, bool isRowMajor)
+        : _start(startLoc),
+          _end(endLoc),
+          _isRowMajor(isRowMajor) {
+    // empty
+}
+
+inline GridLocationRange::GridLocationRangeIterator GridLocationRange::begin() const {
+    return GridLocationRangeIterator(this, /* end */ false);
+}
+
+inline GridLocationRange::GridLocationRangeIterator GridLocationRange::end() const {
+    return GridLocationRangeIterator(this, /* end */ true);
+}
+
+inline bool GridLocationRange::isEmpty() const {
+    return _start.row > _end.row || _start.col > _end.col;
+}
+
 /*
  * I/O stream operators for writing location ranges in their toString format.
  */
@@ -5,6 +5,11 @@
  * These functions are used by the HashMap and HashSet collections, as well as
  * by other collections that wish to be used as elements within HashMaps/Sets.
  *
+ * @version 2026/10/17
+ * - added seeded 64-bit hashCode64 functions, hashMix64 and hashCombine,
+ *   used by HashMap and HashSet
+ * - added hash codes for long long and unsigned long long; long and pointer
+ *   hash codes now fold in their high bits
  * @version 2017/10/21
  * - added hash codes for short, unsigned integers
  * @version 2017/09/29
@@ -23,6 +28,8 @@
 #ifndef _hashcode_h
 #define _hashcode_h
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <utility>
 
@@ -43,6 +50,8 @@ int hashCode(int key);
 int hashCode(unsigned int key);
 int hashCode(long key);
 int hashCode(unsigned long key);
+int hashCode(long long key);
+int hashCode(unsigned long long key);
 int hashCode(short key);
 int hashCode(unsigned short key);
 int hashCode(const char* str);
@@ -78,4 +87,101 @@ int hashCode(T1&& first, T2&& second, Others&&... remaining) {
     return hashCode(result);
 }
 
+/*
+ * Function: hashSeed64
+ * Usage: uint64_t seed = hashSeed64();
+ * ------------------------------------
+ * Returns the seed mixed into every 64-bit hash.  It is chosen at random
+ * once per run of the program, so the order in which a HashMap or HashSet
+ * iterates may differ from one run to the next.  Set the environment
+ * variable SPL_HASH_SEED to a number to fix the seed, for example to make
+ * a failing run repeatable.
+ */
+uint64_t hashSeed64();
+
+/*
+ * Function: hashMix64
+ * Usage: uint64_t hash = hashMix64(value);
+ * ----------------------------------------
+ * Scrambles the bits of a 64-bit value so that every input bit affects
+ * every output bit (the MurmurHash3 finalizer).  Inputs that differ in
+ * only a few bits, such as consecutive integers, give unrelated results.
+ */
+inline uint64_t hashMix64(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+/*
+ * Function: hashCombine
+ * Usage: hash = hashCombine(hash, hashCode64(field));
+ * ---------------------------------------------------
+ * Folds the hash of one more component into a running hash, for building
+ * the hash of a composite key out of the hashes of its fields.  The order
+ * of the components matters, so (1, 2) and (2, 1) hash differently.
+ */
+inline uint64_t hashCombine(uint64_t hash, uint64_t value) {
+    return hashMix64(hash ^ (value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2)));
+}
+
+/*
+ * Function: hashCode64
+ * Usage: uint64_t hash = hashCode64(key);
+ * ---------------------------------------
+ * Returns a well-mixed, seeded 64-bit hash of the specified key.  Unlike
+ * hashCode, these results use all 64 bits and change completely when any
+ * part of the key changes, so strided or sequential keys spread evenly
+ * over a hash table.  This function is overloaded for the primitive types
+ * and strings; other types get a mixed version of their hashCode (see
+ * below) unless they provide a hashCode64 of their own.
+ */
+uint64_t hashCode64(bool key);
+uint64_t hashCode64(char key);
+uint64_t hashCode64(double key);
+uint64_t hashCode64(float key);
+uint64_t hashCode64(long double key);
+uint64_t hashCode64(int key);
+uint64_t hashCode64(unsigned int key);
+uint64_t hashCode64(long key);
+uint64_t hashCode64(unsigned long key);
+uint64_t hashCode64(long long key);
+uint64_t hashCode64(unsigned long long key);
+uint64_t hashCode64(short key);
+uint64_t hashCode64(unsigned short key);
+uint64_t hashCode64(const char* str);
+uint64_t hashCode64(char* str);
+uint64_t hashCode64(const std::string& str);
+uint64_t hashCode64(void* key);
+
+/*
+ * Hashes the given bytes with a seeded 64-bit string hash (in the style of
+ * wyhash, reading 16 bytes per step).  Used by the string overloads above
+ * and available to types that can be hashed as raw bytes.
+ */
+uint64_t hashBytes64(const void* data, size_t numBytes);
+
+/*
+ * Fallback for types that only define the classic int hashCode, such as
+ * client-defined classes: mixes that code with the seed so it can still
+ * be used with the 64-bit hash tables.
+ */
+template <typename T>
+uint64_t hashCode64(const T& key) {
+    return hashMix64(static_cast<uint64_t>(static_cast<unsigned int>(hashCode(key))) ^ hashSeed64());
+}
+
+/*
+ * Computes a 64-bit hash for a list of multiple values with hashCombine.
+ * The type of each value passed must have a suitable hashCode64() or
+ * hashCode() function.
+ */
+template <typename T1, typename T2, typename... Others>
+uint64_t hashCode64(const T1& first, const T2& second, const Others&... remaining) {
+    return hashCombine(hashCode64(first), hashCode64(second, remaining...));
+}
+
 #endif // _hashcode_h
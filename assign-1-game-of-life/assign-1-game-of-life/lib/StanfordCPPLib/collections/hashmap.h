@@ -4,6 +4,13 @@
  * This file exports the <code>HashMap</code> class, which stores
  * a set of <i>key</i>-<i>value</i> pairs.
  * 
+ * @version 2026/10/17
+ * - reimplemented as an open-addressing table with Robin Hood probing,
+ *   storing entries inline instead of in one heap Cell per entry
+ * - keys are hashed with the seeded 64-bit hashCode64
+ * - added capacity constructor, reserve and insertAll for bulk loading
+ * - maps with string keys can be searched by C string or StringView
+ *   without creating a string
  * @version 2018/03/10
  * - added methods front, back
  * @version 2017/11/30
@@ -46,9 +53,13 @@
 #ifndef _hashmap_h
 #define _hashmap_h
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 #include <initializer_list>
+#include <iterator>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 #define INTERNAL_INCLUDE 1
@@ -58,6 +69,8 @@
 #define INTERNAL_INCLUDE 1
 #include "hashcode.h"
 #define INTERNAL_INCLUDE 1
+#include "stringview.h"
+#define INTERNAL_INCLUDE 1
 #include "vector.h"
 #undef INTERNAL_INCLUDE
 
@@ -90,10 +103,28 @@ public:
      *
      * that returns a positive integer determined by the key.  This interface
      * exports <code>hashCode</code> functions for <code>string</code> and
-     * the C++ primitive types.
+     * the C++ primitive types.  The map actually hashes keys with
+     * <code>hashCode64</code> (see hashcode.h), which mixes the result of
+     * <code>hashCode</code>; a key type may define
+     * <code>uint64_t hashCode64(KeyType key)</code> itself to be hashed
+     * directly.
+     *
+     * Both the key type and the value type must have a default constructor
+     * and be assignable.  The entries are stored directly in the slots of
+     * the table, and the empty slots hold default-constructed keys and
+     * values.
      */
     HashMap();
 
+    /*
+     * Constructor: HashMap
+     * Usage: HashMap<KeyType,ValueType> map(capacity);
+     * ------------------------------------------------
+     * Initializes a new empty map with room for at least the given number
+     * of entries, so that filling it up to that size never grows the table.
+     */
+    explicit HashMap(int capacity);
+
     /*
      * Constructor: HashMap
      * Usage: HashMap<ValueType> map {{"a", 1}, {"b", 2}, {"c", 3}};
@@ -162,9 +193,15 @@ public:
      * ------------------------------------
      * Returns <code>true</code> if there is an entry for <code>key</code>
      * in this map.
+     * If the keys are strings, <code>key</code> may also be a C string or a
+     * <code>StringView</code>, which is looked up without creating a string.
      */
     bool containsKey(const KeyType& key) const;
 
+    template <typename K>
+    typename std::enable_if<stanfordcpplib::collections::IsStringViewLookup<KeyType, K>::value, bool>::type
+    containsKey(const K& key) const;
+
     /*
      * Method: equals
      * Usage: if (map.equals(map2)) ...
@@ -195,9 +232,37 @@ public:
      * Returns the value associated with <code>key</code> in this map.
      * If <code>key</code> is not found, <code>get</code> returns the
      * default value for <code>ValueType</code>.
+     * As with containsKey, string keys may be looked up by a C string or a
+     * <code>StringView</code> without creating a string.
      */
     ValueType get(const KeyType& key) const;
 
+    template <typename K>
+    typename std::enable_if<stanfordcpplib::collections::IsStringViewLookup<KeyType, K>::value, ValueType>::type
+    get(const K& key) const;
+
+    /*
+     * Method: insertAll
+     * Usage: map.insertAll(first, last);
+     *        map.insertAll(pairs);
+     * ----------------------------------
+     * Puts every key/value pair in the range [first, last), or in the given
+     * collection of pairs, into this map, as if by calling put for each one
+     * in turn.  The elements may be std::pairs or anything else with
+     * <code>first</code> and <code>second</code> members, such as the
+     * entries of an STL map.  When the size of the collection, or of a
+     * range of forward iterators, is known in advance, the table is sized
+     * once for it before anything is inserted; the iterators of the
+     * Stanford collections are input iterators, so pass such a collection
+     * itself rather than its begin and end.  Returns a reference to this
+     * map.
+     */
+    template <typename IteratorType>
+    HashMap& insertAll(IteratorType first, IteratorType last);
+
+    template <typename CollectionType>
+    HashMap& insertAll(const CollectionType& pairs);
+
     /*
      * Method: isEmpty
      * Usage: if (map.isEmpty()) ...
@@ -274,6 +339,16 @@ public:
     HashMap& removeAll(const HashMap& map2);
     HashMap& removeAll(std::initializer_list<std::pair<KeyType, ValueType> > list);
 
+    /*
+     * Method: reserve
+     * Usage: map.reserve(n);
+     * ----------------------
+     * Makes room for at least <code>n</code> entries in total, so that the
+     * map can grow to that size without rehashing along the way.  Never
+     * shrinks the table.
+     */
+    void reserve(int n);
+
     /*
      * Method: retainAll
      * Usage: map.retainAll(map2);
@@ -434,139 +509,230 @@ public:
     /*
      * Implementation notes:
      * ---------------------
-     * The HashMap class is represented using a hash table that uses
-     * bucket chaining to resolve collisions.
-    */
+     * The HashMap class is represented using an open-addressing hash table
+     * with Robin Hood probing.  See the notes above the member definitions
+     * below for details.
+     */
 private:
     /* Constant definitions */
-    static const int INITIAL_BUCKET_COUNT = 101;
-    static const int MAX_LOAD_PERCENTAGE = 70;
+    static const int INITIAL_CAPACITY = 16;     // must be a power of two
+    static const int MAX_CAPACITY = 1 << 30;    // largest power of two in an int
+    static const int MAX_LOAD_PERCENTAGE = 80;
 
-    /* Type definition for cells in the bucket chain */
-    struct Cell {
+    /* Type definition for the slots of the table */
+    struct Slot {
         KeyType key;
         ValueType value;
-        Cell* next;
     };
 
     /* Instance variables */
-    Vector<Cell*> buckets;
-    int nBuckets;
-    int numEntries;
+    Slot* slots = nullptr;       // the table; slot i is in use iff hashes[i] != 0
+    uint32_t* hashes = nullptr;  // cached (nonzero) hash of the key in each slot
+    int nSlots = 0;              // capacity of the table, 0 or a power of two
+    int slotBits = 0;            // log2(nSlots)
+    int numEntries = 0;
     unsigned int m_version = 0; // structure version for detecting invalid iterators
 
     /* Private methods */
 
     /*
-     * Private method: createBuckets
-     * Usage: createBuckets(nBuckets);
-     * -------------------------------
-     * Sets up the vector of buckets to have nBuckets entries, each null.
-     * If asked to make empty vector, makes one bucket just to simplify
-     * handling elsewhere.
+     * Returns the smallest table size that holds the given number of
+     * entries without exceeding the maximum load.
      */
-    void createBuckets(int nBuckets) {
-        if (nBuckets == 0) {
-            nBuckets = 1;
+    static int capacityFor(int count) {
+        int capacity = INITIAL_CAPACITY;
+        while ((int64_t) capacity * MAX_LOAD_PERCENTAGE / 100 < count) {
+            capacity *= 2;
         }
-        buckets = Vector<Cell*>(nBuckets, nullptr);
-        this->nBuckets = nBuckets;
-        numEntries = 0;
+        return capacity;
+    }
+
+    /*
+     * Private method: hashOf
+     * Usage: uint32_t h = hashOf(key);
+     * --------------------------------
+     * Returns the value cached in hashes[] for the given key: the top half
+     * of its seeded 64-bit hash (see hashCode64 in hashcode.h).  Zero is
+     * reserved to mark empty slots.  The key may also be a StringView
+     * standing in for a string key, which hashes the same way.
+     */
+    template <typename K>
+    static uint32_t hashOf(const K& key) {
+        uint32_t h = static_cast<uint32_t>(hashCode64(key) >> 32);
+        return h == 0 ? 1 : h;
+    }
+
+    /*
+     * Returns the slot where a key with the given cached hash would ideally
+     * be stored, which is the top slotBits bits of the hash.
+     */
+    int homeSlot(uint32_t h) const {
+        return static_cast<int>(h >> (32 - slotBits));
     }
 
     /*
-     * Private method: deleteBuckets
-     * Usage: deleteBuckets(buckets);
-     * ------------------------------
-     * Deletes all the cells in the linked lists contained in vector.
+     * Returns how far the entry in the given slot is from its home slot.
      */
-    void deleteBuckets(Vector<Cell*>& buckets) {
-        for (int i = 0; i < buckets.size(); i++) {
-            Cell* cp = buckets[i];
-            while (cp) {
-                Cell* np = cp->next;
-                delete cp;
-                cp = np;
+    int probeDistance(uint32_t h, int slot) const {
+        return (slot - homeSlot(h)) & (nSlots - 1);
+    }
+
+    /*
+     * Private method: findSlot
+     * Usage: int slot = findSlot(key);
+     * --------------------------------
+     * Returns the slot that holds the given key, or -1 if it is not in the
+     * map.  Entries on a probe path are ordered by distance from home, so
+     * the search stops at the first entry closer to home than the key
+     * would be.  As with hashOf, the key may be a StringView.
+     */
+    template <typename K>
+    int findSlot(const K& key) const {
+        if (numEntries == 0) {
+            return -1;
+        }
+        uint32_t h = hashOf(key);
+        int mask = nSlots - 1;
+        int slot = homeSlot(h);
+        for (int dist = 0; ; dist++) {
+            uint32_t stored = hashes[slot];
+            if (stored == 0 || probeDistance(stored, slot) < dist) {
+                return -1;
             }
-            buckets[i] = nullptr;
+            if (stored == h && slots[slot].key == key) {
+                return slot;
+            }
+            slot = (slot + 1) & mask;
         }
     }
 
     /*
-     * Private method: expandAndRehash
-     * Usage: expandAndRehash();
-     * -------------------------
-     * This method is used to increase the number of buckets in the map
-     * and then rehashes all existing entries and adds them into new buckets.
-     * This operation is used when the load factor (i.e. the number of cells
-     * per bucket) has increased enough to warrant this O(N) operation to
-     * enlarge and redistribute the entries.
+     * Private method: insertSlot
+     * Usage: int slot = insertSlot(h, key, value);
+     * --------------------------------------------
+     * Stores a key that is known not to be in the map, growing the table
+     * first if it is full enough, and returns the slot where it ended up.
+     * The key and value are taken by value so that they may safely refer
+     * to entries of this map that get moved along the way.
      */
-    void expandAndRehash() {
-        Vector<Cell*> oldBuckets = buckets;
-        createBuckets(oldBuckets.size() * 2 + 1);
-        for (int i = 0; i < oldBuckets.size(); i++) {
-            for (Cell* cp = oldBuckets[i]; cp != nullptr; cp = cp->next) {
-                put(cp->key, cp->value);
+    int insertSlot(uint32_t h, KeyType key, ValueType value) {
+        if (numEntries >= (int64_t) nSlots * MAX_LOAD_PERCENTAGE / 100) {
+            if (nSlots == MAX_CAPACITY) {
+                error("HashMap::put: map is too large");
             }
+            rehash(nSlots == 0 ? INITIAL_CAPACITY : nSlots * 2);
         }
-        deleteBuckets(oldBuckets);
+        int slot = placeSlot(h, key, value);
+        numEntries++;
+        m_version++;
+        return slot;
     }
 
     /*
-     * Private method: findCell
-     * Usage: Cell* cp = findCell(bucket, key);
-     *        Cell* cp = findCell(bucket, key, parent);
-     * ------------------------------------------------
-     * Finds a cell in the chain for the specified bucket that matches key.
-     * If a match is found, the return value is a pointer to the cell containing
-     * the matching key.  If no match is found, the function returns nullptr.
-     * If the optional third argument is supplied, it is filled in with the
-     * cell preceding the matching cell to allow the client to splice out
-     * the target cell in the delete call.  If parent is null, it indicates
-     * that the cell is the first cell in the bucket chain.
+     * Puts an entry into the table, displacing any entry that is closer to
+     * its home slot than this one (the Robin Hood rule) and carrying the
+     * displaced entry forward in turn.  Returns the slot of the original
+     * entry.  Does not check the load or update numEntries.
      */
-    Cell* findCell(int bucket, const KeyType& key) const {
-        Cell *dummy;
-        return findCell(bucket, key, dummy);
+    int placeSlot(uint32_t h, KeyType& key, ValueType& value) {
+        int mask = nSlots - 1;
+        int slot = homeSlot(h);
+        int result = -1;
+        for (int dist = 0; ; dist++) {
+            uint32_t stored = hashes[slot];
+            if (stored == 0) {
+                hashes[slot] = h;
+                slots[slot].key = std::move(key);
+                slots[slot].value = std::move(value);
+                return result < 0 ? slot : result;
+            }
+            int storedDist = probeDistance(stored, slot);
+            if (storedDist < dist) {
+                std::swap(h, hashes[slot]);
+                std::swap(key, slots[slot].key);
+                std::swap(value, slots[slot].value);
+                if (result < 0) {
+                    result = slot;
+                }
+                dist = storedDist;
+            }
+            slot = (slot + 1) & mask;
+        }
     }
 
-    Cell* findCell(int bucket, const KeyType& key, Cell*& parent) const {
-        parent = nullptr;
-        Cell* cp = buckets.get(bucket);
-        while (cp && !(key == cp->key)) {
-            parent = cp;
-            cp = cp->next;
+    /*
+     * Private method: removeSlot
+     * Usage: removeSlot(slot);
+     * ------------------------
+     * Empties the given slot and shifts the entries after it back by one
+     * until reaching an empty slot or an entry already at home, so that no
+     * tombstones are needed.
+     */
+    void removeSlot(int slot) {
+        int mask = nSlots - 1;
+        int next = (slot + 1) & mask;
+        while (hashes[next] != 0 && probeDistance(hashes[next], next) > 0) {
+            hashes[slot] = hashes[next];
+            slots[slot].key = std::move(slots[next].key);
+            slots[slot].value = std::move(slots[next].value);
+            slot = next;
+            next = (next + 1) & mask;
         }
-        return cp;
+        hashes[slot] = 0;
+        slots[slot].key = KeyType();
+        slots[slot].value = ValueType();
+        numEntries--;
+        m_version++;
+    }
+
+    /*
+     * Private method: rehash
+     * Usage: rehash(capacity);
+     * ------------------------
+     * Moves every entry into a new table with the given number of slots,
+     * which must be a power of two.  The cached hashes are reused, so the
+     * keys' hashCode functions are not called again.
+     */
+    void rehash(int capacity) {
+        Slot* oldSlots = slots;
+        uint32_t* oldHashes = hashes;
+        int oldCount = nSlots;
+        slots = new Slot[capacity];
+        hashes = new uint32_t[capacity]();
+        nSlots = capacity;
+        slotBits = 0;
+        while ((1 << slotBits) < capacity) {
+            slotBits++;
+        }
+        for (int i = 0; i < oldCount; i++) {
+            if (oldHashes[i] != 0) {
+                placeSlot(oldHashes[i], oldSlots[i].key, oldSlots[i].value);
+            }
+        }
+        delete[] oldSlots;
+        delete[] oldHashes;
     }
 
     void deepCopy(const HashMap& src) {
-        createBuckets(src.nBuckets);
-        for (int i = 0; i < src.nBuckets; i++) {
-            // BUGFIX: was just calling put(), which reversed the chains;
-            // now deep-copy the chains exactly as they were to preserve hashcode
-            Cell* endOfChain = nullptr;
-            for (Cell* cp = src.buckets.get(i); cp != nullptr; cp = cp->next) {
-                // put(cp->key, cp->value);
-                
-                // copy the cell and put at end of bucket list
-                Cell* copy = new Cell();
-                copy->key = cp->key;
-                copy->value = cp->value;
-                copy->next = nullptr;
-                if (!endOfChain) {
-                    // first node in bucket
-                    buckets.set(i, copy);
-                } else {
-                    // not first node; put after existing node
-                    endOfChain->next = copy;
-                    endOfChain = copy;
+        // copy the table slot for slot so that the copy iterates in the
+        // same order (and so has the same hash code) as the original
+        delete[] slots;
+        delete[] hashes;
+        slots = nullptr;
+        hashes = nullptr;
+        if (src.nSlots > 0) {
+            slots = new Slot[src.nSlots];
+            hashes = new uint32_t[src.nSlots];
+            for (int i = 0; i < src.nSlots; i++) {
+                hashes[i] = src.hashes[i];
+                if (src.hashes[i] != 0) {
+                    slots[i] = src.slots[i];
                 }
-                endOfChain = copy;
-                numEntries++;
             }
         }
+        nSlots = src.nSlots;
+        slotBits = src.slotBits;
+        numEntries = src.numEntries;
         m_version++;
     }
 
@@ -589,7 +755,6 @@ public:
      */
     HashMap& operator =(const HashMap& src) {
         if (this != &src) {
-            clear();
             deepCopy(src);
         }
         return *this;
@@ -609,52 +774,45 @@ public:
     class iterator : public std::iterator<std::input_iterator_tag, KeyType> {
     private:
         const HashMap* mp;           /* Pointer to the map           */
-        int bucket;                  /* Index of current bucket      */
+        int slot;                    /* Index of current slot        */
         unsigned int itr_version;    /* Version for checking for modification */
-        Cell* cp;                    /* Current cell in bucket chain */
 
     public:
         iterator()
                 : mp(nullptr),
-                  bucket(0),
-                  itr_version(0),
-                  cp(nullptr) {
+                  slot(0),
+                  itr_version(0) {
             // empty
         }
 
         iterator(const HashMap* mp, bool end)
                 : mp(mp),
-                  bucket(0),
-                  itr_version(0),
-                  cp(nullptr) {
+                  slot(0),
+                  itr_version(0) {
             if (mp) {
                 itr_version = mp->version();
             }
             if (end) {
-                bucket = mp->nBuckets;
+                slot = mp->nSlots;
             } else {
-                bucket = 0;
-                cp = mp->buckets.get(bucket);
-                while (!cp && ++bucket < mp->nBuckets) {
-                    cp = mp->buckets.get(bucket);
+                while (slot < mp->nSlots && mp->hashes[slot] == 0) {
+                    slot++;
                 }
             }
         }
 
         iterator(const iterator& it)
                 : mp(it.mp),
-                  bucket(it.bucket),
-                  itr_version(it.itr_version),
-                  cp(it.cp) {
+                  slot(it.slot),
+                  itr_version(it.itr_version) {
             // empty
         }
 
         iterator& operator ++() {
             stanfordcpplib::collections::checkVersion(*mp, *this);
-            cp = cp->next;
-            while (!cp && ++bucket < mp->nBuckets) {
-                cp = mp->buckets.get(bucket);
-            }
+            do {
+                slot++;
+            } while (slot < mp->nSlots && mp->hashes[slot] == 0);
             return *this;
         }
 
@@ -666,7 +824,7 @@ public:
         }
 
         bool operator ==(const iterator& rhs) {
-            return mp == rhs.mp && bucket == rhs.bucket && cp == rhs.cp;
+            return mp == rhs.mp && slot == rhs.slot;
         }
 
         bool operator !=(const iterator& rhs) {
@@ -675,12 +833,12 @@ public:
 
         KeyType& operator *() {
             stanfordcpplib::collections::checkVersion(*mp, *this);
-            return cp->key;
+            return mp->slots[slot].key;
         }
 
         KeyType* operator ->() {
             stanfordcpplib::collections::checkVersion(*mp, *this);
-            return &cp->key;
+            return &mp->slots[slot].key;
         }
 
         unsigned int version() const {
@@ -716,29 +874,46 @@ public:
 /*
  * Implementation notes: HashMap class
  * -----------------------------------
- * In this map implementation, the entries are stored in a hashtable.
- * The hashtable keeps a vector of "buckets", where each bucket is a
- * linked list of elements that share the same hash code (i.e. hash
- * collisions are resolved by chaining). The buckets are dynamically
- * allocated so that we can change the the number of buckets (rehash)
- * when the load factor becomes too high. The map should provide O(1)
- * performance on the put/remove/get operations.
+ * In this map implementation, the entries are stored directly in a single
+ * array of slots whose size is a power of two (open addressing), so an
+ * insertion does not allocate anything unless the table has to grow.
+ * A key's home slot is taken from the top bits of its 64-bit hash code;
+ * if that slot is taken, the key goes in one of the slots after it.
+ *
+ * Collisions are resolved with Robin Hood probing: while inserting, an
+ * entry that is farther from its home slot than the entry occupying a slot
+ * takes that slot, and the displaced entry moves on.  This keeps every
+ * probe sequence short and ordered by distance from home, so a lookup for
+ * a missing key can stop early.  Removal shifts the following entries
+ * back rather than leaving tombstones.  Each slot also caches its key's
+ * hash, so most mismatches are rejected without calling ==, and growing
+ * the table never recomputes hash codes.
+ *
+ * The table doubles when it is 80% full, starting from 16 slots on the
+ * first insertion; reserve, the capacity constructor and the bulk insert
+ * methods size it once up front instead.  As with most open-addressing tables, an insertion may
+ * move other entries, so references returned by operator [] remain valid
+ * only until the next insertion or removal.
  */
 template <typename KeyType, typename ValueType>
 HashMap<KeyType, ValueType>::HashMap() {
-    createBuckets(INITIAL_BUCKET_COUNT);
+    // empty; the table is allocated on the first insertion
+}
+
+template <typename KeyType, typename ValueType>
+HashMap<KeyType, ValueType>::HashMap(int capacity) {
+    reserve(capacity);
 }
 
 template <typename KeyType, typename ValueType>
 HashMap<KeyType, ValueType>::HashMap(std::initializer_list<std::pair<KeyType, ValueType> > list) {
-    createBuckets(INITIAL_BUCKET_COUNT);
     putAll(list);
 }
 
 template <typename KeyType, typename ValueType>
 HashMap<KeyType, ValueType>::~HashMap() {
-    deleteBuckets(buckets);
-    numEntries = 0;
+    delete[] slots;
+    delete[] hashes;
 }
 
 template <typename KeyType, typename ValueType>
@@ -763,34 +938,37 @@ KeyType HashMap<KeyType, ValueType>::back() const {
         error("HashMap::back: map is empty");
     }
 
-    // find last non-null bucket
-    Cell* cell = nullptr;
-    for (int i = buckets.size() - 1; i >= 0; i--) {
-        cell = buckets[i];
-        if (cell) {
-            // find last non-null cell within bucket
-            while (cell->next) {
-                cell = cell->next;
-            }
-            return cell->key;
-        }
+    // find last occupied slot
+    int slot = nSlots - 1;
+    while (hashes[slot] == 0) {
+        slot--;
     }
-
-    // we should never get here
-    error("HashMap::back: never found a non-empty cell bucket");
-    return cell->key;
+    return slots[slot].key;
 }
 
 template <typename KeyType, typename ValueType>
 void HashMap<KeyType, ValueType>::clear() {
-    deleteBuckets(buckets);
+    for (int i = 0; i < nSlots; i++) {
+        if (hashes[i] != 0) {
+            hashes[i] = 0;
+            slots[i].key = KeyType();
+            slots[i].value = ValueType();
+        }
+    }
     numEntries = 0;
     m_version++;
 }
 
 template <typename KeyType, typename ValueType>
 bool HashMap<KeyType, ValueType>::containsKey(const KeyType& key) const {
-    return findCell(hashCode(key) % nBuckets, key) != nullptr;
+    return findSlot(key) >= 0;
+}
+
+template <typename KeyType, typename ValueType>
+template <typename K>
+typename std::enable_if<stanfordcpplib::collections::IsStringViewLookup<KeyType, K>::value, bool>::type
+HashMap<KeyType, ValueType>::containsKey(const K& key) const {
+    return findSlot(StringView(key)) >= 0;
 }
 
 template <typename KeyType, typename ValueType>
@@ -808,11 +986,46 @@ KeyType HashMap<KeyType, ValueType>::front() const {
 
 template <typename KeyType, typename ValueType>
 ValueType HashMap<KeyType, ValueType>::get(const KeyType& key) const {
-    Cell* cp = findCell(hashCode(key) % nBuckets, key);
-    if (!cp) {
+    int slot = findSlot(key);
+    if (slot < 0) {
         return ValueType();
     }
-    return cp->value;
+    return slots[slot].value;
+}
+
+template <typename KeyType, typename ValueType>
+template <typename K>
+typename std::enable_if<stanfordcpplib::collections::IsStringViewLookup<KeyType, K>::value, ValueType>::type
+HashMap<KeyType, ValueType>::get(const K& key) const {
+    int slot = findSlot(StringView(key));
+    if (slot < 0) {
+        return ValueType();
+    }
+    return slots[slot].value;
+}
+
+template <typename KeyType, typename ValueType>
+template <typename IteratorType>
+HashMap<KeyType, ValueType>& HashMap<KeyType, ValueType>::insertAll(IteratorType first,
+                                                                    IteratorType last) {
+    typedef typename std::iterator_traits<IteratorType>::iterator_category Category;
+    if (std::is_base_of<std::forward_iterator_tag, Category>::value) {
+        reserve(std::max(numEntries, (int) std::distance(first, last)));
+    }
+    for (; first != last; ++first) {
+        put((*first).first, (*first).second);
+    }
+    return *this;
+}
+
+template <typename KeyType, typename ValueType>
+template <typename CollectionType>
+HashMap<KeyType, ValueType>& HashMap<KeyType, ValueType>::insertAll(const CollectionType& pairs) {
+    reserve(std::max(numEntries, stanfordcpplib::collections::sizeHint(pairs)));
+    for (const auto& pair : pairs) {
+        put(pair.first, pair.second);
+    }
+    return *this;
 }
 
 template <typename KeyType, typename ValueType>
@@ -831,9 +1044,9 @@ Vector<KeyType> HashMap<KeyType, ValueType>::keys() const {
 
 template <typename KeyType, typename ValueType>
 void HashMap<KeyType, ValueType>::mapAll(void (*fn)(KeyType, ValueType)) const {
-    for (int i = 0; i < buckets.size(); i++) {
-        for (Cell* cp = buckets.get(i); cp != nullptr; cp = cp->next) {
-            fn(cp->key, cp->value);
+    for (int i = 0; i < nSlots; i++) {
+        if (hashes[i] != 0) {
+            fn(slots[i].key, slots[i].value);
         }
     }
 }
@@ -841,9 +1054,9 @@ void HashMap<KeyType, ValueType>::mapAll(void (*fn)(KeyType, ValueType)) const {
 template <typename KeyType, typename ValueType>
 void HashMap<KeyType, ValueType>::mapAll(void (*fn)(const KeyType&,
                                                    const ValueType&)) const {
-    for (int i = 0; i < buckets.size(); i++) {
-        for (Cell* cp = buckets.get(i); cp != nullptr; cp = cp->next) {
-            fn(cp->key, cp->value);
+    for (int i = 0; i < nSlots; i++) {
+        if (hashes[i] != 0) {
+            fn(slots[i].key, slots[i].value);
         }
     }
 }
@@ -851,23 +1064,36 @@ void HashMap<KeyType, ValueType>::mapAll(void (*fn)(const KeyType&,
 template <typename KeyType, typename ValueType>
 template <typename FunctorType>
 void HashMap<KeyType, ValueType>::mapAll(FunctorType fn) const {
-    for (int i = 0; i < buckets.size(); i++) {
-        for (Cell* cp = buckets.get(i); cp != nullptr; cp = cp->next) {
-            fn(cp->key, cp->value);
+    for (int i = 0; i < nSlots; i++) {
+        if (hashes[i] != 0) {
+            fn(slots[i].key, slots[i].value);
         }
     }
 }
 
 template <typename KeyType, typename ValueType>
 void HashMap<KeyType, ValueType>::put(const KeyType& key, const ValueType& value) {
-    (*this)[key] = value;
-    m_version++;
+    int slot = findSlot(key);
+    if (slot >= 0) {
+        slots[slot].value = value;
+        m_version++;
+    } else {
+        insertSlot(hashOf(key), key, value);
+    }
 }
 
 template <typename KeyType, typename ValueType>
 HashMap<KeyType, ValueType>& HashMap<KeyType, ValueType>::putAll(const HashMap& map2) {
-    for (const KeyType& key : map2) {
-        put(key, map2.get(key));
+    if (this == &map2) {
+        return *this;
+    }
+    // the keys may overlap, so only reserve what is surely needed and let
+    // the table grow if the maps turn out to be disjoint
+    reserve(std::max(numEntries, map2.numEntries));
+    for (int i = 0; i < map2.nSlots; i++) {
+        if (map2.hashes[i] != 0) {
+            put(map2.slots[i].key, map2.slots[i].value);
+        }
     }
     return *this;
 }
@@ -875,26 +1101,14 @@ HashMap<KeyType, ValueType>& HashMap<KeyType, ValueType>::putAll(const HashMap&
 template <typename KeyType, typename ValueType>
 HashMap<KeyType, ValueType>& HashMap<KeyType, ValueType>::putAll(
         std::initializer_list<std::pair<KeyType, ValueType> > list) {
-    for (const std::pair<KeyType, ValueType>& pair : list) {
-        put(pair.first, pair.second);
-    }
-    return *this;
+    return insertAll(list.begin(), list.end());
 }
 
 template <typename KeyType, typename ValueType>
 void HashMap<KeyType, ValueType>::remove(const KeyType& key) {
-    int bucket = hashCode(key) % nBuckets;
-    Cell *parent;
-    Cell* cp = findCell(bucket, key, parent);
-    if (cp) {
-        if (!parent) {
-            buckets[bucket] = cp->next;
-        } else {
-            parent->next = cp->next;
-        }
-        delete cp;
-        numEntries--;
-        m_version++;
+    int slot = findSlot(key);
+    if (slot >= 0) {
+        removeSlot(slot);
     }
 }
 
@@ -919,6 +1133,19 @@ HashMap<KeyType, ValueType>& HashMap<KeyType, ValueType>::removeAll(
     return *this;
 }
 
+template <typename KeyType, typename ValueType>
+void HashMap<KeyType, ValueType>::reserve(int n) {
+    if (n < 0) {
+        error("HashMap::reserve: size cannot be negative");
+    } else if (n > MAX_CAPACITY / 100 * MAX_LOAD_PERCENTAGE) {
+        error("HashMap::reserve: size is too large");
+    }
+    int capacity = capacityFor(n);
+    if (capacity > nSlots) {
+        rehash(capacity);
+    }
+}
+
 template <typename KeyType, typename ValueType>
 HashMap<KeyType, ValueType>& HashMap<KeyType, ValueType>::retainAll(const HashMap& map2) {
     Vector<KeyType> toRemove;
@@ -964,22 +1191,11 @@ Vector<ValueType> HashMap<KeyType, ValueType>::values() const {
 
 template <typename KeyType, typename ValueType>
 ValueType& HashMap<KeyType, ValueType>::operator [](const KeyType& key) {
-    int bucket = hashCode(key) % nBuckets;
-    Cell* cp = findCell(bucket, key);
-    if (!cp) {
-        if (numEntries > MAX_LOAD_PERCENTAGE * nBuckets / 100.0) {
-            expandAndRehash();
-            bucket = hashCode(key) % nBuckets;
-        }
-        cp = new Cell;
-        cp->key = key;
-        cp->value = ValueType();
-        cp->next = buckets[bucket];
-        buckets[bucket] = cp;
-        numEntries++;
-        m_version++;
+    int slot = findSlot(key);
+    if (slot < 0) {
+        slot = insertSlot(hashOf(key), key, ValueType());
     }
-    return cp->value;
+    return slots[slot].value;
 }
 
 template <typename KeyType, typename ValueType>
@@ -4,6 +4,8 @@
  * This file exports the <code>HashSet</code> class, which
  * implements an efficient abstraction for storing sets of values.
  * 
+ * @version 2026/10/17
+ * - added capacity constructor, reserve and insertAll for bulk loading
  * @version 2018/03/10
  * - added methods front, back
  * @version 2016/12/09
@@ -38,8 +40,11 @@
 #ifndef _hashset_h
 #define _hashset_h
 
+#include <algorithm>
 #include <initializer_list>
 #include <iostream>
+#include <iterator>
+#include <type_traits>
 
 #define INTERNAL_INCLUDE 1
 #include "collections.h"
@@ -76,6 +81,15 @@ public:
      */
     HashSet();
 
+    /*
+     * Constructor: HashSet
+     * Usage: HashSet<ValueType> set(capacity);
+     * ----------------------------------------
+     * Initializes an empty set with room for at least the given number of
+     * elements, so that filling it up to that size never rehashes.
+     */
+    explicit HashSet(int capacity);
+
     /*
      * Constructor: HashSet
      * Usage: HashSet<ValueType> set {1, 2, 3};
@@ -201,6 +215,25 @@ public:
      */
     void insert(const ValueType& value);
 
+    /*
+     * Method: insertAll
+     * Usage: set.insertAll(first, last);
+     *        set.insertAll(values);
+     * -----------------------------------
+     * Adds every value in the range [first, last), or in the given
+     * collection, to this set.  When the size of the collection, or of a
+     * range of forward iterators, is known in advance, the table is sized
+     * once for it before anything is added; the iterators of the Stanford
+     * collections are input iterators, so pass such a collection (say, a
+     * Lexicon) itself rather than its begin and end.  Returns a reference
+     * to this set.
+     */
+    template <typename IteratorType>
+    HashSet<ValueType>& insertAll(IteratorType first, IteratorType last);
+
+    template <typename CollectionType>
+    HashSet<ValueType>& insertAll(const CollectionType& values);
+
     /*
      * Method: isEmpty
      * Usage: if (set.isEmpty()) ...
@@ -272,6 +305,15 @@ public:
     HashSet<ValueType>& removeAll(const HashSet<ValueType>& set);
     HashSet<ValueType>& removeAll(std::initializer_list<ValueType> list);
 
+    /*
+     * Method: reserve
+     * Usage: set.reserve(n);
+     * ----------------------
+     * Makes room for at least <code>n</code> elements in total, so that the
+     * set can grow to that size without rehashing along the way.
+     */
+    void reserve(int n);
+
     /*
      * Method: retainAll
      * Usage: set.retainAll(set2);
@@ -522,6 +564,13 @@ HashSet<ValueType>::HashSet() : removeFlag(false) {
     /* Empty */
 }
 
+template <typename ValueType>
+HashSet<ValueType>::HashSet(int capacity)
+        : map(capacity),
+          removeFlag(false) {
+    /* Empty */
+}
+
 template <typename ValueType>
 HashSet<ValueType>::HashSet(std::initializer_list<ValueType> list)
         : removeFlag(false) {
@@ -540,18 +589,13 @@ void HashSet<ValueType>::add(const ValueType& value) {
 
 template <typename ValueType>
 HashSet<ValueType>& HashSet<ValueType>::addAll(const HashSet& set2) {
-    for (const ValueType& value : set2) {
-        this->add(value);
-    }
+    map.putAll(set2.map);
     return *this;
 }
 
 template <typename ValueType>
 HashSet<ValueType>& HashSet<ValueType>::addAll(std::initializer_list<ValueType> list) {
-    for (const ValueType& value : list) {
-        this->add(value);
-    }
-    return *this;
+    return insertAll(list.begin(), list.end());
 }
 
 template <typename ValueType>
@@ -629,6 +673,29 @@ void HashSet<ValueType>::insert(const ValueType& value) {
     map.put(value, true);
 }
 
+template <typename ValueType>
+template <typename IteratorType>
+HashSet<ValueType>& HashSet<ValueType>::insertAll(IteratorType first, IteratorType last) {
+    typedef typename std::iterator_traits<IteratorType>::iterator_category Category;
+    if (std::is_base_of<std::forward_iterator_tag, Category>::value) {
+        map.reserve(std::max(map.size(), (int) std::distance(first, last)));
+    }
+    for (; first != last; ++first) {
+        map.put(*first, true);
+    }
+    return *this;
+}
+
+template <typename ValueType>
+template <typename CollectionType>
+HashSet<ValueType>& HashSet<ValueType>::insertAll(const CollectionType& values) {
+    map.reserve(std::max(map.size(), stanfordcpplib::collections::sizeHint(values)));
+    for (const auto& value : values) {
+        map.put(value, true);
+    }
+    return *this;
+}
+
 template <typename ValueType>
 bool HashSet<ValueType>::isEmpty() const {
     return map.isEmpty();
@@ -684,6 +751,11 @@ void HashSet<ValueType>::remove(const ValueType& value) {
     map.remove(value);
 }
 
+template <typename ValueType>
+void HashSet<ValueType>::reserve(int n) {
+    map.reserve(n);
+}
+
 template <typename ValueType>
 HashSet<ValueType>& HashSet<ValueType>::removeAll(const HashSet& set2) {
     Vector<ValueType> toRemove;
@@ -5,6 +5,9 @@
  * compact structure for storing a list of words.
  *
  * @author Marty Stepp
+ * @version 2026/10/17
+ * - contains and containsPrefix accept a StringView and walk the trie
+ *   without copying the word
  * @version 2018/03/10
  * - added methods front, back
  * @version 2016/12/09
@@ -42,6 +45,8 @@
 #include "hashcode.h"
 #define INTERNAL_INCLUDE 1
 #include "set.h"
+#define INTERNAL_INCLUDE 1
+#include "stringview.h"
 #undef INTERNAL_INCLUDE
 
 /**
@@ -159,8 +164,10 @@ public:
      * ignored, so "Zoo" is the same as "ZOO" or "zoo".
      * The empty string cannot be contained in a lexicon, nor can any word
      * containing any non-alphabetic characters such as punctuation or whitespace.
+     * The word may be a string, a C string or a <code>StringView</code>;
+     * none of them is copied.
      */
-    bool contains(const std::string& word) const;
+    bool contains(const StringView& word) const;
 
     /**
      * Returns <code>true</code> if every value from the given other lexicon
@@ -183,7 +190,7 @@ public:
      * The empty string is a prefix of every string, so this method returns
      * true when passed the empty string.
      */
-    bool containsPrefix(const std::string& prefix) const;
+    bool containsPrefix(const StringView& prefix) const;
 
     /**
      * Compares two lexicons for equality.
@@ -513,7 +520,7 @@ private:
      * recursive helpers to implement public add/contains/remove
      */
     bool addHelper(TrieNode*& node, const std::string& word, const std::string& originalWord);
-    bool containsHelper(TrieNode* node, const std::string& word, bool isPrefix) const;
+    TrieNode* findNode(const StringView& word) const;
     void deepCopy(const Lexicon& src);
     void deleteTree(TrieNode* node);
     bool isDAWGFile(std::istream& input) const;
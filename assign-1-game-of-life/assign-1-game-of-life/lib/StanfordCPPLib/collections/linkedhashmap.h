@@ -5,10 +5,16 @@
  * a set of <i>key</i>-<i>value</i> pairs.
  * Identical to a HashMap except that upon iteration using a for-each loop
  * or << / toString call, it will emit its key/value pairs in the order they
- * were originally inserted.  This is provided at a runtime and memory
- * cost due to needing to store an extra copy of the keys.
+ * were originally inserted.  This is provided at a small runtime and memory
+ * cost for linking the entries together in that order.
  * 
  * @author Marty Stepp
+ * @version 2026/10/17
+ * - entries are linked in insertion order instead of copying keys into a
+ *   Vector, so each key is stored once and remove takes O(1) time
+ * - putting a key that is already present keeps its place in the order
+ *   rather than listing it twice
+ * - keys() returns a new Vector; mapAll visits entries in insertion order
  * @version 2018/03/10
  * - added methods front, back
  * @version 2016/09/24
@@ -37,9 +43,11 @@
 #ifndef _linkedhashmap_h
 #define _linkedhashmap_h
 
+#include <cstdint>
 #include <initializer_list>
 #include <iterator>
 #include <string>
+#include <utility>
 
 #define INTERNAL_INCLUDE 1
 #include "collections.h"
@@ -48,8 +56,6 @@
 #define INTERNAL_INCLUDE 1
 #include "hashcode.h"
 #define INTERNAL_INCLUDE 1
-#include "hashmap.h"
-#define INTERNAL_INCLUDE 1
 #include "vector.h"
 #undef INTERNAL_INCLUDE
 
@@ -186,18 +192,19 @@ public:
      * Method: keys
      * Usage: Vector<KeyType> keys = map.keys();
      * -----------------------------------------
-     * Returns a collection containing all keys in this map.
-     * This implementation already retains an internal copy of the keys,
-     * so it is efficient to call this function even on large maps.
+     * Returns a collection containing all keys in this map, in the order
+     * they were added.
+     * Note that this implementation makes a deep copy of the keys,
+     * so it is inefficient to call on large maps.
      */
-    const Vector<KeyType>& keys() const;
+    Vector<KeyType> keys() const;
 
     /*
      * Method: mapAll
      * Usage: map.mapAll(fn);
      * ----------------------
      * Iterates through the map entries and calls <code>fn(key, value)</code>
-     * for each one.  The keys are processed in an undetermined order.
+     * for each one.  The keys are processed in the order they were added.
      */
     void mapAll(void (*fn)(KeyType, ValueType)) const;
     void mapAll(void (*fn)(const KeyType&, const ValueType&)) const;
@@ -211,7 +218,7 @@ public:
      * ---------------------------
      * Associates <code>key</code> with <code>value</code> in this map.
      * Any previous value associated with <code>key</code> is replaced
-     * by the new value.
+     * by the new value, and the key keeps its place in the iteration order.
      */
     void put(const KeyType& key, const ValueType& value);
 
@@ -233,6 +240,8 @@ public:
      * -----------------------
      * Removes any entry for <code>key</code> from this map.
      * If the given key is not found, has no effect.
+     * Removing a key and putting it back moves it to the end of the
+     * iteration order, which makes this class usable as an LRU list.
      */
     void remove(const KeyType& key);
 
@@ -418,12 +427,258 @@ public:
     /*
      * Implementation notes:
      * ---------------------
-     * The LinkedHashMap class is represented using a hash map along with a
-     * Vector to remember the order of insertion.
-    */
+     * The LinkedHashMap class stores its entries in an array, linked into
+     * a doubly linked list in insertion order by prev/next indices, and
+     * finds them through a separate hash index of {hash, entry} slots.
+     * See the implementation notes below the class for details.
+     */
 private:
-    HashMap<KeyType, ValueType> innerMap;
-    Vector<KeyType> keyVector;
+    /* Constant definitions */
+    static const int INITIAL_CAPACITY = 16;     // must be a power of two
+    static const int MAX_LOAD_PERCENTAGE = 80;
+    static const int NONE = -1;                 // "no entry" link
+
+    /*
+     * Type definition for the entries of the map.  The value lives in the
+     * MapNodeValue base so that LinkedHashSet entries hold no value.
+     */
+    struct Entry : stanfordcpplib::collections::MapNodeValue<ValueType> {
+        KeyType key;
+        int prev;       // previous entry in insertion order, or NONE
+        int next;       // next entry in insertion order or in the free list
+    };
+
+    /* Type definition for the slots of the hash index */
+    struct IndexSlot {
+        uint32_t hash;  // cached (nonzero) hash of the key; 0 if empty
+        int entry;      // index into entries
+    };
+
+    /* Instance variables */
+    Entry* entries = nullptr;        // storage for the entries
+    int entryCapacity = 0;           // allocated length of entries
+    int entriesUsed = 0;             // entries[0..entriesUsed) have been handed out
+    int freeEntry = NONE;            // list of removed entries, linked by next
+    int head = NONE;                 // oldest entry
+    int tail = NONE;                 // newest entry
+    IndexSlot* index = nullptr;      // the hash index
+    int nSlots = 0;                  // capacity of the index, 0 or a power of two
+    int slotBits = 0;                // log2(nSlots)
+    int numEntries = 0;
+    unsigned int m_version = 0;      // structure version for detecting invalid iterators
+
+    /* Private methods */
+
+    /*
+     * Returns the value cached in the index for the given key: the top half
+     * of its seeded 64-bit hash.  Zero is reserved to mark empty slots.
+     */
+    static uint32_t hashOf(const KeyType& key) {
+        uint32_t h = static_cast<uint32_t>(hashCode64(key) >> 32);
+        return h == 0 ? 1 : h;
+    }
+
+    int homeSlot(uint32_t h) const {
+        return static_cast<int>(h >> (32 - slotBits));
+    }
+
+    int probeDistance(uint32_t h, int slot) const {
+        return (slot - homeSlot(h)) & (nSlots - 1);
+    }
+
+    /*
+     * Private method: findSlot
+     * Usage: int slot = findSlot(key);
+     * --------------------------------
+     * Returns the index slot that refers to the given key, or -1 if the key
+     * is not in the map.  The index uses the same Robin Hood probing as
+     * HashMap, so a search stops at the first slot closer to home.
+     */
+    int findSlot(const KeyType& key) const {
+        if (numEntries == 0) {
+            return -1;
+        }
+        uint32_t h = hashOf(key);
+        int mask = nSlots - 1;
+        int slot = homeSlot(h);
+        for (int dist = 0; ; dist++) {
+            uint32_t stored = index[slot].hash;
+            if (stored == 0 || probeDistance(stored, slot) < dist) {
+                return -1;
+            }
+            if (stored == h && entries[index[slot].entry].key == key) {
+                return slot;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    /*
+     * Puts a {hash, entry} pair into the index, displacing any slot that is
+     * closer to its home than this one and carrying it forward in turn.
+     */
+    void placeSlot(IndexSlot item) {
+        int mask = nSlots - 1;
+        int slot = homeSlot(item.hash);
+        for (int dist = 0; ; dist++) {
+            if (index[slot].hash == 0) {
+                index[slot] = item;
+                return;
+            }
+            int storedDist = probeDistance(index[slot].hash, slot);
+            if (storedDist < dist) {
+                std::swap(item, index[slot]);
+                dist = storedDist;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    /*
+     * Empties the given index slot and shifts the slots after it back by
+     * one, as HashMap::removeSlot does.
+     */
+    void removeSlot(int slot) {
+        int mask = nSlots - 1;
+        int next = (slot + 1) & mask;
+        while (index[next].hash != 0 && probeDistance(index[next].hash, next) > 0) {
+            index[slot] = index[next];
+            slot = next;
+            next = (next + 1) & mask;
+        }
+        index[slot].hash = 0;
+    }
+
+    /*
+     * Moves every slot into a new index with the given number of slots,
+     * which must be a power of two.  Entries do not move.
+     */
+    void rehash(int capacity) {
+        IndexSlot* oldIndex = index;
+        int oldCount = nSlots;
+        index = new IndexSlot[capacity]();
+        nSlots = capacity;
+        slotBits = 0;
+        while ((1 << slotBits) < capacity) {
+            slotBits++;
+        }
+        for (int i = 0; i < oldCount; i++) {
+            if (oldIndex[i].hash != 0) {
+                placeSlot(oldIndex[i]);
+            }
+        }
+        delete[] oldIndex;
+    }
+
+    /*
+     * Returns the number of a free entry, reusing a removed one if there
+     * is one and growing the entry array otherwise.
+     */
+    int allocateEntry() {
+        if (freeEntry != NONE) {
+            int e = freeEntry;
+            freeEntry = entries[e].next;
+            return e;
+        }
+        if (entriesUsed == entryCapacity) {
+            int capacity = entryCapacity == 0 ? INITIAL_CAPACITY : entryCapacity * 2;
+            Entry* newEntries = new Entry[capacity];
+            for (int i = 0; i < entriesUsed; i++) {
+                newEntries[i] = std::move(entries[i]);
+            }
+            delete[] entries;
+            entries = newEntries;
+            entryCapacity = capacity;
+        }
+        return entriesUsed++;
+    }
+
+    /*
+     * Private method: insertEntry
+     * Usage: insertEntry(h, key, value);
+     * ----------------------------------
+     * Adds a key that is known not to be in the map at the end of the
+     * insertion order.
+     */
+    void insertEntry(uint32_t h, const KeyType& key, const ValueType& value) {
+        if (numEntries >= (int64_t) nSlots * MAX_LOAD_PERCENTAGE / 100) {
+            rehash(nSlots == 0 ? INITIAL_CAPACITY : nSlots * 2);
+        }
+        int e = allocateEntry();
+        entries[e].key = key;
+        entries[e].getValue() = value;
+        entries[e].prev = tail;
+        entries[e].next = NONE;
+        if (tail == NONE) {
+            head = e;
+        } else {
+            entries[tail].next = e;
+        }
+        tail = e;
+        IndexSlot item = { h, e };
+        placeSlot(item);
+        numEntries++;
+        m_version++;
+    }
+
+    /*
+     * Private method: removeEntry
+     * Usage: removeEntry(slot);
+     * -------------------------
+     * Removes the entry referred to by the given index slot: unlinks it
+     * from the insertion order and puts it on the free list.
+     */
+    void removeEntry(int slot) {
+        int e = index[slot].entry;
+        removeSlot(slot);
+        Entry& entry = entries[e];
+        if (entry.prev == NONE) {
+            head = entry.next;
+        } else {
+            entries[entry.prev].next = entry.next;
+        }
+        if (entry.next == NONE) {
+            tail = entry.prev;
+        } else {
+            entries[entry.next].prev = entry.prev;
+        }
+        entry.key = KeyType();
+        entry.getValue() = ValueType();
+        entry.next = freeEntry;
+        freeEntry = e;
+        numEntries--;
+        m_version++;
+    }
+
+    void deepCopy(const LinkedHashMap& src) {
+        // copy the arrays as they are, so that every entry keeps its number
+        // and the index needs no rehashing
+        delete[] entries;
+        delete[] index;
+        entries = nullptr;
+        index = nullptr;
+        if (src.entryCapacity > 0) {
+            entries = new Entry[src.entryCapacity];
+            for (int i = 0; i < src.entriesUsed; i++) {
+                entries[i] = src.entries[i];
+            }
+        }
+        if (src.nSlots > 0) {
+            index = new IndexSlot[src.nSlots];
+            for (int i = 0; i < src.nSlots; i++) {
+                index[i] = src.index[i];
+            }
+        }
+        entryCapacity = src.entryCapacity;
+        entriesUsed = src.entriesUsed;
+        freeEntry = src.freeEntry;
+        head = src.head;
+        tail = src.tail;
+        nSlots = src.nSlots;
+        slotBits = src.slotBits;
+        numEntries = src.numEntries;
+        m_version++;
+    }
 
 public:
     /*
@@ -435,6 +690,24 @@ public:
      * difficult to understand for the average client.
      */
 
+    /*
+     * Deep copying support
+     * --------------------
+     * This copy constructor and operator= are defined to make a
+     * deep copy, making it possible to pass/return maps by value
+     * and assign from one map to another.
+     */
+    LinkedHashMap& operator =(const LinkedHashMap& src) {
+        if (this != &src) {
+            deepCopy(src);
+        }
+        return *this;
+    }
+
+    LinkedHashMap(const LinkedHashMap& src) {
+        deepCopy(src);
+    }
+
     /*
      * Iterator support
      * ----------------
@@ -442,32 +715,112 @@ public:
      * iterators so that they work symmetrically with respect to the
      * corresponding STL classes.
      */
-    class iterator : public Vector<KeyType>::iterator {
+    class iterator : public std::iterator<std::input_iterator_tag, KeyType> {
+    private:
+        const LinkedHashMap* mp;     /* Pointer to the map           */
+        int entry;                   /* Current entry, or NONE at end */
+        unsigned int itr_version;    /* Version for checking for modification */
+
     public:
-        iterator() : Vector<KeyType>::iterator() {}
-        iterator(const iterator& it) : Vector<KeyType>::iterator(it) {}
-        iterator(const typename Vector<KeyType>::iterator& it) : Vector<KeyType>::iterator(it) {}
+        iterator()
+                : mp(nullptr),
+                  entry(NONE),
+                  itr_version(0) {
+            // empty
+        }
+
+        iterator(const LinkedHashMap* mp, bool end)
+                : mp(mp),
+                  entry(NONE),
+                  itr_version(mp->version()) {
+            if (!end) {
+                entry = mp->head;
+            }
+        }
+
+        iterator(const iterator& it)
+                : mp(it.mp),
+                  entry(it.entry),
+                  itr_version(it.itr_version) {
+            // empty
+        }
+
+        iterator& operator ++() {
+            stanfordcpplib::collections::checkVersion(*mp, *this);
+            entry = mp->entries[entry].next;
+            return *this;
+        }
+
+        iterator operator ++(int) {
+            stanfordcpplib::collections::checkVersion(*mp, *this);
+            iterator copy(*this);
+            operator++();
+            return copy;
+        }
+
+        bool operator ==(const iterator& rhs) {
+            return mp == rhs.mp && entry == rhs.entry;
+        }
+
+        bool operator !=(const iterator& rhs) {
+            return !(*this == rhs);
+        }
+
+        KeyType& operator *() {
+            stanfordcpplib::collections::checkVersion(*mp, *this);
+            return mp->entries[entry].key;
+        }
+
+        KeyType* operator ->() {
+            stanfordcpplib::collections::checkVersion(*mp, *this);
+            return &mp->entries[entry].key;
+        }
+
+        unsigned int version() const {
+            return itr_version;
+        }
+
+        friend class LinkedHashMap;
     };
 
     /*
      * Returns an iterator positioned at the first key of the map.
      */
     iterator begin() const {
-        return iterator(keyVector.begin());
+        return iterator(this, /* end */ false);
     }
 
     /*
      * Returns an iterator positioned at the last key of the map.
      */
     iterator end() const {
-        return iterator(keyVector.end());
+        return iterator(this, /* end */ true);
+    }
+
+    /*
+     * Returns the internal version of this collection.
+     * This is used to check for invalid iterators and issue error messages.
+     */
+    unsigned int version() const {
+        return m_version;
     }
 };
 
 /*
  * Implementation notes: LinkedHashMap class
  * -----------------------------------------
- * ...
+ * Each key is stored once, in an Entry that also holds its value and the
+ * numbers of the entries before and after it in insertion order.  Entries
+ * live in one array and keep their number for as long as they are in the
+ * map; a removed entry is unlinked in O(1) time and goes on a free list
+ * for the next insertion to reuse, so the order list never has to be
+ * searched or compacted.
+ *
+ * Keys are found through a separate open-addressing index whose slots
+ * hold just a cached hash and an entry number.  It uses the same Robin
+ * Hood probing and backward-shift deletion as HashMap.  Because the index
+ * refers to entries by number, rehashing it never moves an entry, and
+ * growing the entry array never touches the index.
  */
 template <typename KeyType, typename ValueType>
 LinkedHashMap<KeyType, ValueType>::LinkedHashMap() {
@@ -481,7 +834,8 @@ LinkedHashMap<KeyType, ValueType>::LinkedHashMap(std::initializer_list<std::pair
 
 template <typename KeyType, typename ValueType>
 LinkedHashMap<KeyType, ValueType>::~LinkedHashMap() {
-    // empty
+    delete[] entries;
+    delete[] index;
 }
 
 template <typename KeyType, typename ValueType>
@@ -505,18 +859,27 @@ KeyType LinkedHashMap<KeyType, ValueType>::back() const {
     if (isEmpty()) {
         error("LinkedHashMap::back: map is empty");
     }
-    return keyVector.back();
+    return entries[tail].key;
 }
 
 template <typename KeyType, typename ValueType>
 void LinkedHashMap<KeyType, ValueType>::clear() {
-    innerMap.clear();
-    keyVector.clear();
+    for (int i = 0; i < entriesUsed; i++) {
+        entries[i].key = KeyType();
+        entries[i].getValue() = ValueType();
+    }
+    for (int i = 0; i < nSlots; i++) {
+        index[i].hash = 0;
+    }
+    entriesUsed = 0;
+    freeEntry = head = tail = NONE;
+    numEntries = 0;
+    m_version++;
 }
 
 template <typename KeyType, typename ValueType>
 bool LinkedHashMap<KeyType, ValueType>::containsKey(const KeyType& key) const {
-    return innerMap.containsKey(key);
+    return findSlot(key) >= 0;
 }
 
 template <typename KeyType, typename ValueType>
@@ -529,45 +892,64 @@ KeyType LinkedHashMap<KeyType, ValueType>::front() const {
     if (isEmpty()) {
         error("LinkedHashMap::front: map is empty");
     }
-    return keyVector.front();
+    return entries[head].key;
 }
 
 template <typename KeyType, typename ValueType>
 ValueType LinkedHashMap<KeyType, ValueType>::get(const KeyType& key) const {
-    return innerMap.get(key);
+    int slot = findSlot(key);
+    if (slot < 0) {
+        return ValueType();
+    }
+    return entries[index[slot].entry].getValue();
 }
 
 template <typename KeyType, typename ValueType>
 bool LinkedHashMap<KeyType, ValueType>::isEmpty() const {
-    return innerMap.isEmpty();
+    return numEntries == 0;
 }
 
 template <typename KeyType, typename ValueType>
-const Vector<KeyType>& LinkedHashMap<KeyType, ValueType>::keys() const {
-    return keyVector;
+Vector<KeyType> LinkedHashMap<KeyType, ValueType>::keys() const {
+    Vector<KeyType> keyset;
+    keyset.ensureCapacity(numEntries);
+    for (const KeyType& key : *this) {
+        keyset.add(key);
+    }
+    return keyset;
 }
 
 template <typename KeyType, typename ValueType>
 void LinkedHashMap<KeyType, ValueType>::mapAll(void (*fn)(KeyType, ValueType)) const {
-    innerMap.mapAll(fn);
+    for (int e = head; e != NONE; e = entries[e].next) {
+        fn(entries[e].key, entries[e].getValue());
+    }
 }
 
 template <typename KeyType, typename ValueType>
 void LinkedHashMap<KeyType, ValueType>::mapAll(void (*fn)(const KeyType&,
                                                    const ValueType&)) const {
-    innerMap.mapAll(fn);
+    for (int e = head; e != NONE; e = entries[e].next) {
+        fn(entries[e].key, entries[e].getValue());
+    }
 }
 
 template <typename KeyType, typename ValueType>
 template <typename FunctorType>
 void LinkedHashMap<KeyType, ValueType>::mapAll(FunctorType fn) const {
-    innerMap.mapAll(fn);
+    for (int e = head; e != NONE; e = entries[e].next) {
+        fn(entries[e].key, entries[e].getValue());
+    }
 }
 
 template <typename KeyType, typename ValueType>
 void LinkedHashMap<KeyType, ValueType>::put(const KeyType& key, const ValueType& value) {
-    innerMap.put(key, value);
-    keyVector.add(key);
+    int slot = findSlot(key);
+    if (slot >= 0) {
+        entries[index[slot].entry].getValue() = value;
+    } else {
+        insertEntry(hashOf(key), key, value);
+    }
 }
 
 template <typename KeyType, typename ValueType>
@@ -589,12 +971,9 @@ LinkedHashMap<KeyType, ValueType>& LinkedHashMap<KeyType, ValueType>::putAll(
 
 template <typename KeyType, typename ValueType>
 void LinkedHashMap<KeyType, ValueType>::remove(const KeyType& key) {
-    innerMap.remove(key);
-    for (int i = 0, sz = keyVector.size(); i < sz; i++) {
-        if (keyVector[i] == key) {
-            keyVector.remove(i);
-            break;
-        }
+    int slot = findSlot(key);
+    if (slot >= 0) {
+        removeEntry(slot);
     }
 }
 
@@ -643,7 +1022,7 @@ LinkedHashMap<KeyType, ValueType>& LinkedHashMap<KeyType, ValueType>::retainAll(
 
 template <typename KeyType, typename ValueType>
 int LinkedHashMap<KeyType, ValueType>::size() const {
-    return innerMap.size();
+    return numEntries;
 }
 
 template <typename KeyType, typename ValueType>
@@ -656,15 +1035,16 @@ std::string LinkedHashMap<KeyType, ValueType>::toString() const {
 template <typename KeyType, typename ValueType>
 Vector<ValueType> LinkedHashMap<KeyType, ValueType>::values() const {
     Vector<ValueType> values;
-    for (const KeyType& key : *this) {
-        values.add(get(key));
+    values.ensureCapacity(numEntries);
+    for (int e = head; e != NONE; e = entries[e].next) {
+        values.add(entries[e].getValue());
     }
     return values;
 }
 
 template <typename KeyType, typename ValueType>
 ValueType LinkedHashMap<KeyType, ValueType>::operator [](const KeyType& key) const {
-    return innerMap[key];
+    return get(key);
 }
 
 template <typename KeyType, typename ValueType>
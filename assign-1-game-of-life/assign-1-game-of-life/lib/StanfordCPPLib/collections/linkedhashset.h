@@ -5,6 +5,10 @@
  * implements an efficient abstraction for storing sets of values.
  * 
  * @author Marty Stepp
+ * @version 2026/10/17
+ * - elements are stored in a LinkedHashMap with NoValue values, which
+ *   now removes elements in O(1) time
+ * - fixed mapAll, which did not compile
  * @version 2018/03/10
  * - added methods front, back
  * @version 2016/09/24
@@ -416,7 +420,9 @@ public:
     /**********************************************************************/
 
 private:
-    LinkedHashMap<ValueType, bool> map;  /* Map used to store the element     */
+    typedef stanfordcpplib::collections::NoValue NoValue;
+
+    LinkedHashMap<ValueType, NoValue> map;  /* Map used to store the element  */
     bool removeFlag;                     /* Flag to differentiate += and -=   */
 
 public:
@@ -446,14 +452,14 @@ public:
      */
     class iterator : public std::iterator<std::input_iterator_tag,ValueType> {
     private:
-        typename LinkedHashMap<ValueType,bool>::iterator mapit;
+        typename LinkedHashMap<ValueType, NoValue>::iterator mapit;
 
     public:
         iterator() {
             /* Empty */
         }
 
-        iterator(typename LinkedHashMap<ValueType, bool>::iterator it) : mapit(it) {
+        iterator(typename LinkedHashMap<ValueType, NoValue>::iterator it) : mapit(it) {
             /* Empty */
         }
 
@@ -485,7 +491,7 @@ public:
         }
 
         ValueType* operator ->() {
-            return mapit;
+            return &*mapit;
         }
     };
 
@@ -516,7 +522,7 @@ LinkedHashSet<ValueType>::~LinkedHashSet() {
 
 template <typename ValueType>
 void LinkedHashSet<ValueType>::add(const ValueType& value) {
-    map.put(value, true);
+    map.put(value, NoValue());
 }
 
 template <typename ValueType>
@@ -605,7 +611,7 @@ ValueType LinkedHashSet<ValueType>::front() const {
 
 template <typename ValueType>
 void LinkedHashSet<ValueType>::insert(const ValueType& value) {
-    map.put(value, true);
+    map.put(value, NoValue());
 }
 
 template <typename ValueType>
@@ -644,18 +650,24 @@ bool LinkedHashSet<ValueType>::isSupersetOf(std::initializer_list<ValueType> lis
 
 template <typename ValueType>
 void LinkedHashSet<ValueType>::mapAll(void (*fn)(ValueType)) const {
-    map.mapAll(fn);
+    for (const ValueType& value : *this) {
+        fn(value);
+    }
 }
 
 template <typename ValueType>
 void LinkedHashSet<ValueType>::mapAll(void (*fn)(const ValueType&)) const {
-    map.mapAll(fn);
+    for (const ValueType& value : *this) {
+        fn(value);
+    }
 }
 
 template <typename ValueType>
 template <typename FunctorType>
 void LinkedHashSet<ValueType>::mapAll(FunctorType fn) const {
-    map.mapAll(fn);
+    for (const ValueType& value : *this) {
+        fn(value);
+    }
 }
 
 template <typename ValueType>
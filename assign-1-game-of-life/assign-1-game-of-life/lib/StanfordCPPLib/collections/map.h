@@ -4,6 +4,15 @@
  * This file exports the template class <code>Map</code>, which
  * maintains a collection of <i>key</i>-<i>value</i> pairs.
  * 
+ * @version 2026/10/17
+ * - tree nodes are allocated from a per-map NodePool
+ * - maps whose value type is NoValue store no value in their nodes
+ * - added assignSorted to build a balanced tree from sorted keys
+ * - maps with string keys in the default order can be searched by
+ *   C string or StringView without creating a string
+ * - maps using the default std::less ordering compare keys inline,
+ *   and lookups make one key comparison per tree level; keys without a
+ *   < operator still work with a client-supplied comparator
  * @version 2018/03/19
  * - added constructors that accept a comparison function
  * @version 2018/03/10
@@ -45,8 +54,11 @@
 #ifndef _map_h
 #define _map_h
 
+#include <algorithm>
 #include <cstdlib>
+#include <functional>
 #include <initializer_list>
+#include <type_traits>
 #include <utility>
 
 #define INTERNAL_INCLUDE 1
@@ -56,8 +68,12 @@
 #define INTERNAL_INCLUDE 1
 #include "hashcode.h"
 #define INTERNAL_INCLUDE 1
+#include "nodepool.h"
+#define INTERNAL_INCLUDE 1
 #include "stack.h"
 #define INTERNAL_INCLUDE 1
+#include "stringview.h"
+#define INTERNAL_INCLUDE 1
 #include "vector.h"
 #undef INTERNAL_INCLUDE
 
@@ -170,9 +186,16 @@ public:
      * ------------------------------------
      * Returns <code>true</code> if there is an entry for <code>key</code>
      * in this map.
+     * If the keys are strings, <code>key</code> may also be a C string or a
+     * <code>StringView</code>.  Unless the map was given its own comparison
+     * function, that key is looked up without creating a string.
      */
     bool containsKey(const KeyType& key) const;
 
+    template <typename K>
+    typename std::enable_if<stanfordcpplib::collections::IsStringViewLookup<KeyType, K>::value, bool>::type
+    containsKey(const K& key) const;
+
     /*
      * Method: equals
      * Usage: if (map.equals(map2)) ...
@@ -198,9 +221,15 @@ public:
      * Returns the value associated with <code>key</code> in this map.
      * If <code>key</code> is not found, <code>get</code> returns the
      * default value for <code>ValueType</code>.
+     * As with containsKey, string keys may be looked up by a C string or a
+     * <code>StringView</code>.
      */
     ValueType get(const KeyType& key) const;
 
+    template <typename K>
+    typename std::enable_if<stanfordcpplib::collections::IsStringViewLookup<KeyType, K>::value, ValueType>::type
+    get(const K& key) const;
+
     /*
      * Method: isEmpty
      * Usage: if (map.isEmpty()) ...
@@ -459,18 +488,25 @@ public:
      */
 
 private:
+    // Set merges sorted runs of its elements using this map's ordering
+    template <typename T>
+    friend class Set;
+
     /* Constant definitions */
     static const int BST_LEFT_HEAVY = -1;
     static const int BST_IN_BALANCE = 0;
     static const int BST_RIGHT_HEAVY = +1;
 
-    /* Type definition for nodes in the binary search tree */
-    struct BSTNode {
+    /*
+     * Type definition for nodes in the binary search tree.  The value
+     * lives in the MapNodeValue base, via getValue(), so that maps with
+     * NoValue values do not spend any space on it.
+     */
+    struct BSTNode : stanfordcpplib::collections::MapNodeValue<ValueType> {
         KeyType key;             /* The key stored in this node         */
-        ValueType value;         /* The corresponding value             */
+        int bf;                  /* AVL balance factor                  */
         BSTNode* left;           /* Subtree containing all smaller keys */
         BSTNode* right;          /* Subtree containing all larger keys  */
-        int bf;                  /* AVL balance factor                  */
     };
 
     /*
@@ -488,6 +524,11 @@ private:
      * The allocation is required in the TemplateComparator class because
      * the type std::binary_function has subclasses but does not define a
      * virtual destructor.
+     *
+     * Most maps use the default std::less ordering.  Those set the
+     * defaultLess flag, and lessThan below then calls std::less directly
+     * so that the compiler can inline the comparison; only maps with a
+     * client-supplied comparator pay for the virtual call.
      */
     class Comparator {
     public:
@@ -576,11 +617,52 @@ private:
     // instance variables
     BSTNode* root;      // pointer to the root of the tree
     int nodeCount;      // number of entries in the map
+    stanfordcpplib::collections::NodePool<BSTNode> nodePool;   // storage for the nodes
     Comparator* cmpp;   // pointer to the comparator
+    bool defaultLess;   // true if cmpp just applies std::less<KeyType>
     unsigned int m_version = 0; // structure version for detecting invalid iterators
 
     // private methods
 
+    /*
+     * Implementation notes: lessThan(k1, k2)
+     * --------------------------------------
+     * Returns true if k1 comes before k2 in this map's ordering.  The
+     * inline std::less call is only compiled for key types that have a
+     * < operator; maps of other key types always have a client-supplied
+     * comparator.
+     */
+    bool lessThan(const KeyType& k1, const KeyType& k2) const {
+        return lessThan(k1, k2, stanfordcpplib::collections::HasLessOperator<KeyType>());
+    }
+
+    bool lessThan(const KeyType& k1, const KeyType& k2, std::true_type) const {
+        if (defaultLess) {
+            return std::less<KeyType>()(k1, k2);
+        }
+        return cmpp->lessThan(k1, k2);
+    }
+
+    bool lessThan(const KeyType& k1, const KeyType& k2, std::false_type) const {
+        return cmpp->lessThan(k1, k2);
+    }
+
+    /*
+     * Implementation notes: compareKeys(k1, k2)
+     * -----------------------------------------
+     * Compares the keys k1 and k2 and returns an integer (-1, 0, or +1)
+     * depending on whether k1 < k2, k1 == k2, or k1 > k2, respectively.
+     */
+    int compareKeys(const KeyType& k1, const KeyType& k2) const {
+        if (lessThan(k1, k2)) {
+            return -1;
+        } else if (lessThan(k2, k1)) {
+            return +1;
+        } else {
+            return 0;
+        }
+    }
+
     /*
      * Implementation notes: findNode(t, key)
      * --------------------------------------
@@ -590,18 +672,43 @@ private:
      * If no matching node exists in the tree, findNode returns nullptr.
      */
     ValueType* findNode(BSTNode* t, const KeyType& key) const {
-        if (!t) {
-            return nullptr;
+        // descend to the smallest node not less than key, comparing once
+        // per level, and check for equality only at the end
+        BSTNode* candidate = nullptr;
+        while (t) {
+            bool goRight = lessThan(t->key, key);
+            candidate = goRight ? candidate : t;
+            t = goRight ? t->right : t->left;
         }
-        int sign = compareKeys(key, t->key);
-        if (sign == 0) {
-            return &t->value;
+        if (candidate && !lessThan(key, candidate->key)) {
+            return &candidate->getValue();
         }
-        if (sign < 0) {
-            return findNode(t->left, key);
-        } else {
-            return findNode(t->right, key);
+        return nullptr;
+    }
+
+    /*
+     * Implementation notes: findStringNode(key)
+     * -----------------------------------------
+     * Like findNode, for a map with string keys searched by a StringView.
+     * Views compare in the same order as std::less<std::string>, so in the
+     * default ordering the view is compared with the keys directly; a
+     * client-supplied comparator needs a real string.
+     */
+    ValueType* findStringNode(const StringView& key) const {
+        if (!defaultLess) {
+            return findNode(root, key.toString());
+        }
+        BSTNode* t = root;
+        BSTNode* candidate = nullptr;
+        while (t) {
+            bool goRight = StringView(t->key) < key;
+            candidate = goRight ? candidate : t;
+            t = goRight ? t->right : t->left;
+        }
+        if (candidate && !(key < StringView(candidate->key))) {
+            return &candidate->getValue();
         }
+        return nullptr;
     }
 
     /*
@@ -618,19 +725,18 @@ private:
     ValueType* addNode(BSTNode*& t, const KeyType& key, bool& heightFlag) {
         heightFlag = false;
         if (!t)  {
-            t = new BSTNode();
+            t = nodePool.allocate();
             t->key = key;
-            t->value = ValueType();
             t->bf = BST_IN_BALANCE;
             t->left = t->right = nullptr;
             heightFlag = true;
             nodeCount++;
-            return &t->value;
+            return &t->getValue();
         }
         
         int sign = compareKeys(key, t->key);
         if (sign == 0) {
-            return &t->value;
+            return &t->getValue();
         }
         ValueType* vp = nullptr;
         int bfDelta = BST_IN_BALANCE;
@@ -694,12 +800,12 @@ private:
         BSTNode* toDelete = t;
         if (!t->left) {
             t = t->right;
-            delete toDelete;
+            nodePool.release(toDelete);
             nodeCount--;
             return true;
         } else if (!t->right) {
             t = t->left;
-            delete toDelete;
+            nodePool.release(toDelete);
             nodeCount--;
             return true;
         } else {
@@ -708,7 +814,7 @@ private:
                 successor = successor->right;
             }
             t->key = successor->key;
-            t->value = successor->value;
+            t->getValue() = successor->getValue();
             if (removeNode(t->left, successor->key)) {
                 updateBF(t, BST_RIGHT_HEAVY);
                 return (t->bf == BST_IN_BALANCE);
@@ -841,13 +947,22 @@ private:
     /*
      * Implementation notes: deleteTree(t)
      * -----------------------------------
-     * Deletes all the nodes in the tree.
+     * Deletes all the nodes in the tree.  The pool takes back all of their
+     * storage at once, so the tree is only walked if the keys or values
+     * have destructors that must run.
      */
     void deleteTree(BSTNode* t) {
+        if (nodePool.needsDestroy()) {
+            destroyTree(t);
+        }
+        nodePool.releaseAll();
+    }
+
+    void destroyTree(BSTNode* t) {
         if (t) {
-            deleteTree(t->left);
-            deleteTree(t->right);
-            delete t;
+            destroyTree(t->left);
+            destroyTree(t->right);
+            nodePool.destroy(t);
         }
     }
 
@@ -859,7 +974,7 @@ private:
     void mapAll(BSTNode* t, void (*fn)(KeyType, ValueType)) const {
         if (t) {
             mapAll(t->left, fn);
-            fn(t->key, t->value);
+            fn(t->key, t->getValue());
             mapAll(t->right, fn);
         }
     }
@@ -868,7 +983,7 @@ private:
                 void (*fn)(const KeyType&, const ValueType&)) const {
         if (t) {
             mapAll(t->left, fn);
-            fn(t->key, t->value);
+            fn(t->key, t->getValue());
             mapAll(t->right, fn);
         }
     }
@@ -877,7 +992,7 @@ private:
     void mapAll(BSTNode* t, FunctorType fn) const {
         if (t) {
             mapAll(t->left, fn);
-            fn(t->key, t->value);
+            fn(t->key, t->getValue());
             mapAll(t->right, fn);
         }
     }
@@ -886,6 +1001,7 @@ private:
         root = copyTree(other.root);
         nodeCount = other.nodeCount;
         cmpp = (!other.cmpp) ? nullptr : other.cmpp->clone();
+        defaultLess = other.defaultLess;
         m_version++;
     }
 
@@ -893,9 +1009,9 @@ private:
         if (!t) {
             return nullptr;
         } else {
-            BSTNode* np = new BSTNode;
+            BSTNode* np = nodePool.allocate();
             np->key = t->key;
-            np->value = t->value;
+            np->getValue() = t->getValue();
             np->bf = t->bf;
             np->left = copyTree(t->left);
             np->right = copyTree(t->right);
@@ -903,6 +1019,33 @@ private:
         }
     }
 
+    /*
+     * Implementation notes: buildTree(keys, next, count)
+     * --------------------------------------------------
+     * Builds a tree of the count keys starting at keys[next], which must
+     * be in ascending order, and advances next past them.  Each subtree
+     * puts half of its keys (rounded down) on the left, so the two sides
+     * differ in height by at most one and the result is a valid AVL tree.
+     * Returns the height of the new tree through the height parameter.
+     */
+    BSTNode* buildTree(const KeyType* keys, int& next, int count, int& height) {
+        if (count == 0) {
+            height = 0;
+            return nullptr;
+        }
+        int leftHeight;
+        int rightHeight;
+        int leftCount = count / 2;
+        BSTNode* left = buildTree(keys, next, leftCount, leftHeight);
+        BSTNode* np = nodePool.allocate();
+        np->key = keys[next++];
+        np->left = left;
+        np->right = buildTree(keys, next, count - leftCount - 1, rightHeight);
+        np->bf = rightHeight - leftHeight;
+        height = std::max(leftHeight, rightHeight) + 1;
+        return np;
+    }
+
 public:
     /*
      * Hidden features
@@ -919,21 +1062,31 @@ public:
         root = nullptr;
         nodeCount = 0;
         cmpp = new TemplateComparator<CompareType>(cmp);
+        defaultLess = std::is_same<CompareType, std::less<KeyType> >::value;
     }
 
     /*
-     * Implementation notes: compareKeys(k1, k2)
-     * -----------------------------------------
-     * Compares the keys k1 and k2 and returns an integer (-1, 0, or +1)
-     * depending on whether k1 < k2, k1 == k2, or k1 > k2, respectively.
+     * Bulk loading support
+     * --------------------
+     * hasSameOrdering returns true if this map and the other one are known
+     * to order their keys identically, so that walking both in order visits
+     * matching keys in step.  Only maps using the default ordering are
+     * recognized.  assignSorted replaces the contents of the map with the
+     * given keys, which must be strictly ascending in this map's ordering,
+     * each mapped to a default value.  It takes linear time and leaves the
+     * tree perfectly balanced.
      */
-    int compareKeys(const KeyType& k1, const KeyType& k2) const {
-        if (cmpp->lessThan(k1, k2)) {
-            return -1;
-        } else if (cmpp->lessThan(k2, k1)) {
-            return +1;
-        } else {
-            return 0;
+    bool hasSameOrdering(const Map& other) const {
+        return defaultLess && other.defaultLess;
+    }
+
+    void assignSorted(const Vector<KeyType>& keys) {
+        clear();
+        if (!keys.isEmpty()) {
+            int next = 0;
+            int height;
+            root = buildTree(&keys[0], next, keys.size(), height);
+            nodeCount = keys.size();
         }
     }
 
@@ -957,7 +1110,7 @@ public:
         return *this;
     }
 
-    Map(const Map& src) : root(nullptr), nodeCount(0), cmpp(nullptr) {
+    Map(const Map& src) : root(nullptr), nodeCount(0), cmpp(nullptr), defaultLess(false) {
         deepCopy(src);
     }
 
@@ -1095,25 +1248,25 @@ public:
 };
 
 template <typename KeyType, typename ValueType>
-Map<KeyType, ValueType>::Map() : root(nullptr), nodeCount(0) {
+Map<KeyType, ValueType>::Map() : root(nullptr), nodeCount(0), defaultLess(true) {
     cmpp = new TemplateComparator<std::less<KeyType> >(std::less<KeyType>());
 }
 
 template <typename KeyType, typename ValueType>
 Map<KeyType, ValueType>::Map(bool lessFunc(KeyType, KeyType))
-        : root(nullptr), nodeCount(0) {
+        : root(nullptr), nodeCount(0), defaultLess(false) {
     cmpp = new FunctionComparator((void*) lessFunc);
 }
 
 template <typename KeyType, typename ValueType>
 Map<KeyType, ValueType>::Map(bool lessFunc(const KeyType&, const KeyType&))
-        : root(nullptr), nodeCount(0) {
+        : root(nullptr), nodeCount(0), defaultLess(false) {
     cmpp = new FunctionConstRefComparator((void*) lessFunc);
 }
 
 template <typename KeyType, typename ValueType>
 Map<KeyType, ValueType>::Map(std::initializer_list<std::pair<KeyType, ValueType> > list)
-        : root(nullptr), nodeCount(0) {
+        : root(nullptr), nodeCount(0), defaultLess(true) {
     cmpp = new TemplateComparator<std::less<KeyType> >(std::less<KeyType>());
     putAll(list);
 }
@@ -1121,7 +1274,7 @@ Map<KeyType, ValueType>::Map(std::initializer_list<std::pair<KeyType, ValueType>
 template <typename KeyType, typename ValueType>
 Map<KeyType, ValueType>::Map(std::initializer_list<std::pair<KeyType, ValueType> > list,
                              bool lessFunc(KeyType, KeyType))
-        : root(nullptr), nodeCount(0) {
+        : root(nullptr), nodeCount(0), defaultLess(false) {
     cmpp = new FunctionComparator((void*) lessFunc);
     putAll(list);
 }
@@ -1129,7 +1282,7 @@ Map<KeyType, ValueType>::Map(std::initializer_list<std::pair<KeyType, ValueType>
 template <typename KeyType, typename ValueType>
 Map<KeyType, ValueType>::Map(std::initializer_list<std::pair<KeyType, ValueType> > list,
                              bool lessFunc(const KeyType&, const KeyType&))
-        : root(nullptr), nodeCount(0) {
+        : root(nullptr), nodeCount(0), defaultLess(false) {
     cmpp = new FunctionConstRefComparator((void*) lessFunc);
     putAll(list);
 }
@@ -1185,6 +1338,13 @@ bool Map<KeyType, ValueType>::containsKey(const KeyType& key) const {
     return findNode(root, key) != nullptr;
 }
 
+template <typename KeyType, typename ValueType>
+template <typename K>
+typename std::enable_if<stanfordcpplib::collections::IsStringViewLookup<KeyType, K>::value, bool>::type
+Map<KeyType, ValueType>::containsKey(const K& key) const {
+    return findStringNode(StringView(key)) != nullptr;
+}
+
 template <typename KeyType, typename ValueType>
 bool Map<KeyType, ValueType>::equals(const Map<KeyType, ValueType>& map2) const {
     return stanfordcpplib::collections::equalsMap(*this, map2);
@@ -1207,6 +1367,17 @@ ValueType Map<KeyType, ValueType>::get(const KeyType& key) const {
     return *vp;
 }
 
+template <typename KeyType, typename ValueType>
+template <typename K>
+typename std::enable_if<stanfordcpplib::collections::IsStringViewLookup<KeyType, K>::value, ValueType>::type
+Map<KeyType, ValueType>::get(const K& key) const {
+    ValueType* vp = findStringNode(StringView(key));
+    if (!vp) {
+        return ValueType();
+    }
+    return *vp;
+}
+
 template <typename KeyType, typename ValueType>
 bool Map<KeyType, ValueType>::isEmpty() const {
     return nodeCount == 0;
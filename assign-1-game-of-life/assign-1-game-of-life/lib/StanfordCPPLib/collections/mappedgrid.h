@@ -0,0 +1,683 @@
+/*
+ * File: mappedgrid.h
+ * ------------------
+ * This file exports the <code>MappedGrid</code> class, a two-dimensional
+ * array whose cells live in a file rather than in memory allocated by the
+ * program.  The file is mapped into the program's address space, so
+ * opening even a very large grid takes almost no time: the operating system
+ * reads each page of the file only when a cell on it is first used, and
+ * can drop pages again when memory runs short.  Several programs that map
+ * the same file share a single copy of it in memory.
+ *
+ * The file starts with a small header recording the grid's dimensions and
+ * element type, followed by the cells in row-major order.  Only element
+ * types that can be copied byte for byte (numbers, bool, and plain structs
+ * of them) can be stored this way.
+ *
+ * @version 2026/10/16
+ * - initial version
+ */
+
+#include "private/init.h"   // ensure that Stanford C++ lib is initialized
+
+#ifndef INTERNAL_INCLUDE
+#include "private/initstudent.h"   // insert necessary included code by student
+#endif // INTERNAL_INCLUDE
+
+#ifndef _mappedgrid_h
+#define _mappedgrid_h
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+#define INTERNAL_INCLUDE 1
+#include "error.h"
+#define INTERNAL_INCLUDE 1
+#include "grid.h"
+#undef INTERNAL_INCLUDE
+
+/*
+ * Type: MappedGridMode
+ * --------------------
+ * How a MappedGrid maps its file:
+ *
+ *   - MAPPED_READ_ONLY: the cells can be read but not changed.
+ *   - MAPPED_COPY_ON_WRITE: the cells can be changed, but the changes are
+ *     private to this grid; the file and other programs never see them.
+ *     Only the pages that are actually changed take up memory of their own.
+ *   - MAPPED_SHARED: changes are written back to the file and are seen at
+ *     once by every other program that has the file mapped shared.
+ */
+enum MappedGridMode {
+    MAPPED_READ_ONLY,
+    MAPPED_COPY_ON_WRITE,
+    MAPPED_SHARED
+};
+
+namespace stanfordcpplib {
+namespace collections {
+
+/*
+ * A file mapped into memory in its entirety.  This is the platform-specific
+ * part of MappedGrid; its methods signal errors when the file cannot be
+ * opened or mapped.
+ */
+class MappedFile {
+public:
+    MappedFile();
+    virtual ~MappedFile();
+
+    /*
+     * Maps the whole of an existing file in the given mode.
+     */
+    void open(const std::string& filename, MappedGridMode mode);
+
+    /*
+     * Creates the file, or truncates it if it exists, sets its size, and
+     * maps it shared.  The new contents are all zero bytes; where the file
+     * system allows, they take no disk space until they are written.
+     */
+    void create(const std::string& filename, int64_t size);
+
+    /*
+     * Unmaps the file, if one is mapped.
+     */
+    void close();
+
+    /*
+     * Writes any changes to a shared mapping back to the file.
+     */
+    void flush();
+
+    /*
+     * Asks the operating system to start reading the given byte range of
+     * the file in the background.  This is only a hint.
+     */
+    void prefetch(int64_t offset, int64_t length);
+
+    char* data() const;
+    int64_t size() const;
+
+private:
+    char* address;
+    int64_t length;
+#ifdef _WIN32
+    void* fileHandle = nullptr;     /* HANDLEs of the file and its mapping */
+    void* mappingHandle = nullptr;
+#endif // _WIN32
+
+    // forbid copying
+    MappedFile(const MappedFile&);
+    MappedFile& operator =(const MappedFile&);
+};
+
+/*
+ * The header at the start of a mapped grid file.  The cells start
+ * headerSize bytes into the file.  All of the fields are in the byte order
+ * of the machine that wrote the file; byteOrder lets a reader on a machine
+ * of the other order notice.
+ */
+struct MappedGridHeader {
+    char magic[8];           /* "SPLGRID" and a zero byte        */
+    uint32_t version;        /* 1                                */
+    uint32_t byteOrder;      /* 0x01020304                       */
+    uint32_t elementKind;    /* one of the kinds below           */
+    uint32_t elementSize;    /* sizeof the element type          */
+    int64_t numRows;
+    int64_t numCols;
+    uint32_t headerSize;     /* sizeof(MappedGridHeader)         */
+    char reserved[20];
+};
+
+const uint32_t kMappedGridVersion = 1;
+const uint32_t kMappedGridByteOrder = 0x01020304;
+
+/*
+ * Element kinds, recorded so that a file of (say) floats is not opened as
+ * a grid of ints of the same size.
+ */
+const uint32_t kMappedOtherKind = 0;
+const uint32_t kMappedSignedKind = 1;
+const uint32_t kMappedUnsignedKind = 2;
+const uint32_t kMappedFloatKind = 3;
+const uint32_t kMappedBoolKind = 4;
+
+template <typename T>
+uint32_t mappedElementKind() {
+    if (std::is_same<T, bool>::value) {
+        return kMappedBoolKind;
+    } else if (std::is_floating_point<T>::value) {
+        return kMappedFloatKind;
+    } else if (std::is_integral<T>::value) {
+        return std::is_signed<T>::value ? kMappedSignedKind : kMappedUnsignedKind;
+    } else {
+        return kMappedOtherKind;
+    }
+}
+
+} // namespace collections
+} // namespace stanfordcpplib
+
+/*
+ * Class: MappedGrid<ValueType>
+ * ----------------------------
+ * A grid whose cells are stored in a file mapped into memory.  The
+ * following code, for example, makes a 100000 x 100000 grid of bytes on
+ * disk and then opens it to change one cell:
+ *
+ *<pre>
+ *    MappedGrid&lt;unsigned char&gt;::create("big.grid", 100000, 100000);
+ *    MappedGrid&lt;unsigned char&gt; grid("big.grid", MAPPED_SHARED);
+ *    grid[5000][70000] = 1;
+ *</pre>
+ *
+ * The interface follows that of Grid, except that a MappedGrid cannot be
+ * resized, copied, or assigned.  A grid opened MAPPED_READ_ONLY signals an
+ * error from set and from non-const <code>grid[row][col]</code>; read its
+ * cells with get or through a const reference.
+ */
+template <typename ValueType>
+class MappedGrid {
+    static_assert(std::is_trivially_copyable<ValueType>::value,
+                  "MappedGrid: element type must be trivially copyable");
+
+public:
+    /* Forward reference */
+    class GridRow;
+    class GridRowConst;
+
+    /*
+     * Constructor: MappedGrid
+     * Usage: MappedGrid<ValueType> grid;
+     *        MappedGrid<ValueType> grid(filename, mode);
+     * --------------------------------------------------
+     * Makes a grid with no file open, or opens the given file as if by
+     * <code>open</code>.
+     */
+    MappedGrid();
+    MappedGrid(const std::string& filename, MappedGridMode mode = MAPPED_READ_ONLY);
+
+    /*
+     * Destructor: ~MappedGrid
+     * -----------------------
+     * Closes the file.  Changes to a shared grid are written back by the
+     * operating system, but call flush first to be sure they reach the disk.
+     */
+    virtual ~MappedGrid();
+
+    /*
+     * Method: create
+     * Usage: MappedGrid<ValueType>::create(filename, nRows, nCols);
+     * -------------------------------------------------------------
+     * Creates a grid file of the given dimensions with every cell zero,
+     * replacing any file of that name.  Open it to use it.
+     */
+    static void create(const std::string& filename, int nRows, int nCols);
+
+    /*
+     * Method: save
+     * Usage: MappedGrid<ValueType>::save(grid, filename);
+     * ---------------------------------------------------
+     * Creates a grid file holding a copy of the given grid.
+     */
+    static void save(const Grid<ValueType>& grid, const std::string& filename);
+
+    /*
+     * Method: open
+     * Usage: grid.open(filename, mode);
+     * ---------------------------------
+     * Maps the given grid file in the given mode, closing any file that was
+     * open before.  No cells are read until they are used.  This method
+     * signals an error if the file cannot be opened or is not a grid file
+     * of this element type.
+     */
+    void open(const std::string& filename, MappedGridMode mode = MAPPED_READ_ONLY);
+
+    /*
+     * Method: close
+     * Usage: grid.close();
+     * --------------------
+     * Unmaps the file, leaving the grid empty.
+     */
+    void close();
+
+    /*
+     * Method: flush
+     * Usage: grid.flush();
+     * --------------------
+     * Writes any changes to a MAPPED_SHARED grid through to the file before
+     * returning.  Other modes have nothing to write.
+     */
+    void flush();
+
+    /*
+     * Method: prefetchRows
+     * Usage: grid.prefetchRows(firstRow, lastRow);
+     * --------------------------------------------
+     * Hints that rows firstRow through lastRow - 1 will be needed soon, so
+     * the operating system can start reading them in the background.
+     */
+    void prefetchRows(int firstRow, int lastRow);
+
+    /*
+     * Method: data
+     * Usage: ValueType* cells = grid.data();
+     * --------------------------------------
+     * Returns a pointer to cell (0, 0); the cells follow in row-major
+     * order, numCols() to a row.  Nothing done through the pointer is
+     * checked, and writing through it on a read-only grid crashes.
+     */
+    ValueType* data();
+    const ValueType* data() const;
+
+    ValueType get(int row, int col) const;
+    ValueType get(const GridLocation& loc) const;
+    int height() const;
+    bool inBounds(int row, int col) const;
+    bool inBounds(const GridLocation& loc) const;
+    bool isEmpty() const;
+    bool isOpen() const;
+    GridLocationRange locations(bool rowMajor = true) const;
+    MappedGridMode mode() const;
+    int numCols() const;
+    int numRows() const;
+    void set(int row, int col, const ValueType& value);
+    void set(const GridLocation& loc, const ValueType& value);
+
+    /*
+     * Method: size
+     * Usage: int64_t n = grid.size();
+     * -------------------------------
+     * Returns the number of cells in the grid, which for a mapped grid may
+     * be more than an int can hold.
+     */
+    int64_t size() const;
+
+    /*
+     * Method: toGrid
+     * Usage: Grid<ValueType> copy = grid.toGrid();
+     * --------------------------------------------
+     * Returns an ordinary in-memory Grid holding a copy of the cells.
+     */
+    Grid<ValueType> toGrid() const;
+
+    int width() const;
+
+    GridRow operator [](int row);
+    const GridRowConst operator [](int row) const;
+
+    /* Private section */
+
+    /**********************************************************************/
+    /* Note: Everything below this point in the file is logically part    */
+    /* of the implementation and should not be of interest to clients.    */
+    /**********************************************************************/
+
+private:
+    typedef stanfordcpplib::collections::MappedGridHeader Header;
+
+    /* Instance variables */
+    stanfordcpplib::collections::MappedFile file;
+    ValueType* elements;  /* Cell (0, 0), just past the header in the file */
+    int nRows;
+    int nCols;
+    MappedGridMode mapMode;
+
+    void checkIndexes(int row, int col, const char* prefix) const;
+    void checkWritable(const char* prefix) const;
+
+    /*
+     * Returns the index of cell (row, col) in elements.  Mapped grids can
+     * hold more cells than an int can count, so the index is 64-bit.
+     */
+    int64_t offset(int row, int col) const {
+        return (static_cast<int64_t>(row) * nCols) + col;
+    }
+    static void makeHeader(Header& header, int nRows, int nCols);
+
+    // forbid copying
+    MappedGrid(const MappedGrid&);
+    MappedGrid& operator =(const MappedGrid&);
+
+public:
+    ValueType* begin() {
+        return elements;
+    }
+
+    ValueType* end() {
+        return elements + size();
+    }
+
+    const ValueType* begin() const {
+        return elements;
+    }
+
+    const ValueType* end() const {
+        return elements + size();
+    }
+
+    class GridRow {
+    public:
+        ValueType& operator [](int col) {
+            gp->checkIndexes(row, col, "operator [][]");
+            return gp->elements[gp->offset(row, col)];
+        }
+
+        int size() const {
+            return gp->nCols;
+        }
+
+    private:
+        GridRow(MappedGrid* gridRef, int index) : gp(gridRef), row(index) {}
+
+        MappedGrid* gp;
+        int row;
+        friend class MappedGrid;
+    };
+    friend class GridRow;
+
+    class GridRowConst {
+    public:
+        ValueType operator [](int col) const {
+            return gp->get(row, col);
+        }
+
+        int size() const {
+            return gp->nCols;
+        }
+
+    private:
+        GridRowConst(const MappedGrid* gridRef, int index) : gp(gridRef), row(index) {}
+
+        const MappedGrid* const gp;
+        const int row;
+        friend class MappedGrid;
+    };
+    friend class GridRowConst;
+};
+
+template <typename ValueType>
+MappedGrid<ValueType>::MappedGrid()
+        : elements(nullptr),
+          nRows(0),
+          nCols(0),
+          mapMode(MAPPED_READ_ONLY) {
+    // empty
+}
+
+template <typename ValueType>
+MappedGrid<ValueType>::MappedGrid(const std::string& filename, MappedGridMode mode)
+        : elements(nullptr),
+          nRows(0),
+          nCols(0),
+          mapMode(MAPPED_READ_ONLY) {
+    open(filename, mode);
+}
+
+template <typename ValueType>
+MappedGrid<ValueType>::~MappedGrid() {
+    // the MappedFile unmaps itself
+}
+
+template <typename ValueType>
+void MappedGrid<ValueType>::makeHeader(Header& header, int numRows, int numCols) {
+    if (numRows < 0 || numCols < 0) {
+        std::ostringstream out;
+        out << "MappedGrid::create: invalid grid size ("
+            << numRows << ", " << numCols << ")";
+        error(out.str());
+    }
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "SPLGRID", 8);
+    header.version = stanfordcpplib::collections::kMappedGridVersion;
+    header.byteOrder = stanfordcpplib::collections::kMappedGridByteOrder;
+    header.elementKind = stanfordcpplib::collections::mappedElementKind<ValueType>();
+    header.elementSize = sizeof(ValueType);
+    header.numRows = numRows;
+    header.numCols = numCols;
+    header.headerSize = sizeof(Header);
+}
+
+template <typename ValueType>
+void MappedGrid<ValueType>::create(const std::string& filename, int numRows, int numCols) {
+    Header header;
+    makeHeader(header, numRows, numCols);
+    stanfordcpplib::collections::MappedFile newFile;
+    newFile.create(filename, static_cast<int64_t>(sizeof(Header))
+                   + static_cast<int64_t>(numRows) * numCols * sizeof(ValueType));
+    std::memcpy(newFile.data(), &header, sizeof(header));
+}
+
+template <typename ValueType>
+void MappedGrid<ValueType>::save(const Grid<ValueType>& grid, const std::string& filename) {
+    Header header;
+    makeHeader(header, grid.numRows(), grid.numCols());
+    stanfordcpplib::collections::MappedFile newFile;
+    newFile.create(filename, static_cast<int64_t>(sizeof(Header))
+                   + static_cast<int64_t>(grid.size()) * sizeof(ValueType));
+    std::memcpy(newFile.data(), &header, sizeof(header));
+    ValueType* cells = reinterpret_cast<ValueType*>(newFile.data() + sizeof(Header));
+    for (int row = 0; row < grid.numRows(); row++) {
+        for (int col = 0; col < grid.numCols(); col++) {
+            *cells++ = grid.get(row, col);
+        }
+    }
+}
+
+/*
+ * Implementation notes: open
+ * --------------------------
+ * The header is checked field by field so that a file that is damaged,
+ * truncated, written on a machine of the other byte order, or made for a
+ * different element type is refused with a message saying which, rather
+ * than read as garbage.
+ */
+template <typename ValueType>
+void MappedGrid<ValueType>::open(const std::string& filename, MappedGridMode mode) {
+    close();
+    file.open(filename, mode);
+    std::string problem;
+    Header header;
+    if (file.size() < static_cast<int64_t>(sizeof(Header))) {
+        problem = "file is too short to be a grid file";
+    } else {
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.magic, "SPLGRID", 8) != 0) {
+            problem = "not a grid file";
+        } else if (header.version != stanfordcpplib::collections::kMappedGridVersion) {
+            problem = "unsupported grid file version";
+        } else if (header.byteOrder != stanfordcpplib::collections::kMappedGridByteOrder) {
+            problem = "grid file was written with a different byte order";
+        } else if (header.elementKind != stanfordcpplib::collections::mappedElementKind<ValueType>()
+                   || header.elementSize != sizeof(ValueType)) {
+            problem = "grid file holds a different element type";
+        } else if (header.numRows < 0 || header.numCols < 0
+                   || header.numRows > INT_MAX || header.numCols > INT_MAX
+                   || header.headerSize < sizeof(Header)
+                   || header.headerSize % alignof(ValueType) != 0) {
+            problem = "grid file header is damaged";
+        } else if (file.size() < header.headerSize
+                   || (header.numCols != 0 && header.numRows > (file.size() - header.headerSize)
+                       / static_cast<int64_t>(sizeof(ValueType)) / header.numCols)) {
+            problem = "grid file is truncated";
+        }
+    }
+    if (!problem.empty()) {
+        file.close();
+        error("MappedGrid::open: " + filename + ": " + problem);
+    }
+    elements = reinterpret_cast<ValueType*>(file.data() + header.headerSize);
+    nRows = static_cast<int>(header.numRows);
+    nCols = static_cast<int>(header.numCols);
+    mapMode = mode;
+}
+
+template <typename ValueType>
+void MappedGrid<ValueType>::close() {
+    file.close();
+    elements = nullptr;
+    nRows = 0;
+    nCols = 0;
+    mapMode = MAPPED_READ_ONLY;
+}
+
+template <typename ValueType>
+ValueType* MappedGrid<ValueType>::data() {
+    return elements;
+}
+
+template <typename ValueType>
+const ValueType* MappedGrid<ValueType>::data() const {
+    return elements;
+}
+
+template <typename ValueType>
+void MappedGrid<ValueType>::flush() {
+    if (mapMode == MAPPED_SHARED) {
+        file.flush();
+    }
+}
+
+template <typename ValueType>
+ValueType MappedGrid<ValueType>::get(int row, int col) const {
+    checkIndexes(row, col, "get");
+    return elements[offset(row, col)];
+}
+
+template <typename ValueType>
+ValueType MappedGrid<ValueType>::get(const GridLocation& loc) const {
+    return get(loc.row, loc.col);
+}
+
+template <typename ValueType>
+int MappedGrid<ValueType>::height() const {
+    return nRows;
+}
+
+template <typename ValueType>
+bool MappedGrid<ValueType>::inBounds(int row, int col) const {
+    return row >= 0 && col >= 0 && row < nRows && col < nCols;
+}
+
+template <typename ValueType>
+bool MappedGrid<ValueType>::inBounds(const GridLocation& loc) const {
+    return inBounds(loc.row, loc.col);
+}
+
+template <typename ValueType>
+bool MappedGrid<ValueType>::isEmpty() const {
+    return nRows == 0 || nCols == 0;
+}
+
+template <typename ValueType>
+bool MappedGrid<ValueType>::isOpen() const {
+    return file.data() != nullptr;
+}
+
+template <typename ValueType>
+GridLocationRange MappedGrid<ValueType>::locations(bool rowMajor) const {
+    return GridLocationRange(0, 0, nRows - 1, nCols - 1, rowMajor);
+}
+
+template <typename ValueType>
+MappedGridMode MappedGrid<ValueType>::mode() const {
+    return mapMode;
+}
+
+template <typename ValueType>
+int MappedGrid<ValueType>::numCols() const {
+    return nCols;
+}
+
+template <typename ValueType>
+int MappedGrid<ValueType>::numRows() const {
+    return nRows;
+}
+
+template <typename ValueType>
+void MappedGrid<ValueType>::prefetchRows(int firstRow, int lastRow) {
+    if (firstRow < 0) {
+        firstRow = 0;
+    }
+    if (lastRow > nRows) {
+        lastRow = nRows;
+    }
+    if (firstRow < lastRow) {
+        int64_t rowBytes = static_cast<int64_t>(nCols) * sizeof(ValueType);
+        int64_t start = reinterpret_cast<char*>(elements) - file.data();
+        file.prefetch(start + firstRow * rowBytes, (lastRow - firstRow) * rowBytes);
+    }
+}
+
+template <typename ValueType>
+void MappedGrid<ValueType>::set(int row, int col, const ValueType& value) {
+    checkIndexes(row, col, "set");
+    checkWritable("set");
+    elements[offset(row, col)] = value;
+}
+
+template <typename ValueType>
+void MappedGrid<ValueType>::set(const GridLocation& loc, const ValueType& value) {
+    set(loc.row, loc.col, value);
+}
+
+template <typename ValueType>
+int64_t MappedGrid<ValueType>::size() const {
+    return static_cast<int64_t>(nRows) * nCols;
+}
+
+template <typename ValueType>
+Grid<ValueType> MappedGrid<ValueType>::toGrid() const {
+    Grid<ValueType> grid(nRows, nCols);
+    for (int row = 0; row < nRows; row++) {
+        const ValueType* cur = elements + offset(row, 0);
+        for (int col = 0; col < nCols; col++) {
+            grid.set(row, col, cur[col]);
+        }
+    }
+    return grid;
+}
+
+template <typename ValueType>
+int MappedGrid<ValueType>::width() const {
+    return nCols;
+}
+
+template <typename ValueType>
+typename MappedGrid<ValueType>::GridRow MappedGrid<ValueType>::operator [](int row) {
+    checkWritable("operator [][]");
+    return GridRow(this, row);
+}
+
+template <typename ValueType>
+const typename MappedGrid<ValueType>::GridRowConst
+MappedGrid<ValueType>::operator [](int row) const {
+    return GridRowConst(this, row);
+}
+
+template <typename ValueType>
+void MappedGrid<ValueType>::checkIndexes(int row, int col, const char* prefix) const {
+    if (row < 0 || row >= nRows || col < 0 || col >= nCols) {
+        std::ostringstream out;
+        out << "MappedGrid::" << prefix << ": (" << row << ", " << col << ")"
+            << " is outside of valid range [";
+        if (nRows > 0 && nCols > 0) {
+            out << "(0, 0)..(" << (nRows - 1) << ", " << (nCols - 1) << ")";
+        } // else empty grid, no range
+        out << "]";
+        error(out.str());
+    }
+}
+
+template <typename ValueType>
+void MappedGrid<ValueType>::checkWritable(const char* prefix) const {
+    if (mapMode == MAPPED_READ_ONLY) {
+        error(std::string("MappedGrid::") + prefix + ": grid is open read-only");
+    }
+}
+
+#endif // _mappedgrid_h
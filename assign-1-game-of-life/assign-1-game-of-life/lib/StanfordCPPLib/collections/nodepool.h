@@ -0,0 +1,182 @@
+/*
+ * File: nodepool.h
+ * ----------------
+ * This file exports the <code>NodePool</code> class, which node-based
+ * collections use to allocate their nodes in large slabs instead of one
+ * <code>new</code> per node.
+ *
+ * @version 2026/10/17
+ * - initial version
+ */
+
+#include "private/init.h"   // ensure that Stanford C++ lib is initialized
+
+#ifndef INTERNAL_INCLUDE
+#include "private/initstudent.h"   // insert necessary included code by student
+#endif // INTERNAL_INCLUDE
+
+#ifndef _nodepool_h
+#define _nodepool_h
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace stanfordcpplib {
+namespace collections {
+
+/*
+ * Class: NodePool<NodeType>
+ * -------------------------
+ * A per-container arena of nodes.  Nodes are carved out of slabs by
+ * bumping a pointer, and a released node goes onto a free list for the
+ * next allocation to reuse.  releaseAll gives back every node at once
+ * without visiting them, which is all a container has to do to clear
+ * itself when its nodes are trivially destructible; otherwise it calls
+ * destroy on each live node first.
+ *
+ * Slabs start small and double in size up to MAX_SLAB_NODES nodes, so
+ * small containers stay small and big ones need only a few slabs.
+ * A pool belongs to one container and is never copied.
+ */
+template <typename NodeType>
+class NodePool {
+public:
+    NodePool()
+            : slabs(nullptr),
+              next(nullptr),
+              limit(nullptr),
+              freeList(nullptr),
+              nextSlabNodes(MIN_SLAB_NODES) {
+        // empty; the first slab is allocated on the first allocation
+    }
+
+    ~NodePool() {
+        freeSlabs(nullptr);
+    }
+
+    /*
+     * Returns a new value-initialized node.
+     */
+    NodeType* allocate() {
+        void* storage;
+        if (freeList) {
+            storage = freeList;
+            freeList = freeList->next;
+        } else {
+            if (next == limit) {
+                addSlab();
+            }
+            storage = next;
+            next += sizeof(NodeType);
+        }
+        return new (storage) NodeType();
+    }
+
+    /*
+     * Destroys the given node and makes its storage available again.
+     */
+    void release(NodeType* node) {
+        node->~NodeType();
+        FreeNode* freed = reinterpret_cast<FreeNode*>(node);
+        freed->next = freeList;
+        freeList = freed;
+    }
+
+    /*
+     * Runs the destructor of the given node without reclaiming its storage,
+     * for use on every live node just before releaseAll.
+     */
+    static void destroy(NodeType* node) {
+        node->~NodeType();
+    }
+
+    /*
+     * Reclaims every node at once without running any destructors.  The
+     * largest slab is kept for the container to refill.
+     */
+    void releaseAll() {
+        freeList = nullptr;
+        if (slabs) {
+            freeSlabs(slabs);
+            slabs->previous = nullptr;
+            next = firstNode(slabs);
+        }
+    }
+
+    /*
+     * Returns true if nodes must be destroyed one by one before releaseAll.
+     */
+    static bool needsDestroy() {
+        return !std::is_trivially_destructible<NodeType>::value;
+    }
+
+private:
+    static const size_t MIN_SLAB_NODES = 16;
+    static const size_t MAX_SLAB_NODES = 4096;
+
+    /* Header at the front of each slab; the slabs form a list, newest first */
+    struct Slab {
+        Slab* previous;
+    };
+
+    /* Overlays a released node while it sits on the free list */
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    static_assert(sizeof(NodeType) >= sizeof(FreeNode),
+                  "NodePool nodes must be at least as large as a pointer");
+
+    Slab* slabs;          // newest (and largest) slab
+    char* next;           // next unused node in the newest slab
+    char* limit;          // end of the newest slab
+    FreeNode* freeList;   // released nodes available for reuse
+    size_t nextSlabNodes; // size of the next slab to allocate
+
+    static size_t headerSize() {
+        return (sizeof(Slab) + alignof(NodeType) - 1) / alignof(NodeType) * alignof(NodeType);
+    }
+
+    static char* firstNode(Slab* slab) {
+        return reinterpret_cast<char*>(slab) + headerSize();
+    }
+
+    void addSlab() {
+        size_t numNodes = nextSlabNodes;
+        Slab* slab = static_cast<Slab*>(::operator new(headerSize() + numNodes * sizeof(NodeType)));
+        slab->previous = slabs;
+        slabs = slab;
+        next = firstNode(slab);
+        limit = next + numNodes * sizeof(NodeType);
+        if (nextSlabNodes < MAX_SLAB_NODES) {
+            nextSlabNodes *= 2;
+        }
+    }
+
+    /*
+     * Frees every slab older than the given one, or all of them if it is
+     * null.
+     */
+    void freeSlabs(Slab* keep) {
+        Slab* slab = keep ? keep->previous : slabs;
+        while (slab) {
+            Slab* previous = slab->previous;
+            ::operator delete(slab);
+            slab = previous;
+        }
+        if (!keep) {
+            slabs = nullptr;
+            next = limit = nullptr;
+        }
+    }
+
+    // forbid copying
+    NodePool(const NodePool&);
+    NodePool& operator =(const NodePool&);
+};
+
+} // namespace collections
+} // namespace stanfordcpplib
+
+#endif // _nodepool_h
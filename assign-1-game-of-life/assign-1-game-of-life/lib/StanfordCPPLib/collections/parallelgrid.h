@@ -0,0 +1,372 @@
+/*
+ * File: parallelgrid.h
+ * --------------------
+ * This file exports parallel versions of whole-grid operations.  Each one
+ * splits the grid into bands of rows and hands the bands to the shared
+ * ThreadPool, so it speeds up with the number of cores without the client
+ * writing any threading code.
+ *
+ * Every cell is processed exactly once, by a function that sees only that
+ * cell (and, for stencils, its neighbours in the source grid), so the
+ * results are the same as those of the corresponding serial loop.  The
+ * functions passed in may be called on several threads at once and must
+ * not modify anything they share without synchronization.
+ *
+ * @version 2026/10/17
+ * - added parallelForEach over a GridLocationRange
+ * - parallelForEach and parallelTransform accept grids of bool, which they
+ *   read and write a packed word at a time, and grids of any other layout
+ * - parallelStencil3x3 rejects grids without a border at compile time
+ * @version 2026/10/16
+ * - initial version
+ */
+
+#include "private/init.h"   // ensure that Stanford C++ lib is initialized
+
+#ifndef INTERNAL_INCLUDE
+#include "private/initstudent.h"   // insert necessary included code by student
+#endif // INTERNAL_INCLUDE
+
+#ifndef _parallelgrid_h
+#define _parallelgrid_h
+
+#include <type_traits>
+
+#define INTERNAL_INCLUDE 1
+#include "error.h"
+#define INTERNAL_INCLUDE 1
+#include "grid.h"
+#define INTERNAL_INCLUDE 1
+#include "gridlocation.h"
+#define INTERNAL_INCLUDE 1
+#include "threadpool.h"
+#undef INTERNAL_INCLUDE
+
+namespace stanfordcpplib {
+namespace collections {
+
+/*
+ * The smallest band worth handing to another thread, in cells; narrower
+ * grids get proportionally taller bands.
+ */
+const int kParallelMinCellsPerBand = 16384;
+
+inline int parallelMinRowsPerBand(int numCols) {
+    return numCols <= 0 ? 1 : (kParallelMinCellsPerBand + numCols - 1) / numCols;
+}
+
+/*
+ * Classes: ParallelCells, ParallelConstCells
+ * ------------------------------------------
+ * Access to the cells of a grid from inside a band, in whatever way suits
+ * the grid's layout.  ParallelConstCells reads cells with get(row, col);
+ * ParallelCells calls fn(cell) on each cell of a row in turn (update) or
+ * stores cellFn(col) into each one (assign).  They are made once, on the
+ * calling thread, because the non-const accessors of a grid count each
+ * call in the grid's version and so cannot be called from several threads
+ * at once.
+ *
+ * The general versions, used for layouts such as TiledLayout, go through
+ * the grid's get, writing through the reference it returns rather than
+ * through set or operator [] for the same reason.
+ */
+template <typename ValueType, typename Layout>
+class ParallelConstCells {
+public:
+    explicit ParallelConstCells(const Grid<ValueType, Layout>& grid) : grid(grid) {}
+
+    const ValueType& get(int row, int col) const {
+        return grid.get(row, col);
+    }
+
+private:
+    const Grid<ValueType, Layout>& grid;
+};
+
+template <typename ValueType, typename Layout>
+class ParallelCells {
+public:
+    explicit ParallelCells(Grid<ValueType, Layout>& grid) : grid(grid) {}
+
+    template <typename FunctorType>
+    void update(int row, const FunctorType& fn) const {
+        for (int col = 0; col < grid.numCols(); col++) {
+            fn(cell(row, col));
+        }
+    }
+
+    template <typename CellFunctorType>
+    void assign(int row, const CellFunctorType& cellFn) const {
+        for (int col = 0; col < grid.numCols(); col++) {
+            cell(row, col) = cellFn(col);
+        }
+    }
+
+private:
+    const Grid<ValueType, Layout>& grid;
+
+    ValueType& cell(int row, int col) const {
+        return const_cast<ValueType&>(grid.get(row, col));
+    }
+};
+
+/*
+ * Row-major grids are read and written through data() and pitch().
+ */
+template <typename ValueType>
+class ParallelConstCells<ValueType, RowMajorLayout> {
+public:
+    explicit ParallelConstCells(const Grid<ValueType>& grid)
+            : cells(grid.data()),
+              pitch(grid.pitch()) {}
+
+    const ValueType& get(int row, int col) const {
+        return cells[row * pitch + col];
+    }
+
+private:
+    const ValueType* cells;
+    int pitch;
+};
+
+template <typename ValueType>
+class ParallelCells<ValueType, RowMajorLayout> {
+public:
+    explicit ParallelCells(Grid<ValueType>& grid)
+            : cells(grid.data()),
+              pitch(grid.pitch()),
+              numCols(grid.numCols()) {}
+
+    template <typename FunctorType>
+    void update(int row, const FunctorType& fn) const {
+        ValueType* cur = cells + row * pitch;
+        for (int col = 0; col < numCols; col++) {
+            fn(cur[col]);
+        }
+    }
+
+    template <typename CellFunctorType>
+    void assign(int row, const CellFunctorType& cellFn) const {
+        ValueType* cur = cells + row * pitch;
+        for (int col = 0; col < numCols; col++) {
+            cur[col] = cellFn(col);
+        }
+    }
+
+private:
+    ValueType* cells;
+    int pitch;
+    int numCols;
+};
+
+/*
+ * Grids of bool are read through rowWords and written a whole word at a
+ * time, so that threads working on different rows never share a word.
+ * Writes leave the bits past the last column zero, as rowWords requires.
+ */
+template <>
+class ParallelConstCells<bool, RowMajorLayout> {
+public:
+    explicit ParallelConstCells(const Grid<bool>& grid)
+            : words(grid.isEmpty() ? nullptr : grid.rowWords(0)),
+              wordsPerRow(grid.wordsPerRow()) {}
+
+    bool get(int row, int col) const {
+        Grid<bool>::WordType word = words[row * wordsPerRow + col / Grid<bool>::kBitsPerWord];
+        return (word >> (col % Grid<bool>::kBitsPerWord)) & 1;
+    }
+
+private:
+    const Grid<bool>::WordType* words;
+    int wordsPerRow;
+};
+
+template <>
+class ParallelCells<bool, RowMajorLayout> {
+public:
+    explicit ParallelCells(Grid<bool>& grid)
+            : words(grid.isEmpty() ? nullptr : grid.rowWords(0)),
+              wordsPerRow(grid.wordsPerRow()),
+              numCols(grid.numCols()) {}
+
+    template <typename FunctorType>
+    void update(int row, const FunctorType& fn) const {
+        Grid<bool>::WordType* cur = words + row * wordsPerRow;
+        for (int first = 0; first < numCols; first += Grid<bool>::kBitsPerWord) {
+            Grid<bool>::WordType word = cur[first / Grid<bool>::kBitsPerWord];
+            Grid<bool>::WordType result = 0;
+            for (int bit = 0; bit < bitsInWordAt(first); bit++) {
+                bool value = (word >> bit) & 1;
+                fn(value);
+                result |= Grid<bool>::WordType(value) << bit;
+            }
+            cur[first / Grid<bool>::kBitsPerWord] = result;
+        }
+    }
+
+    template <typename CellFunctorType>
+    void assign(int row, const CellFunctorType& cellFn) const {
+        Grid<bool>::WordType* cur = words + row * wordsPerRow;
+        for (int first = 0; first < numCols; first += Grid<bool>::kBitsPerWord) {
+            Grid<bool>::WordType result = 0;
+            for (int bit = 0; bit < bitsInWordAt(first); bit++) {
+                bool value = cellFn(first + bit);
+                result |= Grid<bool>::WordType(value) << bit;
+            }
+            cur[first / Grid<bool>::kBitsPerWord] = result;
+        }
+    }
+
+private:
+    Grid<bool>::WordType* words;
+    int wordsPerRow;
+    int numCols;
+
+    int bitsInWordAt(int first) const {
+        return numCols - first < Grid<bool>::kBitsPerWord ? numCols - first : Grid<bool>::kBitsPerWord;
+    }
+};
+
+} // namespace collections
+} // namespace stanfordcpplib
+
+/*
+ * Function: parallelForEach
+ * Usage: parallelForEach(grid, fn);
+ * ---------------------------------
+ * Calls the specified function on each element of the grid, as mapAll does,
+ * but on several threads at once.  If the grid is not const, the function
+ * may take its argument by reference and modify it; for a Grid<bool> the
+ * reference is to a bool that is stored back into the grid afterwards.
+ * Grids of any layout are accepted, but row-major grids, including
+ * Grid<bool>, are the fast case; other layouts are visited cell by cell
+ * through get.
+ */
+template <typename ValueType, typename Layout, typename FunctorType>
+void parallelForEach(Grid<ValueType, Layout>& grid, FunctorType fn) {
+    stanfordcpplib::collections::ParallelCells<ValueType, Layout> cells(grid);
+    int numCols = grid.numCols();
+    ThreadPool::shared().parallelFor(0, grid.numRows(), [=](int firstRow, int lastRow) {
+        for (int row = firstRow; row < lastRow; row++) {
+            cells.update(row, fn);
+        }
+    }, stanfordcpplib::collections::parallelMinRowsPerBand(numCols));
+}
+
+template <typename ValueType, typename Layout, typename FunctorType>
+void parallelForEach(const Grid<ValueType, Layout>& grid, FunctorType fn) {
+    stanfordcpplib::collections::ParallelConstCells<ValueType, Layout> cells(grid);
+    int numCols = grid.numCols();
+    ThreadPool::shared().parallelFor(0, grid.numRows(), [=](int firstRow, int lastRow) {
+        for (int row = firstRow; row < lastRow; row++) {
+            for (int col = 0; col < numCols; col++) {
+                fn(cells.get(row, col));
+            }
+        }
+    }, stanfordcpplib::collections::parallelMinRowsPerBand(numCols));
+}
+
+/*
+ * Function: parallelForEach
+ * Usage: parallelForEach(range, fn);
+ * ----------------------------------
+ * Calls fn(loc) for each GridLocation in the given range, on several threads
+ * at once.  The range is split into bands of whole rows (or whole columns,
+ * if it is column-major); each band is visited in the range's order, but
+ * the bands run concurrently, so there is no overall order.
+ * Usage: parallelForEach(grid.locations().intersect(window), [&](const GridLocation& loc) { ... });
+ */
+template <typename FunctorType>
+void parallelForEach(const GridLocationRange& range, FunctorType fn) {
+    if (range.isEmpty()) {
+        return;
+    }
+    bool rowMajor = range.isRowMajor();
+    int first = rowMajor ? range.startRow() : range.startCol();
+    int last = rowMajor ? range.endRow() : range.endCol();
+    int lineLength = rowMajor ? range.numCols() : range.numRows();
+    ThreadPool::shared().parallelFor(first, last + 1, [=](int firstLine, int lastLine) {
+        GridLocationRange band = rowMajor
+                ? GridLocationRange(firstLine, range.startCol(), lastLine - 1, range.endCol(), true)
+                : GridLocationRange(range.startRow(), firstLine, range.endRow(), lastLine - 1, false);
+        for (const GridLocation& loc : band) {
+            fn(loc);
+        }
+    }, stanfordcpplib::collections::parallelMinRowsPerBand(lineLength));
+}
+
+/*
+ * Function: parallelTransform
+ * Usage: parallelTransform(source, dest, fn);
+ * -------------------------------------------
+ * Stores fn(source[row][col]) into dest[row][col] for every cell, on
+ * several threads at once.  The destination is resized to match the source
+ * if necessary.  The source and destination must be different grids.
+ * As with parallelForEach, either grid may be a Grid<bool> or have any
+ * layout.
+ */
+template <typename SourceType, typename SourceLayout,
+          typename DestType, typename DestLayout, typename FunctorType>
+void parallelTransform(const Grid<SourceType, SourceLayout>& source,
+                       Grid<DestType, DestLayout>& dest, FunctorType fn) {
+    int numRows = source.numRows();
+    int numCols = source.numCols();
+    if (dest.numRows() != numRows || dest.numCols() != numCols) {
+        dest.resize(numRows, numCols);
+    }
+    stanfordcpplib::collections::ParallelConstCells<SourceType, SourceLayout> in(source);
+    stanfordcpplib::collections::ParallelCells<DestType, DestLayout> out(dest);
+    ThreadPool::shared().parallelFor(0, numRows, [=](int firstRow, int lastRow) {
+        for (int row = firstRow; row < lastRow; row++) {
+            out.assign(row, [in, &fn, row](int col) {
+                return fn(in.get(row, col));
+            });
+        }
+    }, stanfordcpplib::collections::parallelMinRowsPerBand(numCols));
+}
+
+/*
+ * Function: parallelStencil3x3
+ * Usage: parallelStencil3x3(source, dest, fn);
+ * --------------------------------------------
+ * Stores fn(row, col, cell) into dest[row][col] for every cell, on several
+ * threads at once, where cell is the source grid's
+ * <code>Grid&lt;SourceType&gt;::Stencil</code> for (row, col) as passed by
+ * mapStencil, so that <code>cell(dRow, dCol)</code> reads the neighbours
+ * from -1 to 1 rows and columns away.  The source must have a border (see
+ * Grid::setBorder), filled in as the client wishes before the call; this
+ * function signals an error if it does not.  Only row-major grids of types
+ * other than bool can have a border, so other sources do not compile.  The
+ * destination, which may be of any kind, is resized to match the source
+ * if necessary.  The source and destination must be different grids.
+ */
+template <typename SourceType, typename SourceLayout,
+          typename DestType, typename DestLayout, typename FunctorType>
+void parallelStencil3x3(const Grid<SourceType, SourceLayout>& source,
+                        Grid<DestType, DestLayout>& dest, FunctorType fn) {
+    static_assert(std::is_same<SourceLayout, RowMajorLayout>::value
+                  && !std::is_same<SourceType, bool>::value,
+                  "parallelStencil3x3: the source must be a row-major Grid of a type other than bool, "
+                  "since only those grids have a border");
+    if (source.border() < 1) {
+        error("parallelStencil3x3: source grid has no border; call setBorder first");
+    }
+    int numRows = source.numRows();
+    int numCols = source.numCols();
+    if (dest.numRows() != numRows || dest.numCols() != numCols) {
+        dest.resize(numRows, numCols);
+    }
+    const SourceType* in = source.data();
+    int inPitch = source.pitch();
+    stanfordcpplib::collections::ParallelCells<DestType, DestLayout> out(dest);
+    ThreadPool::shared().parallelFor(0, numRows, [=](int firstRow, int lastRow) {
+        for (int row = firstRow; row < lastRow; row++) {
+            const SourceType* src = in + row * inPitch;
+            out.assign(row, [&fn, row, src, inPitch](int col) {
+                return fn(row, col, typename Grid<SourceType>::Stencil(src + col, inPitch));
+            });
+        }
+    }, stanfordcpplib::collections::parallelMinRowsPerBand(numCols));
+}
+
+#endif // _parallelgrid_h
@@ -4,6 +4,13 @@
  * This file exports the <code>Set</code> class, which implements a
  * collection for storing a set of distinct elements.
  * 
+ * @version 2026/10/17
+ * - elements are stored in a Map with NoValue values, so nodes carry
+ *   no dead value
+ * - union, intersection, difference and subset tests between sets with
+ *   the same ordering walk both sets in step and take linear time
+ * - fixed mapAll, which did not compile, and initialized removeFlag in
+ *   every constructor
  * @version 2018/03/19
  * - added constructors that accept a comparison function
  * @version 2018/03/10
@@ -480,9 +487,39 @@ public:
     /**********************************************************************/
 
 private:
-    Map<ValueType, bool> map;            /* Map used to store the element     */
+    typedef stanfordcpplib::collections::NoValue NoValue;
+
+    Map<ValueType, NoValue> map;         /* Map used to store the element     */
     bool removeFlag;                     /* Flag to differentiate += and -=   */
 
+    /*
+     * Implementation notes: set algebra
+     * ---------------------------------
+     * When both sets use the same ordering, the set operations flatten
+     * the two trees into sorted arrays, walk those in step as in the merge
+     * step of merge sort, and rebuild the tree from the sorted result with
+     * Map::assignSorted.  That takes O(N + M) time instead of one tree
+     * lookup per element.  If one set is much smaller than the other,
+     * looking up its few elements in the big set is cheaper than walking
+     * all of it, so that is done instead; preferMerge makes that choice.
+     */
+    static bool preferMerge(int lookups, int setSize) {
+        long long depth = 1;
+        for (int n = setSize; n > 1; n /= 2) {
+            depth++;
+        }
+        return lookups * depth >= setSize;
+    }
+
+    Vector<ValueType> sortedElements() const {
+        Vector<ValueType> elements;
+        elements.ensureCapacity(size());
+        map.mapAll([&elements](const ValueType& value, const NoValue&) {
+            elements.add(value);
+        });
+        return elements;
+    }
+
 public:
     /*
      * Hidden features
@@ -495,7 +532,7 @@ public:
 
     /* Extended constructors */
     template <typename CompareType>
-    explicit Set(CompareType cmp) : map(Map<ValueType, bool>(cmp)), removeFlag(false) {
+    explicit Set(CompareType cmp) : map(Map<ValueType, NoValue>(cmp)), removeFlag(false) {
         // Empty
     }
 
@@ -517,14 +554,14 @@ public:
      */
     class iterator : public std::iterator<std::input_iterator_tag,ValueType> {
     private:
-        typename Map<ValueType,bool>::iterator mapit;  /* Iterator for the map */
+        typename Map<ValueType, NoValue>::iterator mapit;  /* Iterator for the map */
 
     public:
         iterator() {
             /* Empty */
         }
 
-        iterator(typename Map<ValueType,bool>::iterator it) : mapit(it) {
+        iterator(typename Map<ValueType, NoValue>::iterator it) : mapit(it) {
             /* Empty */
         }
 
@@ -576,30 +613,30 @@ Set<ValueType>::Set() : removeFlag(false) {
 
 template <typename ValueType>
 Set<ValueType>::Set(bool lessFunc(ValueType, ValueType))
-        : map(lessFunc) {
+        : map(lessFunc), removeFlag(false) {
     // empty
 }
 
 template <typename ValueType>
 Set<ValueType>::Set(bool lessFunc(const ValueType&, const ValueType&))
-        : map(lessFunc) {
+        : map(lessFunc), removeFlag(false) {
     // empty
 }
 
 template <typename ValueType>
-Set<ValueType>::Set(std::initializer_list<ValueType> list) {
+Set<ValueType>::Set(std::initializer_list<ValueType> list) : removeFlag(false) {
     addAll(list);
 }
 
 template <typename ValueType>
 Set<ValueType>::Set(std::initializer_list<ValueType> list, bool lessFunc(ValueType, ValueType))
-        : map(lessFunc) {
+        : map(lessFunc), removeFlag(false) {
     addAll(list);
 }
 
 template <typename ValueType>
 Set<ValueType>::Set(std::initializer_list<ValueType> list, bool lessFunc(const ValueType&, const ValueType&))
-        : map(lessFunc) {
+        : map(lessFunc), removeFlag(false) {
     addAll(list);
 }
 
@@ -610,13 +647,44 @@ Set<ValueType>::~Set() {
 
 template <typename ValueType>
 void Set<ValueType>::add(const ValueType& value) {
-    map.put(value, true);
+    map.put(value, NoValue());
 }
 
 template <typename ValueType>
 Set<ValueType>& Set<ValueType>::addAll(const Set& set2) {
-    for (const ValueType& value : set2) {
-        this->add(value);
+    if (this == &set2) {
+        return *this;
+    }
+    if (!map.hasSameOrdering(set2.map) || !preferMerge(set2.size(), size())) {
+        for (const ValueType& value : set2) {
+            this->add(value);
+        }
+        return *this;
+    }
+    Vector<ValueType> elements1 = sortedElements();
+    Vector<ValueType> elements2 = set2.sortedElements();
+    Vector<ValueType> result;
+    result.ensureCapacity(elements1.size() + elements2.size());
+    int i1 = 0;
+    int i2 = 0;
+    while (i1 < elements1.size() && i2 < elements2.size()) {
+        if (map.lessThan(elements1[i1], elements2[i2])) {
+            result.add(elements1[i1++]);
+        } else if (map.lessThan(elements2[i2], elements1[i1])) {
+            result.add(elements2[i2++]);
+        } else {
+            result.add(elements1[i1++]);
+            i2++;
+        }
+    }
+    while (i1 < elements1.size()) {
+        result.add(elements1[i1++]);
+    }
+    while (i2 < elements2.size()) {
+        result.add(elements2[i2++]);
+    }
+    if (result.size() != size()) {
+        map.assignSorted(result);
     }
     return *this;
 }
@@ -649,12 +717,7 @@ bool Set<ValueType>::contains(const ValueType& value) const {
 
 template <typename ValueType>
 bool Set<ValueType>::containsAll(const Set<ValueType>& set2) const {
-    for (const ValueType& value : set2) {
-        if (!contains(value)) {
-            return false;
-        }
-    }
-    return true;
+    return set2.isSubsetOf(*this);
 }
 
 template <typename ValueType>
@@ -701,7 +764,7 @@ ValueType Set<ValueType>::front() const {
 
 template <typename ValueType>
 void Set<ValueType>::insert(const ValueType& value) {
-    map.put(value, true);
+    map.put(value, NoValue());
 }
 
 template <typename ValueType>
@@ -711,13 +774,28 @@ bool Set<ValueType>::isEmpty() const {
 
 template <typename ValueType>
 bool Set<ValueType>::isSubsetOf(const Set& set2) const {
-    auto it = begin();
-    auto end = this->end();
-    while (it != end) {
-        if (!set2.map.containsKey(*it)) {
+    if (!map.hasSameOrdering(set2.map) || !preferMerge(size(), set2.size())) {
+        for (const ValueType& value : *this) {
+            if (!set2.map.containsKey(value)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (size() > set2.size()) {
+        return false;
+    }
+    Vector<ValueType> elements1 = sortedElements();
+    Vector<ValueType> elements2 = set2.sortedElements();
+    int i2 = 0;
+    for (int i1 = 0; i1 < elements1.size(); i1++) {
+        while (i2 < elements2.size() && map.lessThan(elements2[i2], elements1[i1])) {
+            i2++;
+        }
+        if (i2 == elements2.size() || map.lessThan(elements1[i1], elements2[i2])) {
             return false;
         }
-        ++it;
+        i2++;
     }
     return true;
 }
@@ -740,18 +818,24 @@ bool Set<ValueType>::isSupersetOf(std::initializer_list<ValueType> list) const {
 
 template <typename ValueType>
 void Set<ValueType>::mapAll(void (*fn)(ValueType)) const {
-    map.mapAll(fn);
+    for (const ValueType& value : *this) {
+        fn(value);
+    }
 }
 
 template <typename ValueType>
 void Set<ValueType>::mapAll(void (*fn)(const ValueType&)) const {
-    map.mapAll(fn);
+    for (const ValueType& value : *this) {
+        fn(value);
+    }
 }
 
 template <typename ValueType>
 template <typename FunctorType>
 void Set<ValueType>::mapAll(FunctorType fn) const {
-    map.mapAll(fn);
+    for (const ValueType& value : *this) {
+        fn(value);
+    }
 }
 
 template <typename ValueType>
@@ -761,14 +845,45 @@ void Set<ValueType>::remove(const ValueType& value) {
 
 template <typename ValueType>
 Set<ValueType>& Set<ValueType>::removeAll(const Set& set2) {
-    Vector<ValueType> toRemove;
-    for (const ValueType& value : *this) {
-        if (set2.map.containsKey(value)) {
-            toRemove.add(value);
+    if (this == &set2) {
+        clear();
+        return *this;
+    }
+    if (!map.hasSameOrdering(set2.map) || !preferMerge(size(), set2.size())) {
+        // this set is small, or ordered differently: look its elements up in set2
+        Vector<ValueType> toRemove;
+        for (const ValueType& value : *this) {
+            if (set2.map.containsKey(value)) {
+                toRemove.add(value);
+            }
+        }
+        for (const ValueType& value : toRemove) {
+            remove(value);
+        }
+        return *this;
+    }
+    if (!preferMerge(set2.size(), size())) {
+        // set2 is small: remove its elements one by one
+        for (const ValueType& value : set2) {
+            remove(value);
         }
+        return *this;
     }
-    for (const ValueType& value : toRemove) {
-        remove(value);
+    Vector<ValueType> elements1 = sortedElements();
+    Vector<ValueType> elements2 = set2.sortedElements();
+    Vector<ValueType> result;
+    result.ensureCapacity(elements1.size());
+    int i2 = 0;
+    for (int i1 = 0; i1 < elements1.size(); i1++) {
+        while (i2 < elements2.size() && map.lessThan(elements2[i2], elements1[i1])) {
+            i2++;
+        }
+        if (i2 == elements2.size() || map.lessThan(elements1[i1], elements2[i2])) {
+            result.add(elements1[i1]);
+        }
+    }
+    if (result.size() != size()) {
+        map.assignSorted(result);
     }
     return *this;
 }
@@ -783,6 +898,43 @@ Set<ValueType>& Set<ValueType>::removeAll(std::initializer_list<ValueType> list)
 
 template <typename ValueType>
 Set<ValueType>& Set<ValueType>::retainAll(const Set& set2) {
+    if (this == &set2) {
+        return *this;
+    }
+    if (map.hasSameOrdering(set2.map)) {
+        Vector<ValueType> result;
+        if (!preferMerge(set2.size(), size())) {
+            // set2 is small: keep those of its elements that are in this set
+            for (const ValueType& value : set2) {
+                if (map.containsKey(value)) {
+                    result.add(value);
+                }
+            }
+        } else if (!preferMerge(size(), set2.size())) {
+            // this set is small: keep those of its elements that are in set2
+            for (const ValueType& value : *this) {
+                if (set2.map.containsKey(value)) {
+                    result.add(value);
+                }
+            }
+        } else {
+            Vector<ValueType> elements1 = sortedElements();
+            Vector<ValueType> elements2 = set2.sortedElements();
+            int i2 = 0;
+            for (int i1 = 0; i1 < elements1.size(); i1++) {
+                while (i2 < elements2.size() && map.lessThan(elements2[i2], elements1[i1])) {
+                    i2++;
+                }
+                if (i2 < elements2.size() && !map.lessThan(elements1[i1], elements2[i2])) {
+                    result.add(elements1[i1]);
+                }
+            }
+        }
+        if (result.size() != size()) {
+            map.assignSorted(result);
+        }
+        return *this;
+    }
     Vector<ValueType> toRemove;
     for (ValueType value : *this) {
         if (!set2.map.containsKey(value)) {
@@ -826,7 +978,9 @@ std::string Set<ValueType>::toString() const {
  * Implementation notes: set operators
  * -----------------------------------
  * The implementations for the set operators use iteration to walk
- * over the elements in one or both sets.
+ * over the elements in one or both sets.  The +, * and - operators copy
+ * this set and then apply addAll, retainAll or removeAll, which walk
+ * both sets in step when they can; see the notes on set algebra above.
  */
 template <typename ValueType>
 bool Set<ValueType>::operator ==(const Set& set2) const {
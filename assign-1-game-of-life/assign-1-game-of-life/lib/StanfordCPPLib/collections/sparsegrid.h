@@ -9,6 +9,10 @@
  * Grid is recommended for use over SparseGrid.
  * 
  * @author Marty Stepp
+ * @version 2026/10/16
+ * - stores cells in hashed 8x8 chunks with an occupancy mask instead of a
+ *   Map of Maps; get/set/isSet are now constant time
+ * - added countNeighbors
  * @version 2018/03/12
  * - added overloads that accept GridLocation: get, inBounds, isSet, locations,
  *   set, unset, operator []
@@ -49,6 +53,8 @@
 #ifndef _sparsegrid_h
 #define _sparsegrid_h
 
+#include <algorithm>
+#include <cstdint>
 #include <initializer_list>
 
 #define INTERNAL_INCLUDE 1
@@ -60,6 +66,8 @@
 #define INTERNAL_INCLUDE 1
 #include "hashcode.h"
 #define INTERNAL_INCLUDE 1
+#include "hashmap.h"
+#define INTERNAL_INCLUDE 1
 #include "map.h"
 #define INTERNAL_INCLUDE 1
 #include "random.h"
@@ -69,6 +77,46 @@
 #include "vector.h"
 #undef INTERNAL_INCLUDE
 
+namespace stanfordcpplib {
+namespace collections {
+
+/*
+ * Position of one chunk of a SparseGrid, measured in chunks rather than
+ * cells.  Ordered in row-major order so that chunks can be visited the
+ * same way as the cells they hold.
+ */
+struct SparseChunkKey {
+    int row;
+    int col;
+
+    SparseChunkKey(int row = 0, int col = 0)
+            : row(row),
+              col(col) {
+        // empty
+    }
+
+    bool operator ==(const SparseChunkKey& other) const {
+        return row == other.row && col == other.col;
+    }
+
+    bool operator <(const SparseChunkKey& other) const {
+        return row < other.row || (row == other.row && col < other.col);
+    }
+};
+
+inline int hashCode(const SparseChunkKey& key) {
+    return ::hashCode(key.row, key.col);
+}
+
+inline uint64_t hashCode64(const SparseChunkKey& key) {
+    uint64_t packed = (static_cast<uint64_t>(static_cast<uint32_t>(key.row)) << 32)
+            | static_cast<uint32_t>(key.col);
+    return hashMix64(packed ^ hashSeed64());
+}
+
+} // namespace collections
+} // namespace stanfordcpplib
+
 /*
  * Class: SparseGrid<ValueType>
  * ----------------------------
@@ -132,6 +180,19 @@ public:
      */
     void clear();
 
+    /*
+     * Method: countNeighbors
+     * Usage: int n = grid.countNeighbors(row, col);
+     * ---------------------------------------------
+     * Returns how many of the (up to eight) cells surrounding the given
+     * row/column position are set.  Positions outside the grid do not count.
+     * This is much cheaper than calling isSet on each neighbor, since every
+     * chunk the neighborhood touches is looked up only once.
+     * This method signals an error if the <code>row</code> and <code>col</code>
+     * arguments are outside the grid boundaries.
+     */
+    int countNeighbors(int row, int col) const;
+
     /*
      * Method: equals
      * Usage: if (grid.equals(grid2)) ...
@@ -413,19 +474,40 @@ public:
     /*
      * Implementation notes: SparseGrid data structure
      * -----------------------------------------------
-     * The SparseGrid is internally managed as a dynamic array of elements.
-     * The array itself is one-dimensional, the logical separation into
-     * rows and columns is done by arithmetic computation.  The layout
-     * is in row-major order, which is to say that the entire first row
-     * is laid out contiguously, followed by the entire second row,
-     * and so on.
+     * The SparseGrid is divided into square chunks of kChunkSize x kChunkSize
+     * cells.  Only chunks that contain at least one set cell are allocated.
+     * They are kept in a HashMap keyed by the chunk's (row, col) position,
+     * so finding the chunk for a cell costs a single hash lookup.  Each
+     * chunk stores its cells densely in row-major order along with a 64-bit
+     * occupancy mask that records which of those cells have been set.
+     * Cells that are not set always hold the default value, and a chunk is
+     * freed as soon as its last cell is unset.
+     *
+     * Operations that visit the set cells (mapAll, equals, <<, etc.) walk
+     * the chunks rather than every row/column of the grid, so their cost
+     * depends on how much of the grid is occupied rather than on its size.
      */
 
 private:
+    /* Constant definitions */
+    static const int kChunkShift = 3;
+    static const int kChunkSize = 1 << kChunkShift;   // cells per chunk side
+    static const int kChunkMask = kChunkSize - 1;
+
+    typedef uint64_t WordType;
+    typedef stanfordcpplib::collections::SparseChunkKey ChunkKey;
+
+    /* Type definition for a dense block of cells */
+    struct Chunk {
+        WordType occupied = 0;                      // bit i set if cells[i] is set
+        ValueType cells[kChunkSize * kChunkSize];   // row-major within the chunk
+    };
+
     /* Instance variables */
-    Map<int, Map<int, ValueType> > elements;  // 2D map of the elements
-    int nRows;            // The number of rows in the grid
-    int nCols;            // The number of columns in the grid
+    HashMap<ChunkKey, Chunk*> chunks;   // allocated chunks by chunk position
+    int nRows = 0;                      // The number of rows in the grid
+    int nCols = 0;                      // The number of columns in the grid
+    int nSet = 0;                       // The number of cells that are set
     unsigned int m_version = 0;  // structure version for detecting invalid iterators
 
     /* Private method prototypes */
@@ -440,9 +522,59 @@ private:
      */
     void checkIndexes(int row, int col,
                       int rowMax, int colMax,
-                      std::string prefix) const;
+                      const char* prefix) const;
     int gridCompare(const SparseGrid& grid2) const;
 
+    /*
+     * Returns the chunk holding the given cell, or nullptr if no cell of
+     * that chunk is set.
+     */
+    Chunk* findChunk(int row, int col) const {
+        return chunks.get(ChunkKey(row >> kChunkShift, col >> kChunkShift));
+    }
+
+    /*
+     * Returns the position of the given cell within its chunk.
+     */
+    static int cellIndex(int row, int col) {
+        return ((row & kChunkMask) << kChunkShift) | (col & kChunkMask);
+    }
+
+    /*
+     * Returns a reference to the given cell, allocating its chunk and
+     * marking the cell as set if necessary.
+     */
+    ValueType& cellRef(int row, int col);
+
+    /*
+     * Frees every chunk and leaves the grid with no cells set.
+     */
+    void deleteChunks();
+
+    /*
+     * Removes the cells of the given chunk that lie outside the grid,
+     * freeing the chunk if no cells remain.  Used when shrinking.
+     */
+    void trimChunk(const ChunkKey& key);
+
+    /*
+     * Calls fn(row, col, value) on every set cell in row-major order.
+     * The chunks are sorted by position once, and then each band of
+     * kChunkSize rows is emitted row by row across the band's chunks.
+     */
+    template <typename FunctorType>
+    void forEachSet(FunctorType fn) const;
+
+    /*
+     * Returns a shared default value that unset cells read as.
+     */
+    static const ValueType& emptyValue() {
+        static const ValueType empty = ValueType();
+        return empty;
+    }
+
+    static int popCount(WordType word);
+
     /*
      * Hidden features
      * ---------------
@@ -458,17 +590,19 @@ private:
      * This copy constructor and operator= are defined to make a
      * deep copy, making it possible to pass/return grids by value
      * and assign from one grid to another.  The entire contents of
-     * the grid, including all elements, are copied.  Each grid
-     * element is copied from the original grid to the copy using
-     * assignment (operator=).  Making copies is generally avoided
-     * because of the expense and thus, grids are typically passed
-     * by reference, however, when a copy is needed, these operations
-     * are supported.
+     * the grid, including all elements, are copied.  Each chunk is
+     * copied from the original grid to the copy as a block.  Making
+     * copies is generally avoided because of the expense and thus,
+     * grids are typically passed by reference, however, when a copy
+     * is needed, these operations are supported.
      */
     void deepCopy(const SparseGrid& grid) {
-        elements = grid.elements;
+        for (const ChunkKey& key : grid.chunks) {
+            chunks.put(key, new Chunk(*grid.chunks.get(key)));
+        }
         nRows = grid.nRows;
         nCols = grid.nCols;
+        nSet = grid.nSet;
     }
 
     template <typename T>
@@ -483,7 +617,9 @@ private:
 public:
     SparseGrid& operator =(const SparseGrid& src) {
         if (this != &src) {
+            deleteChunks();
             deepCopy(src);
+            m_version++;
         }
         return *this;
     }
@@ -540,14 +676,14 @@ public:
             stanfordcpplib::collections::checkVersion(*gp, *this);
             int row = index / gp->nCols;
             int col = index % gp->nCols;
-            return gp->elements[row][col];
+            return gp->get(row, col);
         }
 
-        ValueType* operator ->() {
+        const ValueType* operator ->() {
             stanfordcpplib::collections::checkVersion(*gp, *this);
             int row = index / gp->nCols;
             int col = index % gp->nCols;
-            return &gp->elements[row][col];
+            return &gp->get(row, col);
         }
 
         unsigned int version() const {
@@ -588,12 +724,12 @@ public:
 
         ValueType& operator [](int col) {
             gp->checkIndexes(row, col, gp->nRows-1, gp->nCols-1, "operator [][]");
-            return gp->elements[row][col];
+            return gp->cellRef(row, col);
         }
 
         const ValueType& operator [](int col) const {
             gp->checkIndexes(row, col, gp->nRows-1, gp->nCols-1, "operator [][]");
-            return gp->elements[row][col];
+            return gp->cellRef(row, col);
         }
 
     private:
@@ -616,7 +752,7 @@ public:
 
         const ValueType operator [](int col) const {
             gp->checkIndexes(row, col, gp->nRows-1, gp->nCols-1, "operator [][]");
-            return gp->elements[row][col];
+            return gp->get(row, col);
         }
 
     private:
@@ -632,9 +768,7 @@ public:
 };
 
 template <typename ValueType>
-SparseGrid<ValueType>::SparseGrid()
-        : nRows(0),
-          nCols(0) {
+SparseGrid<ValueType>::SparseGrid() {
     // empty
 }
 
@@ -650,9 +784,7 @@ SparseGrid<ValueType>::SparseGrid(int nRows, int nCols, const ValueType& value)
 }
 
 template <typename ValueType>
-SparseGrid<ValueType>::SparseGrid(std::initializer_list<std::initializer_list<ValueType> > list)
-        : nRows(0),
-          nCols(0) {
+SparseGrid<ValueType>::SparseGrid(std::initializer_list<std::initializer_list<ValueType> > list) {
     // create the grid at the proper size
     nRows = list.size();
     if (list.begin() != list.end()) {
@@ -678,7 +810,7 @@ SparseGrid<ValueType>::SparseGrid(std::initializer_list<std::initializer_list<Va
 
 template <typename ValueType>
 SparseGrid<ValueType>::~SparseGrid() {
-    // empty
+    deleteChunks();
 }
 
 template <typename ValueType>
@@ -686,14 +818,64 @@ ValueType SparseGrid<ValueType>::back() const {
     if (isEmpty()) {
         error("SparseGrid::back: grid is empty");
     }
-    int lastRow = elements.back();
-    int lastCol = elements[lastRow].back();
-    return elements[lastRow][lastCol];
+
+    // the last set cell is the highest set bit of some chunk;
+    // compare those candidates in row-major order
+    int lastRow = -1;
+    int lastCol = -1;
+    for (const ChunkKey& key : chunks) {
+        WordType occupied = chunks.get(key)->occupied;
+        int bit = kChunkSize * kChunkSize - 1;
+        while (!(occupied & (WordType(1) << bit))) {
+            bit--;
+        }
+        int row = (key.row << kChunkShift) + (bit >> kChunkShift);
+        int col = (key.col << kChunkShift) + (bit & kChunkMask);
+        if (row > lastRow || (row == lastRow && col > lastCol)) {
+            lastRow = row;
+            lastCol = col;
+        }
+    }
+    return get(lastRow, lastCol);
 }
 
 template <typename ValueType>
 void SparseGrid<ValueType>::clear() {
-    elements.clear();
+    deleteChunks();
+    m_version++;
+}
+
+template <typename ValueType>
+int SparseGrid<ValueType>::countNeighbors(int row, int col) const {
+    checkIndexes(row, col, nRows-1, nCols-1, "countNeighbors");
+    int rowMin = row > 0 ? row - 1 : 0;
+    int rowMax = row < nRows - 1 ? row + 1 : nRows - 1;
+    int colMin = col > 0 ? col - 1 : 0;
+    int colMax = col < nCols - 1 ? col + 1 : nCols - 1;
+
+    // the 3x3 window touches at most four chunks; look each one up once
+    int count = 0;
+    for (int chunkRow = rowMin >> kChunkShift; chunkRow <= rowMax >> kChunkShift; chunkRow++) {
+        for (int chunkCol = colMin >> kChunkShift; chunkCol <= colMax >> kChunkShift; chunkCol++) {
+            Chunk* chunk = chunks.get(ChunkKey(chunkRow, chunkCol));
+            if (!chunk) {
+                continue;
+            }
+            int rowFirst = std::max(rowMin, chunkRow << kChunkShift);
+            int rowLast = std::min(rowMax, (chunkRow << kChunkShift) + kChunkMask);
+            int colFirst = std::max(colMin, chunkCol << kChunkShift);
+            int colLast = std::min(colMax, (chunkCol << kChunkShift) + kChunkMask);
+            for (int r = rowFirst; r <= rowLast; r++) {
+                for (int c = colFirst; c <= colLast; c++) {
+                    if ((r != row || c != col)
+                            && (chunk->occupied & (WordType(1) << cellIndex(r, c)))) {
+                        count++;
+                    }
+                }
+            }
+        }
+    }
+    return count;
 }
 
 template <typename ValueType>
@@ -702,21 +884,21 @@ bool SparseGrid<ValueType>::equals(const SparseGrid<ValueType>& grid2) const {
     if (this == &grid2) {
         return true;
     }
-    if (nRows != grid2.nRows || nCols != grid2.nCols) {
+    if (nRows != grid2.nRows || nCols != grid2.nCols || nSet != grid2.nSet) {
         return false;
     }
-    for (int row = 0; row < nRows; row++) {
-        for (int col = 0; col < nCols; col++) {
-            if (isSet(row, col)) {
-                // I have data there; he must, too, and it must be the same data
-                if (!grid2.isSet(row, col) || get(row, col) != grid2.get(row, col)) {
-                    return false;
-                }
-            } else {
-                // I don't have data there; he must also not have it there
-                if (grid2.isSet(row, col)) {
-                    return false;
-                }
+
+    // same number of set cells, so it is enough that every cell I have set
+    // is set to the same value in the other grid
+    for (const ChunkKey& key : chunks) {
+        Chunk* chunk = chunks.get(key);
+        Chunk* chunk2 = grid2.chunks.get(key);
+        if (!chunk2 || chunk->occupied != chunk2->occupied) {
+            return false;
+        }
+        for (int i = 0; i < kChunkSize * kChunkSize; i++) {
+            if ((chunk->occupied & (WordType(1) << i)) && chunk->cells[i] != chunk2->cells[i]) {
+                return false;
             }
         }
     }
@@ -727,9 +909,10 @@ template <typename ValueType>
 void SparseGrid<ValueType>::fill(const ValueType& value) {
     for (int row = 0; row < nRows; row++) {
         for (int col = 0; col < nCols; col++) {
-            set(row, col, value);
+            cellRef(row, col) = value;
         }
     }
+    m_version++;
 }
 
 template <typename ValueType>
@@ -743,13 +926,16 @@ ValueType SparseGrid<ValueType>::front() const {
 template <typename ValueType>
 ValueType SparseGrid<ValueType>::get(int row, int col) {
     checkIndexes(row, col, nRows-1, nCols-1, "get");
-    return elements[row][col];
+    Chunk* chunk = findChunk(row, col);
+    return chunk ? chunk->cells[cellIndex(row, col)] : ValueType();
 }
 
 template <typename ValueType>
 const ValueType& SparseGrid<ValueType>::get(int row, int col) const {
     checkIndexes(row, col, nRows-1, nCols-1, "get");
-    return elements[row][col];
+    // cells that are not set hold the default value, so no need to test the mask
+    Chunk* chunk = findChunk(row, col);
+    return chunk ? chunk->cells[cellIndex(row, col)] : emptyValue();
 }
 
 template <typename ValueType>
@@ -779,13 +965,16 @@ bool SparseGrid<ValueType>::inBounds(const GridLocation& loc) const {
 
 template <typename ValueType>
 bool SparseGrid<ValueType>::isEmpty() const {
-    return elements.isEmpty();
+    return nSet == 0;
 }
 
 template <typename ValueType>
 bool SparseGrid<ValueType>::isSet(int row, int col) const {
-    return inBounds(row, col) && elements.containsKey(row) &&
-            elements[row].containsKey(col);
+    if (!inBounds(row, col)) {
+        return false;
+    }
+    Chunk* chunk = findChunk(row, col);
+    return chunk && (chunk->occupied & (WordType(1) << cellIndex(row, col)));
 }
 
 template <typename ValueType>
@@ -800,36 +989,24 @@ GridLocationRange SparseGrid<ValueType>::locations(bool rowMajor) const {
 
 template <typename ValueType>
 void SparseGrid<ValueType>::mapAll(void (*fn)(ValueType value)) const {
-    for (int row = 0; row < nRows; row++) {
-        for (int col = 0; col < nCols; col++) {
-            if (isSet(row, col)) {
-                fn(get(row, col));
-            }
-        }
-    }
+    forEachSet([fn](int, int, const ValueType& value) {
+        fn(value);
+    });
 }
 
 template <typename ValueType>
 void SparseGrid<ValueType>::mapAll(void (*fn)(const ValueType& value)) const {
-    for (int row = 0; row < nRows; row++) {
-        for (int col = 0; col < nCols; col++) {
-            if (isSet(row, col)) {
-                fn(get(row, col));
-            }
-        }
-    }
+    forEachSet([fn](int, int, const ValueType& value) {
+        fn(value);
+    });
 }
 
 template <typename ValueType>
 template <typename FunctorType>
 void SparseGrid<ValueType>::mapAll(FunctorType fn) const {
-    for (int row = 0; row < nRows; row++) {
-        for (int col = 0; col < nCols; col++) {
-            if (isSet(row, col)) {
-                fn(get(row, col));
-            }
-        }
-    }
+    forEachSet([&fn](int, int, const ValueType& value) {
+        fn(value);
+    });
 }
 
 template <typename ValueType>
@@ -854,27 +1031,17 @@ void SparseGrid<ValueType>::resize(int nRows, int nCols, bool retain) {
     int oldnCols = this->nCols;
     this->nRows = nRows;
     this->nCols = nCols;
-    
+
     if (retain) {
-        // if resizing to a smaller size, must evict any row/col entries
-        // that exceed the new grid's bounds
+        // chunk positions do not depend on the grid's size, so only the
+        // chunks that straddle or lie beyond a shrunken edge need work
         if (nRows < oldnRows || nCols < oldnCols) {
-            Map<int, Map<int, ValueType> > newElements;
-            for (int row : elements) {
-                if (row >= nRows) {
-                    break;   // don't add any entries beyond this row
-                }
-                for (int col : elements[row]) {
-                    if (col >= nCols) {
-                        break;   // don't add any entries beyond this row
-                    }
-                    newElements[row][col] = elements[row][col];
-                }
+            for (const ChunkKey& key : chunks.keys()) {
+                trimChunk(key);
             }
-            elements = newElements;
         }
     } else {
-        elements.clear();
+        deleteChunks();
     }
     m_version++;
 }
@@ -882,7 +1049,7 @@ void SparseGrid<ValueType>::resize(int nRows, int nCols, bool retain) {
 template <typename ValueType>
 void SparseGrid<ValueType>::set(int row, int col, const ValueType& value) {
     checkIndexes(row, col, nRows-1, nCols-1, "set");
-    elements[row][col] = value;
+    cellRef(row, col) = value;
     m_version++;
 }
 
@@ -893,11 +1060,7 @@ void SparseGrid<ValueType>::set(const GridLocation& loc, const ValueType& value)
 
 template <typename ValueType>
 int SparseGrid<ValueType>::size() const {
-    int count = 0;
-    for (int row : elements) {
-        count += elements[row].size();
-    }
-    return count;
+    return nSet;
 }
 
 template <typename ValueType>
@@ -916,7 +1079,14 @@ std::string SparseGrid<ValueType>::toString2D(
     int nRows = numRows();
     int nCols = numCols();
     for (int i = 0; i < nRows; i++) {
-        if (!elements.containsKey(i) || elements[i].isEmpty()) {
+        // skip rows in which no cell is set
+        bool rowIsSet = false;
+        WordType rowBits = ((WordType(1) << kChunkSize) - 1) << ((i & kChunkMask) << kChunkShift);
+        for (int chunkCol = 0; !rowIsSet && chunkCol <= (nCols - 1) >> kChunkShift; chunkCol++) {
+            Chunk* chunk = chunks.get(ChunkKey(i >> kChunkShift, chunkCol));
+            rowIsSet = chunk && (chunk->occupied & rowBits);
+        }
+        if (!rowIsSet) {
             continue;
         }
         if (i > 0) {
@@ -940,10 +1110,16 @@ std::string SparseGrid<ValueType>::toString2D(
 template <typename ValueType>
 void SparseGrid<ValueType>::unset(int row, int col) {
     checkIndexes(row, col, nRows-1, nCols-1, "unset");
-    if (elements.containsKey(row)) {
-        elements[row].remove(col);
-        if (elements[row].isEmpty()) {
-            elements.remove(row);
+    ChunkKey key(row >> kChunkShift, col >> kChunkShift);
+    Chunk* chunk = chunks.get(key);
+    WordType bit = WordType(1) << cellIndex(row, col);
+    if (chunk && (chunk->occupied & bit)) {
+        chunk->occupied &= ~bit;
+        chunk->cells[cellIndex(row, col)] = ValueType();
+        nSet--;
+        if (!chunk->occupied) {
+            chunks.remove(key);
+            delete chunk;
         }
     }
     m_version++;
@@ -967,7 +1143,7 @@ int SparseGrid<ValueType>::width() const {
 template <typename ValueType>
 void SparseGrid<ValueType>::checkIndexes(int row, int col,
                                          int rowMax, int colMax,
-                                         std::string prefix) const {
+                                         const char* prefix) const {
     const int rowMin = 0;
     const int colMin = 0;
     if (row < rowMin || row > rowMax || col < colMin || col > colMax) {
@@ -985,6 +1161,91 @@ void SparseGrid<ValueType>::checkIndexes(int row, int col,
     }
 }
 
+template <typename ValueType>
+ValueType& SparseGrid<ValueType>::cellRef(int row, int col) {
+    Chunk*& chunk = chunks[ChunkKey(row >> kChunkShift, col >> kChunkShift)];
+    if (!chunk) {
+        chunk = new Chunk();
+    }
+    int index = cellIndex(row, col);
+    if (!(chunk->occupied & (WordType(1) << index))) {
+        chunk->occupied |= WordType(1) << index;
+        nSet++;
+    }
+    return chunk->cells[index];
+}
+
+template <typename ValueType>
+void SparseGrid<ValueType>::deleteChunks() {
+    for (const ChunkKey& key : chunks) {
+        delete chunks.get(key);
+    }
+    chunks.clear();
+    nSet = 0;
+}
+
+template <typename ValueType>
+void SparseGrid<ValueType>::trimChunk(const ChunkKey& key) {
+    Chunk* chunk = chunks.get(key);
+    for (int i = 0; i < kChunkSize * kChunkSize; i++) {
+        WordType bit = WordType(1) << i;
+        int row = (key.row << kChunkShift) + (i >> kChunkShift);
+        int col = (key.col << kChunkShift) + (i & kChunkMask);
+        if ((chunk->occupied & bit) && !inBounds(row, col)) {
+            chunk->occupied &= ~bit;
+            chunk->cells[i] = ValueType();
+            nSet--;
+        }
+    }
+    if (!chunk->occupied) {
+        chunks.remove(key);
+        delete chunk;
+    }
+}
+
+template <typename ValueType>
+template <typename FunctorType>
+void SparseGrid<ValueType>::forEachSet(FunctorType fn) const {
+    Vector<ChunkKey> keys = chunks.keys();
+    keys.sort();
+    Vector<Chunk*> band;
+    for (int first = 0; first < keys.size(); ) {
+        // gather the chunks that share this chunk row, in column order
+        int chunkRow = keys[first].row;
+        int last = first;
+        band.clear();
+        while (last < keys.size() && keys[last].row == chunkRow) {
+            band.add(chunks.get(keys[last]));
+            last++;
+        }
+        for (int r = 0; r < kChunkSize; r++) {
+            for (int k = 0; k < band.size(); k++) {
+                WordType rowBits = band[k]->occupied >> (r << kChunkShift);
+                for (int c = 0; rowBits && c < kChunkSize; c++, rowBits >>= 1) {
+                    if (rowBits & 1) {
+                        fn((chunkRow << kChunkShift) + r,
+                           (keys[first + k].col << kChunkShift) + c,
+                           band[k]->cells[(r << kChunkShift) + c]);
+                    }
+                }
+            }
+        }
+        first = last;
+    }
+}
+
+template <typename ValueType>
+int SparseGrid<ValueType>::popCount(WordType word) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return static_cast<int>((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
 template <typename ValueType>
 int SparseGrid<ValueType>::gridCompare(const SparseGrid& grid2) const {
     int h1 = height();
@@ -1037,13 +1298,13 @@ SparseGrid<ValueType>::operator [](int row) const {
 template <typename ValueType>
 ValueType& SparseGrid<ValueType>::operator [](const GridLocation& loc) {
     checkIndexes(loc.row, loc.col, nRows-1, nCols-1, "operator []");
-    return elements[loc.row][loc.col];
+    return cellRef(loc.row, loc.col);
 }
 
 template <typename ValueType>
 const ValueType& SparseGrid<ValueType>::operator [](const GridLocation& loc) const {
     checkIndexes(loc.row, loc.col, nRows-1, nCols-1, "operator []");
-    return elements[loc.row][loc.col];
+    return get(loc.row, loc.col);
 }
 
 template <typename ValueType>
@@ -1081,11 +1342,30 @@ bool SparseGrid<ValueType>::operator >=(const SparseGrid& grid2) const {
  * -------------------------------
  * The insertion and extraction operators use the template facilities in
  * strlib.h to read and write generic values in a way that treats strings
- * specially.
+ * specially.  The set cells are written as a map from row to a map from
+ * column to value, such as "{0:{2:88}, 1:{3:42}}, 3 x 4".
  */
 template <typename ValueType>
 std::ostream& operator <<(std::ostream& os, const SparseGrid<ValueType>& grid) {
-    os << grid.elements << ", " << grid.nRows << " x " << grid.nCols;
+    os << "{";
+    int currentRow = -1;
+    grid.forEachSet([&os, &currentRow](int row, int col, const ValueType& value) {
+        if (row != currentRow) {
+            if (currentRow >= 0) {
+                os << "}, ";
+            }
+            os << row << ":{";
+            currentRow = row;
+        } else {
+            os << ", ";
+        }
+        os << col << ":";
+        writeGenericValue(os, value, /* forceQuotes */ true);
+    });
+    if (currentRow >= 0) {
+        os << "}";
+    }
+    os << "}, " << grid.nRows << " x " << grid.nCols;
     return os;
 }
 
@@ -1094,7 +1374,8 @@ std::istream& operator >>(std::istream& is, SparseGrid<ValueType>& grid) {
     // "{...}, 4 x 3"
 
     // read "{...}" (map of elements)
-    if (!(is >> grid.elements)) {
+    Map<int, Map<int, ValueType> > elements;
+    if (!(is >> elements)) {
 #ifdef SPL_ERROR_ON_COLLECTION_PARSE
         error("SparseGrid::operator >>: Invalid elements");
 #endif
@@ -1112,7 +1393,8 @@ std::istream& operator >>(std::istream& is, SparseGrid<ValueType>& grid) {
         return is;
     }
 
-    if (!(is >> grid.nRows)) {
+    int nRows;
+    if (!(is >> nRows)) {
 #ifdef SPL_ERROR_ON_COLLECTION_PARSE
         error("SparseGrid::operator >>: Invalid number of rows");
 #endif
@@ -1123,13 +1405,28 @@ std::istream& operator >>(std::istream& is, SparseGrid<ValueType>& grid) {
     std::string x;
     is >> x;       // throw away 'x' token
 
-    if (!(is >> grid.nCols)) {
+    int nCols;
+    if (!(is >> nCols) || nRows < 0 || nCols < 0) {
 #ifdef SPL_ERROR_ON_COLLECTION_PARSE
         error("SparseGrid::operator >>: Invalid number of rows");
 #endif
         is.setstate(std::ios_base::failbit);
         return is;
     }
+
+    grid.resize(nRows, nCols);
+    for (int row : elements) {
+        for (int col : elements[row]) {
+            if (!grid.inBounds(row, col)) {
+#ifdef SPL_ERROR_ON_COLLECTION_PARSE
+                error("SparseGrid::operator >>: Element outside of grid");
+#endif
+                is.setstate(std::ios_base::failbit);
+                return is;
+            }
+            grid.set(row, col, elements[row][col]);
+        }
+    }
     return is;
 }
 
@@ -1154,12 +1451,26 @@ const T& randomElement(const SparseGrid<T>& grid) {
     if (grid.isEmpty()) {
         error("randomElement: empty sparse grid was passed");
     }
-    
-    // pick a non-empty row, then pick a random element from it
-    // TODO: fix, this is NOT evenly distributed when rows/cols are unequal in size
-    int row = randomKey(grid.elements);
-    int col = randomKey(grid.elements[row]);
-    return grid.get(row, col);
+
+    // pick the index'th set cell, skipping whole chunks by their population
+    int index = randomInteger(0, grid.size() - 1);
+    for (const auto& key : grid.chunks) {
+        auto chunk = grid.chunks.get(key);
+        int count = SparseGrid<T>::popCount(chunk->occupied);
+        if (index < count) {
+            for (int i = 0; ; i++) {
+                if ((chunk->occupied >> i) & 1) {
+                    if (index == 0) {
+                        return chunk->cells[i];
+                    }
+                    index--;
+                }
+            }
+        }
+        index -= count;
+    }
+    error("randomElement: never found a set cell");
+    return grid.get(0, 0);
 }
 
 #endif // _sparsegrid_h
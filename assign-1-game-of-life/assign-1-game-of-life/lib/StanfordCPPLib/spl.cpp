@@ -1672,6 +1672,230 @@ long Timer::currentTimeMS() {
     return (time.tv_sec * 1000000 + time.tv_usec) / 1000;
 }
 
+/*
+ * File: threadpool.cpp
+ * --------------------
+ * Implementation of the ThreadPool class as declared in threadpool.h.
+ *
+ * @version 2026/10/17
+ * - added fork handlers for the shared pool
+ * @version 2026/10/16
+ * - initial version
+ */
+
+#define INTERNAL_INCLUDE 1
+#include "threadpool.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#ifndef _WIN32
+#include <pthread.h>
+#endif // _WIN32
+#undef INTERNAL_INCLUDE
+
+/*
+ * Set while a thread is running chunks of a parallelFor, so that a nested
+ * parallelFor on that thread runs serially instead of waiting for a pool
+ * that is busy with its caller.
+ */
+static thread_local bool insideParallelFor = false;
+
+/*
+ * Implementation notes: Job
+ * -------------------------
+ * One parallelFor in progress.  Threads claim chunks by incrementing
+ * nextChunk, so faster threads simply end up doing more of them.  The job
+ * lives on the caller's stack; numInside counts the workers currently
+ * using it, and the caller does not return until that count drops to zero
+ * with every chunk finished.
+ */
+struct ThreadPool::Job {
+    const std::function<void (int, int)>* body;
+    int first;
+    int count;
+    int numChunks;
+    std::atomic<int> nextChunk;
+    std::atomic<int> chunksDone;
+    std::atomic<bool> failed;
+    std::exception_ptr error;
+    std::mutex errorLock;
+    int numInside;
+};
+
+ThreadPool::ThreadPool(int numWorkers)
+        : currentJob(nullptr),
+          jobNumber(0),
+          stopping(false) {
+    if (numWorkers < 0) {
+        numWorkers = std::max(0, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    }
+    for (int i = 0; i < numWorkers; i++) {
+        workers.push_back(std::thread(&ThreadPool::workerLoop, this));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    jobPosted.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(int first, int last,
+                             const std::function<void (int, int)>& body,
+                             int minChunkSize) {
+    int count = last - first;
+    if (count <= 0) {
+        return;
+    }
+    int numChunks = std::min(count / std::max(1, minChunkSize), 4 * size());
+    if (numChunks <= 1 || workers.empty() || insideParallelFor) {
+        body(first, last);
+        return;
+    }
+
+    std::lock_guard<std::mutex> callGuard(callLock);
+    Job job;
+    job.body = &body;
+    job.first = first;
+    job.count = count;
+    job.numChunks = numChunks;
+    job.nextChunk = 0;
+    job.chunksDone = 0;
+    job.failed = false;
+    job.numInside = 0;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        currentJob = &job;
+        jobNumber++;
+    }
+    jobPosted.notify_all();
+
+    insideParallelFor = true;
+    runChunks(job);
+    insideParallelFor = false;
+
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        jobFinished.wait(guard, [&job] {
+            return job.chunksDone == job.numChunks && job.numInside == 0;
+        });
+        currentJob = nullptr;
+    }
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
+
+int ThreadPool::size() const {
+    return static_cast<int>(workers.size()) + 1;
+}
+
+bool ThreadPool::isInsideParallelFor() {
+    return insideParallelFor;
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+#ifndef _WIN32
+    static int forkHandlers = pthread_atfork(prepareFork, parentAfterFork, childAfterFork);
+    (void) forkHandlers;
+#endif // _WIN32
+    return pool;
+}
+
+/*
+ * Implementation notes: fork handlers
+ * -----------------------------------
+ * Only the thread that calls fork survives in the child, so the shared
+ * pool's locks must not be held by anybody else at that moment, and the
+ * child must not wait for workers that it does not have.  prepareFork
+ * takes callLock, which waits out any parallelFor in progress, and then
+ * lock; both are released again on each side of the fork.  The child's
+ * std::thread objects name threads that do not exist there, so they are
+ * moved into a vector that is never destroyed rather than being joined.
+ * A thread inside a parallelFor may already hold callLock, so it takes
+ * nothing; that case is documented as unsupported.
+ */
+void ThreadPool::prepareFork() {
+    if (!insideParallelFor) {
+        ThreadPool& pool = shared();
+        pool.callLock.lock();
+        pool.lock.lock();
+    }
+}
+
+void ThreadPool::parentAfterFork() {
+    if (!insideParallelFor) {
+        ThreadPool& pool = shared();
+        pool.lock.unlock();
+        pool.callLock.unlock();
+    }
+}
+
+void ThreadPool::childAfterFork() {
+    if (!insideParallelFor) {
+        ThreadPool& pool = shared();
+        new std::vector<std::thread>(std::move(pool.workers));
+        pool.workers.clear();
+        pool.lock.unlock();
+        pool.callLock.unlock();
+    }
+}
+
+void ThreadPool::runChunks(Job& job) {
+    while (true) {
+        int chunk = job.nextChunk++;
+        if (chunk >= job.numChunks) {
+            return;
+        }
+        if (!job.failed) {
+            int chunkFirst = job.first + static_cast<int>(static_cast<long long>(job.count) * chunk / job.numChunks);
+            int chunkLast = job.first + static_cast<int>(static_cast<long long>(job.count) * (chunk + 1) / job.numChunks);
+            try {
+                (*job.body)(chunkFirst, chunkLast);
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(job.errorLock);
+                if (!job.failed) {
+                    job.error = std::current_exception();
+                    job.failed = true;
+                }
+            }
+        }
+        job.chunksDone++;
+    }
+}
+
+void ThreadPool::workerLoop() {
+    insideParallelFor = true;
+    unsigned long lastJobNumber = 0;
+    while (true) {
+        Job* job;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            jobPosted.wait(guard, [this, lastJobNumber] {
+                return stopping || (currentJob != nullptr && jobNumber != lastJobNumber);
+            });
+            if (stopping) {
+                return;
+            }
+            job = currentJob;
+            lastJobNumber = jobNumber;
+            job->numInside++;
+        }
+        runChunks(*job);
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            job->numInside--;
+        }
+        jobFinished.notify_all();
+    }
+}
+
 /*
  * File: note.cpp
  * --------------
@@ -7464,6 +7688,8 @@ std::string to_string(void* p) {
  * ---------------
  * This file implements the point.h interface.
  * 
+ * @version 2026/10/17
+ * - added hashCode64
  * @version 2018/11/22
  * - added headless mode support
  * @version 2017/09/29
@@ -7526,6 +7752,12 @@ int hashCode(const Point& pt) {
     return hashCode(pt.getX(), pt.getY());
 }
 
+uint64_t hashCode64(const Point& pt) {
+    uint64_t packed = (static_cast<uint64_t>(static_cast<uint32_t>(pt.getX())) << 32)
+            | static_cast<uint32_t>(pt.getY());
+    return hashMix64(packed ^ hashSeed64());
+}
+
 /*
  * File: intrange.cpp
  * ------------------
@@ -24318,22 +24550,22 @@ std::set<std::string> toStlSet(const Lexicon& lex) {
  * and the <code>GridLocationRange</code> class.
  * See gridlocation.h for the declarations of each member.
  *
+ * @version 2026/10/17
+ * - moved constructors, begin, end and isEmpty inline into gridlocation.h
+ * - added colMajor, intersect, numCols, numRows, rowMajor, size
+ * - added hashCode64
  * @version 2018/03/12
  * - initial version
  */
 
 #define INTERNAL_INCLUDE 1
 #include "gridlocation.h"
+#include <algorithm>
 #include <sstream>
 #define INTERNAL_INCLUDE 1
 #include "hashcode.h"
 #undef INTERNAL_INCLUDE
 
-GridLocation::GridLocation(int row, int col) {
-    this->row = row;
-    this->col = col;
-}
-
 GridLocationRange GridLocation::neighbors(int range, bool rowMajor) const {
     return GridLocationRange(row - range, col - range, row + range, col + range, rowMajor);
 }
@@ -24348,6 +24580,12 @@ int hashCode(const GridLocation& loc) {
     return hashCode(loc.row, loc.col);
 }
 
+uint64_t hashCode64(const GridLocation& loc) {
+    uint64_t packed = (static_cast<uint64_t>(static_cast<uint32_t>(loc.row)) << 32)
+            | static_cast<uint32_t>(loc.col);
+    return hashMix64(packed ^ hashSeed64());
+}
+
 bool operator <(const GridLocation& loc1, const GridLocation& loc2) {
     return loc1.row < loc2.row ||
             (loc1.row == loc2.row && loc1.col < loc2.col);
@@ -24412,30 +24650,13 @@ std::istream& operator >>(std::istream& input, GridLocation& loc) {
     return input;
 }
 
-GridLocationRange::GridLocationRange(int startRow, int startCol, int endRow, int endCol, bool isRowMajor)
-        : _start(startRow, startCol),
-          _end(endRow, endCol),
-          _isRowMajor(isRowMajor) {
-    // empty
-}
-
-GridLocationRange::GridLocationRange(const GridLocation& startLoc, const GridLocation& endLoc, bool isRowMajor)
-        : _start(startLoc),
-          _end(endLoc),
-          _isRowMajor(isRowMajor) {
-    // empty
-}
-
-GridLocationRange::GridLocationRangeIterator GridLocationRange::begin() const {
-    return GridLocationRangeIterator(this, /* end */ false);
+GridLocationRange GridLocationRange::colMajor() const {
+    return GridLocationRange(_start, _end, /* isRowMajor */ false);
 }
 
 bool GridLocationRange::contains(const GridLocation& loc) const {
-    return _start <= loc && loc <= _end;
-}
-
-GridLocationRange::GridLocationRangeIterator GridLocationRange::end() const {
-    return GridLocationRangeIterator(this, /* end */ true);
+    return loc.row >= _start.row && loc.row <= _end.row
+            && loc.col >= _start.col && loc.col <= _end.col;
 }
 
 int GridLocationRange::endCol() const {
@@ -24450,14 +24671,34 @@ int GridLocationRange::endRow() const {
     return _end.row;
 }
 
-bool GridLocationRange::isEmpty() const {
-    return _start > _end;
+GridLocationRange GridLocationRange::intersect(const GridLocationRange& other) const {
+    return GridLocationRange(std::max(_start.row, other._start.row),
+                             std::max(_start.col, other._start.col),
+                             std::min(_end.row, other._end.row),
+                             std::min(_end.col, other._end.col),
+                             _isRowMajor);
 }
 
 bool GridLocationRange::isRowMajor() const {
     return _isRowMajor;
 }
 
+int GridLocationRange::numCols() const {
+    return isEmpty() ? 0 : _end.col - _start.col + 1;
+}
+
+int GridLocationRange::numRows() const {
+    return isEmpty() ? 0 : _end.row - _start.row + 1;
+}
+
+GridLocationRange GridLocationRange::rowMajor() const {
+    return GridLocationRange(_start, _end, /* isRowMajor */ true);
+}
+
+int GridLocationRange::size() const {
+    return numRows() * numCols();
+}
+
 int GridLocationRange::startCol() const {
     return _start.col;
 }
@@ -24634,6 +24875,639 @@ std::ostream& writeQuotedString(std::ostream& os, const std::string& str, bool f
     return os;
 }
 
+/*
+ * File: concurrenthashmap.cpp
+ * ---------------------------
+ * This file implements the non-template parts of concurrenthashmap.h: the
+ * epoch-based reclamation that lets ConcurrentHashMap's lookups run
+ * without locks.
+ *
+ * @version 2026/10/17
+ * - initial version
+ */
+
+#define INTERNAL_INCLUDE 1
+#include "concurrenthashmap.h"
+#undef INTERNAL_INCLUDE
+
+namespace stanfordcpplib {
+namespace collections {
+
+/*
+ * Implementation notes: EpochReclaimer
+ * ------------------------------------
+ * Each thread that has ever pinned owns a slot on a global list, on a
+ * cache line of its own.  A slot holds 0 while its thread is not pinned,
+ * and otherwise the epoch it pinned at, shifted left one bit, with the low
+ * bit set.  Slots are never freed: a thread that exits gives its slot back
+ * for another thread to reuse.  The list only ever grows at its head, so
+ * walking it needs no lock.
+ *
+ * The seq_cst fence a reader issues after writing its slot pairs with the
+ * one in advance before the slots are read.  Either advance sees the
+ * reader pinned at an older epoch and holds the epoch back, or the reader
+ * sees every unlink that came before the advance and so cannot reach the
+ * objects it removed.  Slots are read with acquire order, so that a
+ * reader's last look at an object happens before the object is freed.
+ */
+namespace {
+
+struct EpochSlot {
+    EpochSlot() : state(0), inUse(true), next(nullptr) {}
+
+    std::atomic<uint64_t> state;
+    std::atomic<bool> inUse;
+    EpochSlot* next;
+};
+
+const uintptr_t EPOCH_SLOT_ALIGNMENT = 64;
+
+std::atomic<uint64_t> globalEpoch(1);
+std::atomic<EpochSlot*> epochSlots(nullptr);
+
+EpochSlot* claimEpochSlot() {
+    for (EpochSlot* slot = epochSlots.load(std::memory_order_acquire); slot; slot = slot->next) {
+        bool expected = false;
+        if (!slot->inUse.load(std::memory_order_relaxed)
+                && slot->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return slot;
+        }
+    }
+    void* storage = ::operator new(2 * EPOCH_SLOT_ALIGNMENT);
+    uintptr_t line = (reinterpret_cast<uintptr_t>(storage) + EPOCH_SLOT_ALIGNMENT - 1)
+            & ~(EPOCH_SLOT_ALIGNMENT - 1);
+    EpochSlot* slot = new (reinterpret_cast<void*>(line)) EpochSlot();
+    EpochSlot* head = epochSlots.load(std::memory_order_relaxed);
+    do {
+        slot->next = head;
+    } while (!epochSlots.compare_exchange_weak(head, slot, std::memory_order_release,
+                                               std::memory_order_relaxed));
+    return slot;
+}
+
+/*
+ * The calling thread's slot, claimed on its first pin, and how many pins
+ * it has outstanding.
+ */
+struct EpochThread {
+    EpochThread() : slot(nullptr), depth(0) {}
+
+    ~EpochThread() {
+        if (slot) {
+            slot->state.store(0, std::memory_order_release);
+            slot->inUse.store(false, std::memory_order_release);
+        }
+    }
+
+    EpochSlot* slot;
+    int depth;
+};
+
+thread_local EpochThread epochThread;
+
+} // namespace
+
+void EpochReclaimer::pin() {
+    EpochThread& self = epochThread;
+    if (self.depth++ == 0) {
+        if (!self.slot) {
+            self.slot = claimEpochSlot();
+        }
+        uint64_t epoch = globalEpoch.load(std::memory_order_relaxed);
+        self.slot->state.store((epoch << 1) | 1, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+void EpochReclaimer::unpin() {
+    EpochThread& self = epochThread;
+    if (--self.depth == 0) {
+        self.slot->state.store(0, std::memory_order_release);
+    }
+}
+
+uint64_t EpochReclaimer::retireEpoch() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return globalEpoch.load(std::memory_order_relaxed);
+}
+
+uint64_t EpochReclaimer::advance() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t epoch = globalEpoch.load(std::memory_order_relaxed);
+    for (EpochSlot* slot = epochSlots.load(std::memory_order_acquire); slot; slot = slot->next) {
+        uint64_t state = slot->state.load(std::memory_order_acquire);
+        if ((state & 1) && (state >> 1) != epoch) {
+            return epoch;
+        }
+    }
+    if (globalEpoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst)) {
+        epoch++;
+    }
+    return epoch;
+}
+
+RetireList::RetireList()
+        : nextCollect(COLLECT_INTERVAL) {
+    // empty
+}
+
+RetireList::~RetireList() {
+    freeAll();
+}
+
+void RetireList::retire(void* object, Destroyer destroy) {
+    Entry entry = { object, destroy, EpochReclaimer::retireEpoch() };
+    entries.push_back(entry);
+    if (entries.size() >= nextCollect) {
+        collect();
+    }
+}
+
+void RetireList::collect() {
+    uint64_t epoch = EpochReclaimer::advance();
+    size_t numFreed = 0;
+    while (numFreed < entries.size() && entries[numFreed].epoch + 2 <= epoch) {
+        entries[numFreed].destroy(entries[numFreed].object);
+        numFreed++;
+    }
+    entries.erase(entries.begin(), entries.begin() + numFreed);
+    nextCollect = entries.size() + COLLECT_INTERVAL;
+}
+
+void RetireList::freeAll() {
+    for (const Entry& entry : entries) {
+        entry.destroy(entry.object);
+    }
+    entries.clear();
+    nextCollect = COLLECT_INTERVAL;
+}
+
+} // namespace collections
+} // namespace stanfordcpplib
+
+/*
+ * File: mappedgrid.cpp
+ * --------------------
+ * Implementation of the MappedFile class used by mappedgrid.h, with one
+ * version for Windows and one for POSIX systems.
+ *
+ * @version 2026/10/16
+ * - initial version
+ */
+
+#define INTERNAL_INCLUDE 1
+#include "mappedgrid.h"
+#define INTERNAL_INCLUDE 1
+#include "error.h"
+#undef INTERNAL_INCLUDE
+#include <cerrno>
+#include <cstring>
+#ifdef _WIN32
+#  include <windows.h>
+#  undef MOUSE_EVENT
+#  undef KEY_EVENT
+#  undef MOUSE_MOVED
+#  undef HELP_KEY
+#else // _WIN32
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif // _WIN32
+
+namespace stanfordcpplib {
+namespace collections {
+
+MappedFile::MappedFile()
+        : address(nullptr),
+          length(0) {
+    // empty
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+char* MappedFile::data() const {
+    return address;
+}
+
+int64_t MappedFile::size() const {
+    return length;
+}
+
+#ifdef _WIN32
+
+/*
+ * Implementation notes: Windows
+ * -----------------------------
+ * The file and its mapping object stay open for as long as the view is
+ * mapped.  FILE_MAP_COPY gives copy-on-write pages, which Windows calls
+ * PAGE_WRITECOPY when making the mapping object.
+ */
+static void mappingError(const std::string& prefix, const std::string& filename) {
+    error("MappedGrid::" + prefix + ": " + filename + ": error code "
+          + std::to_string(static_cast<unsigned long>(GetLastError())));
+}
+
+void MappedFile::open(const std::string& filename, MappedGridMode mode) {
+    close();
+    bool writable = mode == MAPPED_SHARED;
+    HANDLE file = CreateFileA(filename.c_str(),
+                              writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        mappingError("open", filename);
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        error("MappedGrid::open: " + filename + ": file is too short to be a grid file");
+    }
+    DWORD protect = mode == MAPPED_READ_ONLY ? PAGE_READONLY
+                  : mode == MAPPED_COPY_ON_WRITE ? PAGE_WRITECOPY : PAGE_READWRITE;
+    HANDLE mapping = CreateFileMappingA(file, nullptr, protect, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        mappingError("open", filename);
+    }
+    DWORD access = mode == MAPPED_READ_ONLY ? FILE_MAP_READ
+                 : mode == MAPPED_COPY_ON_WRITE ? FILE_MAP_COPY : FILE_MAP_WRITE;
+    void* view = MapViewOfFile(mapping, access, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        mappingError("open", filename);
+    }
+    address = static_cast<char*>(view);
+    length = fileSize.QuadPart;
+    fileHandle = file;
+    mappingHandle = mapping;
+}
+
+void MappedFile::create(const std::string& filename, int64_t size) {
+    close();
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE,
+                              FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        mappingError("create", filename);
+    }
+    LARGE_INTEGER fileSize;
+    fileSize.QuadPart = size;
+    if (!SetFilePointerEx(file, fileSize, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+        CloseHandle(file);
+        mappingError("create", filename);
+    }
+    CloseHandle(file);
+    open(filename, MAPPED_SHARED);
+}
+
+void MappedFile::close() {
+    if (address) {
+        UnmapViewOfFile(address);
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+        address = nullptr;
+        length = 0;
+        fileHandle = nullptr;
+        mappingHandle = nullptr;
+    }
+}
+
+void MappedFile::flush() {
+    if (address) {
+        FlushViewOfFile(address, 0);
+        FlushFileBuffers(static_cast<HANDLE>(fileHandle));
+    }
+}
+
+void MappedFile::prefetch(int64_t /* offset */, int64_t /* length */) {
+    // Windows reads ahead on its own; there is no portable hint to give
+}
+
+#else // _WIN32
+
+/*
+ * Implementation notes: POSIX
+ * ---------------------------
+ * The descriptor can be closed as soon as the file is mapped.  Read-only
+ * and copy-on-write mappings both open the file read-only; MAP_PRIVATE is
+ * what makes the pages of a copy-on-write mapping writable and private.
+ * Nothing is read in advance (there is no MAP_POPULATE), so pages are
+ * faulted in as they are first touched.
+ */
+static void mappingError(const std::string& prefix, const std::string& filename) {
+    error("MappedGrid::" + prefix + ": " + filename + ": " + std::strerror(errno));
+}
+
+void MappedFile::open(const std::string& filename, MappedGridMode mode) {
+    close();
+    int fd = ::open(filename.c_str(), mode == MAPPED_SHARED ? O_RDWR : O_RDONLY);
+    if (fd < 0) {
+        mappingError("open", filename);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        mappingError("open", filename);
+    }
+    if (info.st_size == 0) {
+        ::close(fd);
+        error("MappedGrid::open: " + filename + ": file is too short to be a grid file");
+    }
+    int protect = mode == MAPPED_READ_ONLY ? PROT_READ : PROT_READ | PROT_WRITE;
+    int flags = mode == MAPPED_SHARED ? MAP_SHARED : MAP_PRIVATE;
+    void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), protect, flags, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        mappingError("open", filename);
+    }
+    address = static_cast<char*>(mapped);
+    length = info.st_size;
+}
+
+void MappedFile::create(const std::string& filename, int64_t size) {
+    close();
+    int fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        mappingError("create", filename);
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        mappingError("create", filename);
+    }
+    ::close(fd);
+    open(filename, MAPPED_SHARED);
+}
+
+void MappedFile::close() {
+    if (address) {
+        munmap(address, static_cast<size_t>(length));
+        address = nullptr;
+        length = 0;
+    }
+}
+
+void MappedFile::flush() {
+    if (address) {
+        msync(address, static_cast<size_t>(length), MS_SYNC);
+    }
+}
+
+void MappedFile::prefetch(int64_t offset, int64_t length) {
+    if (!address || offset < 0 || length <= 0 || offset >= this->length) {
+        return;
+    }
+    if (length > this->length - offset) {
+        length = this->length - offset;
+    }
+    // madvise wants a page-aligned start
+    int64_t pageSize = sysconf(_SC_PAGESIZE);
+    int64_t start = offset / pageSize * pageSize;
+    madvise(address + start, static_cast<size_t>(offset + length - start), MADV_WILLNEED);
+}
+
+#endif // _WIN32
+
+} // namespace collections
+} // namespace stanfordcpplib
+
+/*
+ * File: binaryio.cpp
+ * ------------------
+ * This file implements the non-template parts of binaryio.h.
+ *
+ * @version 2026/10/17
+ * - BinaryReader checks counts against the length of seekable input
+ * @version 2026/10/16
+ * - initial version
+ */
+
+#define INTERNAL_INCLUDE 1
+#include "binaryio.h"
+#define INTERNAL_INCLUDE 1
+#include "error.h"
+#undef INTERNAL_INCLUDE
+#include <cstring>
+
+namespace stanfordcpplib {
+namespace collections {
+
+/*
+ * Implementation notes: header and checksum
+ * -----------------------------------------
+ * The header is the four bytes "SPLB", a format version, a flags byte, the
+ * length of the type code as two bytes (low byte first), and the type code
+ * itself.  The checksum covers every byte after the header and is written
+ * after the data in the writer's byte order.
+ */
+static const char kBinaryMagic[4] = { 'S', 'P', 'L', 'B' };
+static const unsigned char kBinaryVersion = 1;
+static const unsigned char kBinaryChecksumFlag = 0x01;
+static const unsigned char kBinaryBigEndianFlag = 0x02;
+static const uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ULL;
+static const uint64_t kFnvPrime = 0x100000001b3ULL;
+
+static bool isBigEndian() {
+    uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 0;
+}
+
+
+void writeBinaryHeader(std::ostream& out, const std::string& typeCode, bool checksum) {
+    unsigned char flags = (checksum ? kBinaryChecksumFlag : 0)
+                        | (isBigEndian() ? kBinaryBigEndianFlag : 0);
+    unsigned char fixed[8] = {
+        static_cast<unsigned char>(kBinaryMagic[0]), static_cast<unsigned char>(kBinaryMagic[1]),
+        static_cast<unsigned char>(kBinaryMagic[2]), static_cast<unsigned char>(kBinaryMagic[3]),
+        kBinaryVersion, flags,
+        static_cast<unsigned char>(typeCode.size() & 0xff),
+        static_cast<unsigned char>(typeCode.size() >> 8)
+    };
+    out.write(reinterpret_cast<const char*>(fixed), sizeof(fixed));
+    out.write(typeCode.data(), typeCode.size());
+}
+
+bool readBinaryHeader(std::istream& in, const std::string& typeCode) {
+    unsigned char fixed[8];
+    if (!in.read(reinterpret_cast<char*>(fixed), sizeof(fixed))
+            || std::memcmp(fixed, kBinaryMagic, 4) != 0) {
+        error("readBinary: input is not binary collection data");
+    }
+    if (fixed[4] != kBinaryVersion) {
+        error("readBinary: unsupported binary data version");
+    }
+    if (((fixed[5] & kBinaryBigEndianFlag) != 0) != isBigEndian()) {
+        error("readBinary: data were written with a different byte order");
+    }
+    std::string found(fixed[6] | (fixed[7] << 8), '\0');
+    if (!found.empty() && !in.read(&found[0], found.size())) {
+        error("readBinary: unexpected end of input");
+    }
+    if (found != typeCode) {
+        error("readBinary: input holds type " + found + ", not " + typeCode);
+    }
+    return (fixed[5] & kBinaryChecksumFlag) != 0;
+}
+
+BinaryChecksum::BinaryChecksum()
+        : sum(kFnvOffsetBasis),
+          pending(0),
+          pendingBytes(0) {
+    // empty
+}
+
+/*
+ * Implementation notes: BinaryChecksum::update
+ * --------------------------------------------
+ * Bytes are gathered into words in the order they arrive, so the words are
+ * the same however the input is split.  Once no partial word is pending,
+ * whole words are taken straight from the input.
+ */
+void BinaryChecksum::update(const void* bytes, int64_t length) {
+    const unsigned char* p = static_cast<const unsigned char*>(bytes);
+    const unsigned char* end = p + length;
+    while (p < end && pendingBytes != 0) {
+        pending |= static_cast<uint64_t>(*p++) << (8 * pendingBytes);
+        if (++pendingBytes == 8) {
+            sum = (sum ^ pending) * kFnvPrime;
+            pending = 0;
+            pendingBytes = 0;
+        }
+    }
+    while (end - p >= 8) {
+        uint64_t word = 0;
+        for (int i = 0; i < 8; i++) {
+            word |= static_cast<uint64_t>(p[i]) << (8 * i);
+        }
+        sum = (sum ^ word) * kFnvPrime;
+        p += 8;
+    }
+    while (p < end) {
+        pending |= static_cast<uint64_t>(*p++) << (8 * pendingBytes);
+        pendingBytes++;
+    }
+}
+
+uint64_t BinaryChecksum::value() const {
+    if (pendingBytes == 0) {
+        return sum;
+    }
+    return (((sum ^ pending) * kFnvPrime) ^ static_cast<uint64_t>(pendingBytes)) * kFnvPrime;
+}
+
+BinaryWriter::BinaryWriter(std::ostream& out, bool checksum)
+        : out(out),
+          checksum(checksum) {
+    // empty
+}
+
+BinaryWriter::~BinaryWriter() {
+    // empty
+}
+
+void BinaryWriter::write(const void* bytes, int64_t length) {
+    if (checksum) {
+        sum.update(bytes, length);
+    }
+    if (out.rdbuf()->sputn(static_cast<const char*>(bytes), length) != length) {
+        out.setstate(std::ios::badbit);
+    }
+}
+
+void BinaryWriter::writeCount(int64_t count) {
+    write(&count, sizeof(count));
+}
+
+void BinaryWriter::finish() {
+    uint64_t value = sum.value();
+    if (checksum && out.rdbuf()->sputn(reinterpret_cast<const char*>(&value), sizeof(value))
+            != static_cast<std::streamsize>(sizeof(value))) {
+        out.setstate(std::ios::badbit);
+    }
+    if (!out) {
+        error("writeBinary: error writing output");
+    }
+}
+
+/*
+ * The length of the input is found by seeking to its end and back.
+ * Streams that cannot seek, such as pipes and the console, report failure,
+ * and their length stays unknown.
+ */
+BinaryReader::BinaryReader(std::istream& in, bool checksum)
+        : in(in),
+          checksum(checksum),
+          remaining(-1) {
+    std::streambuf* buf = in.rdbuf();
+    std::streampos here = buf->pubseekoff(0, std::ios::cur, std::ios::in);
+    if (here != std::streampos(-1)) {
+        std::streampos end = buf->pubseekoff(0, std::ios::end, std::ios::in);
+        if (end != std::streampos(-1)) {
+            remaining = static_cast<int64_t>(end - here);
+            buf->pubseekpos(here, std::ios::in);
+        }
+    }
+}
+
+BinaryReader::~BinaryReader() {
+    // empty
+}
+
+void BinaryReader::read(void* bytes, int64_t length) {
+    readRaw(bytes, length);
+    if (checksum) {
+        sum.update(bytes, length);
+    }
+}
+
+int BinaryReader::readCount(int64_t minBytes) {
+    int64_t count;
+    read(&count, sizeof(count));
+    checkCount(count, minBytes);
+    return static_cast<int>(count);
+}
+
+void BinaryReader::checkCount(int64_t count, int64_t minBytes) {
+    if (count < 0 || count > INT_MAX) {
+        error("readBinary: data are damaged (bad collection size)");
+    }
+    if (remaining >= 0 && count * minBytes > remaining) {
+        error("readBinary: data are damaged (collection size exceeds input)");
+    }
+}
+
+bool BinaryReader::knowsLength() const {
+    return remaining >= 0;
+}
+
+void BinaryReader::finish() {
+    if (checksum) {
+        uint64_t expected;
+        readRaw(&expected, sizeof(expected));
+        if (expected != sum.value()) {
+            error("readBinary: data are damaged (checksum does not match)");
+        }
+    }
+}
+
+void BinaryReader::readRaw(void* bytes, int64_t length) {
+    if (in.rdbuf()->sgetn(static_cast<char*>(bytes), length) != length) {
+        in.setstate(std::ios::eofbit | std::ios::failbit);
+        error("readBinary: unexpected end of input");
+    }
+    if (remaining >= 0) {
+        remaining -= length;
+    }
+}
+
+} // namespace collections
+} // namespace stanfordcpplib
+
 /*
  * File: dawglexicon.cpp
  * ---------------------
@@ -25214,6 +26088,10 @@ static uint32_t my_ntohl(uint32_t arg) {
  * ------------------
  * This file implements the interface declared in hashcode.h.
  *
+ * @version 2026/10/17
+ * - added seeded 64-bit hashing (hashSeed64, hashCode64, hashBytes64)
+ * - long, unsigned long and pointer hash codes fold in their high 32 bits
+ *   instead of discarding them; added long long overloads
  * @version 2018/08/10
  * - bugfixes involving negative hash codes, unified string hashing
  * @version 2017/10/21
@@ -25225,8 +26103,11 @@ static uint32_t my_ntohl(uint32_t arg) {
 #define INTERNAL_INCLUDE 1
 #include "hashcode.h"
 #undef INTERNAL_INCLUDE
+#include <chrono>
 #include <cstddef>       // For size_t
-#include <cstring>       // For strlen
+#include <cstdlib>       // For getenv, strtoull
+#include <cstring>       // For strlen, memcpy
+#include <random>
 
 static const int HASH_SEED = 5381;               // Starting point for first cycle
 static const int HASH_MULTIPLIER = 33;           // Multiplier for each cycle
@@ -25276,11 +26157,24 @@ int hashCode(unsigned int key) {
 }
 
 int hashCode(long key) {
-    return hashCode(static_cast<int>(key));
+    return hashCode(static_cast<unsigned long long>(key));
 }
 
 int hashCode(unsigned long key) {
-    return hashCode(static_cast<int>(key));
+    return hashCode(static_cast<unsigned long long>(key));
+}
+
+int hashCode(long long key) {
+    return hashCode(static_cast<unsigned long long>(key));
+}
+
+/*
+ * Folds the high half into the low half so that keys differing only in
+ * their upper 32 bits (such as packed coordinates or pointers) do not all
+ * collide, as they did when these were simply truncated to int.
+ */
+int hashCode(unsigned long long key) {
+    return hashCode(static_cast<int>(key ^ (key >> 32)));
 }
 
 int hashCode(short key) {
@@ -25298,7 +26192,7 @@ int hashCode(unsigned short key) {
  * overloads just treats the pointer value numerically.
  */
 int hashCode(void* key) {
-    return hashCode(reinterpret_cast<long>(key));
+    return hashCode(static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(key)));
 }
 
 /*
@@ -25332,6 +26226,172 @@ int hashCode(double key) {
     return hashCode(reinterpret_cast<const char *>(&key), sizeof(double));
 }
 
+/*
+ * Implementation notes: hashSeed64
+ * --------------------------------
+ * The seed is drawn once, on first use, from std::random_device mixed with
+ * the clock and the address of a local (which varies under ASLR), so that
+ * it differs from run to run even where random_device is deterministic.
+ * Initializing it inside the function rather than as a global means that
+ * hash tables filled during static initialization see the same seed as
+ * everyone else.
+ */
+static uint64_t chooseHashSeed() {
+    const char* fixed = getenv("SPL_HASH_SEED");
+    if (fixed && *fixed) {
+        return hashMix64(strtoull(fixed, nullptr, 0) + 0x9e3779b97f4a7c15ULL);
+    }
+    uint64_t seed = static_cast<uint64_t>(
+            std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    seed = hashCombine(seed, reinterpret_cast<uintptr_t>(&seed));
+    try {
+        std::random_device device;
+        seed = hashCombine(seed, (static_cast<uint64_t>(device()) << 32) | device());
+    } catch (...) {
+        // no entropy source available; the clock and address will have to do
+    }
+    return seed;
+}
+
+uint64_t hashSeed64() {
+    static const uint64_t seed = chooseHashSeed();
+    return seed;
+}
+
+/*
+ * Implementation notes: hashCode64(integer types)
+ * -----------------------------------------------
+ * Integers are widened to 64 bits, combined with the seed and put through
+ * hashMix64, which is a bijection, so distinct keys of the same type never
+ * collide in the full 64-bit result.
+ */
+uint64_t hashCode64(unsigned long long key) {
+    return hashMix64(key ^ hashSeed64());
+}
+
+uint64_t hashCode64(long long key) {
+    return hashCode64(static_cast<unsigned long long>(key));
+}
+
+uint64_t hashCode64(bool key) {
+    return hashCode64(static_cast<unsigned long long>(key));
+}
+
+uint64_t hashCode64(char key) {
+    return hashCode64(static_cast<unsigned long long>(key));
+}
+
+uint64_t hashCode64(int key) {
+    return hashCode64(static_cast<unsigned long long>(key));
+}
+
+uint64_t hashCode64(unsigned int key) {
+    return hashCode64(static_cast<unsigned long long>(key));
+}
+
+uint64_t hashCode64(long key) {
+    return hashCode64(static_cast<unsigned long long>(key));
+}
+
+uint64_t hashCode64(unsigned long key) {
+    return hashCode64(static_cast<unsigned long long>(key));
+}
+
+uint64_t hashCode64(short key) {
+    return hashCode64(static_cast<unsigned long long>(key));
+}
+
+uint64_t hashCode64(unsigned short key) {
+    return hashCode64(static_cast<unsigned long long>(key));
+}
+
+uint64_t hashCode64(void* key) {
+    return hashCode64(static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(key)));
+}
+
+/*
+ * Implementation notes: hashBytes64
+ * ---------------------------------
+ * The byte hash follows the structure of wyhash: the input is consumed
+ * 16 bytes at a time, and each pair of 8-byte words (xored with constants
+ * and the running state) is multiplied into a 128-bit product whose two
+ * halves are xored together.  A final round mixes in the length.  Words
+ * are read with memcpy, so the input need not be aligned; the results
+ * depend on the machine's byte order, which is fine for in-memory tables.
+ */
+static const uint64_t kHashPrime0 = 0xa0761d6478bd642fULL;
+static const uint64_t kHashPrime1 = 0xe7037ed1a0b428dbULL;
+static const uint64_t kHashPrime2 = 0x8ebc6af09c88c6e3ULL;
+
+static inline uint64_t hashMultiplyFold(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+    uint64_t aLo = a & 0xffffffffULL, aHi = a >> 32;
+    uint64_t bLo = b & 0xffffffffULL, bHi = b >> 32;
+    uint64_t loLo = aLo * bLo, hiLo = aHi * bLo, loHi = aLo * bHi, hiHi = aHi * bHi;
+    uint64_t middle = (loLo >> 32) + (hiLo & 0xffffffffULL) + loHi;
+    uint64_t lo = (middle << 32) | (loLo & 0xffffffffULL);
+    uint64_t hi = hiHi + (hiLo >> 32) + (middle >> 32);
+    return lo ^ hi;
+#endif
+}
+
+static inline uint64_t hashRead64(const unsigned char* p) {
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+uint64_t hashBytes64(const void* data, size_t numBytes) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t state = hashSeed64() ^ kHashPrime0;
+    size_t remaining = numBytes;
+    while (remaining > 16) {
+        state = hashMultiplyFold(hashRead64(p) ^ kHashPrime1, hashRead64(p + 8) ^ state);
+        p += 16;
+        remaining -= 16;
+    }
+
+    // the last 1-16 bytes, zero-padded into two words
+    unsigned char tail[16] = {0};
+    memcpy(tail, p, remaining);
+    state = hashMultiplyFold(hashRead64(tail) ^ kHashPrime1, hashRead64(tail + 8) ^ state);
+    return hashMultiplyFold(state ^ kHashPrime2, static_cast<uint64_t>(numBytes) ^ kHashPrime1);
+}
+
+uint64_t hashCode64(const char* str) {
+    return hashBytes64(str, strlen(str));
+}
+
+uint64_t hashCode64(char* str) {
+    return hashCode64(static_cast<const char*>(str));
+}
+
+uint64_t hashCode64(const std::string& str) {
+    return hashBytes64(str.data(), str.length());
+}
+
+/*
+ * Floating-point values that compare equal must hash equally, so both
+ * zeros are hashed as +0.0; otherwise the bits of the value are hashed.
+ */
+uint64_t hashCode64(double key) {
+    if (key == 0) {
+        key = 0;
+    }
+    return hashBytes64(&key, sizeof(key));
+}
+
+uint64_t hashCode64(float key) {
+    return hashCode64(static_cast<double>(key));
+}
+
+uint64_t hashCode64(long double key) {
+    return hashCode64(static_cast<double>(key));
+}
+
 int hashCode(float key) {
     return hashCode(reinterpret_cast<const char *>(&key), sizeof(float));
 }
@@ -25357,6 +26417,8 @@ int hashCode(long double key) {
  *
  * The original DAWG implementation is retained as dawglexicon.h/cpp.
  * 
+ * @version 2026/10/17
+ * - contains and containsPrefix walk the trie without copying the word
  * @version 2018/03/10
  * - added method front
  * @version 2016/09/24
@@ -25507,15 +26569,12 @@ void Lexicon::clear() {
     m_root = nullptr;
 }
 
-bool Lexicon::contains(const std::string& word) const {
-    if (word.empty()) {
+bool Lexicon::contains(const StringView& word) const {
+    if (word.isEmpty()) {
         return false;
     }
-    std::string scrubbed = word;
-    if (!scrub(scrubbed)) {
-        return false;
-    }
-    return containsHelper(m_root, scrubbed, /* isPrefix */ false);
+    TrieNode* node = findNode(word);
+    return node && node->isWord();
 }
 
 bool Lexicon::containsAll(const Lexicon& lex2) const {
@@ -25536,15 +26595,11 @@ bool Lexicon::containsAll(std::initializer_list<std::string> list) const {
     return true;
 }
 
-bool Lexicon::containsPrefix(const std::string& prefix) const {
-    if (prefix.empty()) {
+bool Lexicon::containsPrefix(const StringView& prefix) const {
+    if (prefix.isEmpty()) {
         return true;
     }
-    std::string scrubbed = prefix;
-    if (!scrub(scrubbed)) {
-        return false;
-    }
-    return containsHelper(m_root, scrubbed, /* isPrefix */ true);
+    return findNode(prefix) != nullptr;
 }
 
 bool Lexicon::equals(const Lexicon& lex2) const {
@@ -25825,22 +26880,23 @@ bool Lexicon::addHelper(TrieNode*& node, const std::string& word, const std::str
     }
 }
 
-// pre: word is scrubbed to contain only lowercase a-z letters
-bool Lexicon::containsHelper(TrieNode* node, const std::string& word, bool isPrefix) const {
-    if (!node) {
-        // base case: no pointer down to here, so prefix must not exist
-        return false;
-    } else if (word.length() == 0) {
-        // base case: Found nodes all the way down.
-        // If we are looking for a prefix, this means this path IS a prefix,
-        // so we should return true.
-        // If we are looking for an exact word match rather than a prefix,
-        // we must check the isWord flag to see that this word was added
-        return (isPrefix ? true : node->isWord());
-    } else {
-        // recursive case: follow appropriate child pointer for one letter
-        return containsHelper(node->child(word[0]), word.substr(1), isPrefix);
+/*
+ * Follows the letters of the given word down from the root, lowercasing
+ * each one as scrub does, and returns the node it ends at, or nullptr if
+ * the word has a non-letter or leaves the trie.  Used by contains and
+ * containsPrefix, so that a lookup neither copies the word nor builds a
+ * substring per letter.
+ */
+Lexicon::TrieNode* Lexicon::findNode(const StringView& word) const {
+    TrieNode* node = m_root;
+    for (size_t i = 0; node && i < word.length(); i++) {
+        char ch = static_cast<char>(tolower(static_cast<unsigned char>(word[i])));
+        if (ch < 'a' || ch > 'z') {
+            return nullptr;
+        }
+        node = node->child(ch);
     }
+    return node;
 }
 
 // pre: word is scrubbed to contain only lowercase a-z letters
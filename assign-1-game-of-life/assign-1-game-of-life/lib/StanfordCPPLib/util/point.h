@@ -4,6 +4,8 @@
  * This file exports a class representing an integer-valued <i>x</i>-<i>y</i>
  * pair.
  *
+ * @version 2026/10/17
+ * - added hashCode64
  * @version 2018/11/22
  * - added headless mode support
  * @version 2018/09/25
@@ -19,6 +21,7 @@
 #ifndef _point_h
 #define _point_h
 
+#include <cstdint>
 #include <string>
 
 #ifndef SPL_HEADLESS_MODE
@@ -103,4 +106,9 @@ std::ostream& operator <<(std::ostream& os, const Point& pt);
  */
 int hashCode(const Point& pt);
 
+/**
+ * Seeded 64-bit hash code function for Point objects (see hashcode.h).
+ */
+uint64_t hashCode64(const Point& pt);
+
 #endif // _point_h
@@ -0,0 +1,280 @@
+/*
+ * File: stringview.h
+ * ------------------
+ * This file exports the <code>StringView</code> class, a read-only view of
+ * a run of characters stored somewhere else, such as in a
+ * <code>string</code>, a C string, or part of either.
+ *
+ * @version 2026/10/17
+ * - initial version
+ */
+
+#include "private/init.h"   // ensure that Stanford C++ lib is initialized
+
+#ifndef INTERNAL_INCLUDE
+#include "private/initstudent.h"   // insert necessary included code by student
+#endif // INTERNAL_INCLUDE
+
+#ifndef _stringview_h
+#define _stringview_h
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+#define INTERNAL_INCLUDE 1
+#include "error.h"
+#define INTERNAL_INCLUDE 1
+#include "hashcode.h"
+#undef INTERNAL_INCLUDE
+
+/*
+ * Class: StringView
+ * -----------------
+ * A StringView refers to characters that it does not own, so making one
+ * never allocates memory.  It is meant for passing text to functions that
+ * only read it, such as lookups in collections with string keys:
+ *
+ *<pre>
+ *    HashMap<string, int> counts;
+ *    ...
+ *    if (counts.containsKey(StringView(line, start, length))) ...
+ *</pre>
+ *
+ * The characters must stay alive and unchanged for as long as the view is
+ * used.  StringViews compare and hash exactly like the equivalent
+ * <code>string</code>.
+ */
+class StringView {
+public:
+    /*
+     * Constant: npos
+     * --------------
+     * Passed as a length, means "through the end of the string".
+     */
+    static const size_t npos = static_cast<size_t>(-1);
+
+    /*
+     * Constructor: StringView
+     * Usage: StringView view;
+     *        StringView view(str);
+     *        StringView view(chars, length);
+     *        StringView view(str, start, length);
+     * ---------------------------------------
+     * Creates a view of the empty string, of the given string or
+     * null-terminated C string, of the given number of characters, or of
+     * part of a string.
+     */
+    StringView()
+            : m_data(""),
+              m_length(0) {
+        // empty
+    }
+
+    StringView(const char* str)
+            : m_data(str),
+              m_length(std::strlen(str)) {
+        // empty
+    }
+
+    StringView(const char* chars, size_t length)
+            : m_data(chars),
+              m_length(length) {
+        // empty
+    }
+
+    StringView(const std::string& str)
+            : m_data(str.data()),
+              m_length(str.length()) {
+        // empty
+    }
+
+    StringView(const std::string& str, size_t start, size_t length = npos)
+            : m_data(str.data()),
+              m_length(str.length()) {
+        *this = substr(start, length);
+    }
+
+    /*
+     * Method: begin, end, data
+     * ------------------------
+     * Return pointers to the first character of the view and one past its
+     * last character.  The characters are not null-terminated in general.
+     */
+    const char* begin() const {
+        return m_data;
+    }
+
+    const char* end() const {
+        return m_data + m_length;
+    }
+
+    const char* data() const {
+        return m_data;
+    }
+
+    /*
+     * Method: compare
+     * Usage: int cmp = view.compare(other);
+     * -------------------------------------
+     * Returns a negative number, zero, or a positive number depending on
+     * whether this view comes before, is equal to, or comes after the given
+     * one, in the same order that <code>string::compare</code> uses.
+     */
+    int compare(const StringView& other) const {
+        size_t length = m_length < other.m_length ? m_length : other.m_length;
+        int cmp = std::char_traits<char>::compare(m_data, other.m_data, length);
+        if (cmp != 0) {
+            return cmp;
+        }
+        return m_length < other.m_length ? -1 : (m_length > other.m_length ? 1 : 0);
+    }
+
+    /*
+     * Method: isEmpty
+     * Usage: if (view.isEmpty()) ...
+     * ------------------------------
+     * Returns true if the view contains no characters.
+     */
+    bool isEmpty() const {
+        return m_length == 0;
+    }
+
+    /*
+     * Method: length, size
+     * Usage: int n = view.length();
+     * -----------------------------
+     * Returns the number of characters in the view.
+     */
+    size_t length() const {
+        return m_length;
+    }
+
+    size_t size() const {
+        return m_length;
+    }
+
+    /*
+     * Method: startsWith
+     * Usage: if (view.startsWith(prefix)) ...
+     * ---------------------------------------
+     * Returns true if the view begins with the given characters.
+     */
+    bool startsWith(const StringView& prefix) const {
+        return prefix.m_length <= m_length
+                && std::char_traits<char>::compare(m_data, prefix.m_data, prefix.m_length) == 0;
+    }
+
+    /*
+     * Method: substr
+     * Usage: StringView part = view.substr(start, length);
+     * ----------------------------------------------------
+     * Returns a view of up to the given number of characters beginning at
+     * index start, without copying them.  If start is past the end of the
+     * view, generates an error.
+     */
+    StringView substr(size_t start, size_t length = npos) const {
+        if (start > m_length) {
+            error("StringView::substr: start index out of range");
+        }
+        size_t remaining = m_length - start;
+        return StringView(m_data + start, length < remaining ? length : remaining);
+    }
+
+    /*
+     * Method: toString
+     * Usage: string str = view.toString();
+     * ------------------------------------
+     * Returns a new string holding a copy of the characters in the view.
+     */
+    std::string toString() const {
+        return std::string(m_data, m_length);
+    }
+
+    /*
+     * Operator: []
+     * Usage: char ch = view[i];
+     * -------------------------
+     * Returns the character at the given index, which is not checked.
+     */
+    char operator [](size_t index) const {
+        return m_data[index];
+    }
+
+private:
+    const char* m_data;
+    size_t m_length;
+};
+
+/*
+ * Operators: ==, !=, <, <=, >, >=
+ * Usage: if (view1 == view2) ...
+ * ------------------------------
+ * Compare two views, or a view and a string, by their characters.
+ */
+inline bool operator ==(const StringView& v1, const StringView& v2) {
+    return v1.length() == v2.length() && v1.compare(v2) == 0;
+}
+
+inline bool operator !=(const StringView& v1, const StringView& v2) {
+    return !(v1 == v2);
+}
+
+inline bool operator <(const StringView& v1, const StringView& v2) {
+    return v1.compare(v2) < 0;
+}
+
+inline bool operator <=(const StringView& v1, const StringView& v2) {
+    return v1.compare(v2) <= 0;
+}
+
+inline bool operator >(const StringView& v1, const StringView& v2) {
+    return v1.compare(v2) > 0;
+}
+
+inline bool operator >=(const StringView& v1, const StringView& v2) {
+    return v1.compare(v2) >= 0;
+}
+
+/*
+ * Operator: <<
+ * Usage: cout << view;
+ * --------------------
+ * Writes the characters of the view to the given stream.
+ */
+inline std::ostream& operator <<(std::ostream& os, const StringView& view) {
+    return os.write(view.data(), static_cast<std::streamsize>(view.length()));
+}
+
+/*
+ * Returns the same 64-bit hash code as the equivalent string, so that a
+ * view can be used to probe a hash table of strings.
+ */
+inline uint64_t hashCode64(const StringView& view) {
+    return hashBytes64(view.data(), view.length());
+}
+
+namespace stanfordcpplib {
+namespace collections {
+
+/*
+ * True if a key of type K can be looked up in a collection whose keys are
+ * of type KeyType by viewing it as a StringView, which is the case when
+ * KeyType is string and K is a C string or StringView.  Collections use
+ * this to enable their allocation-free lookup overloads; lookups by a
+ * string still use the ordinary overloads.
+ */
+template <typename KeyType, typename K>
+struct IsStringViewLookup : std::integral_constant<bool,
+        std::is_same<KeyType, std::string>::value
+        && !std::is_same<K, std::string>::value
+        && std::is_convertible<const K&, StringView>::value> {
+};
+
+} // namespace collections
+} // namespace stanfordcpplib
+
+#endif // _stringview_h
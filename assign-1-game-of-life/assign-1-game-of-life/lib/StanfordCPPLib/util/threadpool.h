@@ -0,0 +1,119 @@
+/*
+ * File: threadpool.h
+ * ------------------
+ * This file exports a ThreadPool class that runs loops over a range of
+ * indexes on several threads at once.
+ *
+ * @version 2026/10/17
+ * - made the shared pool safe to fork (see shared)
+ * @version 2026/10/16
+ * - initial version
+ */
+
+#include "private/init.h"   // ensure that Stanford C++ lib is initialized
+
+#ifndef INTERNAL_INCLUDE
+#include "private/initstudent.h"   // insert necessary included code by student
+#endif // INTERNAL_INCLUDE
+
+#ifndef _threadpool_h
+#define _threadpool_h
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A ThreadPool keeps a fixed set of worker threads alive so that parallel
+ * loops do not pay for starting threads each time they run.
+ * Usage example:
+ *
+ *<pre>
+ * ThreadPool::shared().parallelFor(0, grid.numRows(), [&](int first, int last) {
+ *     for (int row = first; row < last; row++) {
+ *         ... work on one row ...
+ *     }
+ * });
+ *</pre>
+ *
+ * The calling thread always takes part in the work, so a pool with no
+ * workers simply runs everything on the caller.  A parallelFor called from
+ * inside the body of another one runs serially on the thread that called it.
+ */
+class ThreadPool {
+public:
+    /**
+     * Constructs a pool with the given number of worker threads.  If the
+     * number is negative, one fewer than the number of hardware threads is
+     * used, so that the workers and the calling thread together occupy the
+     * whole machine.
+     */
+    explicit ThreadPool(int numWorkers = -1);
+
+    /**
+     * Stops and joins the worker threads.
+     */
+    virtual ~ThreadPool();
+
+    /**
+     * Divides the range [first, last) into contiguous chunks of at least
+     * minChunkSize indexes and calls body(chunkFirst, chunkLast) once for
+     * each chunk, on the workers and the calling thread, returning when all
+     * of the chunks are done.  If any call throws an exception, the remaining
+     * chunks are skipped and the first exception is rethrown here.
+     * Ranges that make only one chunk run directly on the calling thread.
+     * Only one parallelFor runs on a pool at a time; others wait their turn.
+     */
+    void parallelFor(int first, int last,
+                     const std::function<void (int first, int last)>& body,
+                     int minChunkSize = 1);
+
+    /**
+     * Returns the number of threads that work on each parallelFor: the
+     * workers plus the calling thread.
+     */
+    int size() const;
+
+    /**
+     * Returns true if the calling thread is running part of a parallelFor,
+     * either as one of a pool's workers or as the thread that called it.
+     */
+    static bool isInsideParallelFor();
+
+    /**
+     * Returns a pool shared by the whole program, created on first use with
+     * the default number of workers.
+     *
+     * On systems with fork, forking waits for any parallelFor running on
+     * the shared pool to finish, and the child gets a pool with no workers,
+     * so that parallelFor runs serially there.  Forking from inside the
+     * body of a parallelFor is not supported.
+     */
+    static ThreadPool& shared();
+
+private:
+    struct Job;
+
+    std::vector<std::thread> workers;
+    std::mutex callLock;           // held for the duration of each parallelFor
+    std::mutex lock;               // guards everything below
+    std::condition_variable jobPosted;
+    std::condition_variable jobFinished;
+    Job* currentJob;
+    unsigned long jobNumber;
+    bool stopping;
+
+    void workerLoop();
+    static void runChunks(Job& job);
+    static void prepareFork();
+    static void parentAfterFork();
+    static void childAfterFork();
+
+    // forbid copying
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator =(const ThreadPool&);
+};
+
+#endif // _threadpool_h
@@ -0,0 +1,129 @@
+/**
+ * File: life-boundary.cpp
+ * -----------------------
+ * Implements the HaloBoard class.  All of the knowledge about what lies
+ * beyond the edges of the board lives in the fillEdge* methods below;
+ * the neighbour count itself never needs to know which mode is in use.
+ */
+
+#include <cstring>   // for memcpy, memset
+using namespace std;
+
+#include "life-boundary.h"
+
+string boundaryModeName(BoundaryMode mode) {
+    switch (mode) {
+    case TOROIDAL:   return "wrap-around";
+    case REFLECTIVE: return "mirror";
+    default:         return "dead edges";
+    }
+}
+
+HaloBoard::HaloBoard(BoundaryMode mode)
+        : mode(mode),
+          numRows(0),
+          numCols(0) {
+    cells.setBorder(1, /* alignRows */ true);
+}
+
+void HaloBoard::load(const Grid<int>& board) {
+    copyInterior(board);
+    if (numRows > 0 && numCols > 0) {
+        fillEdgeColumns(0, numRows);
+        fillEdgeRows();
+    }
+}
+
+void HaloBoard::loadBand(const Grid<int>& band,
+                         const unsigned char* above, const unsigned char* below) {
+    copyInterior(band);
+    if (numRows > 0 && numCols > 0) {
+        memcpy(rowAt(-1), above, numCols);
+        memcpy(rowAt(numRows), below, numCols);
+        fillEdgeColumns(-1, numRows + 1);
+    }
+}
+
+void HaloBoard::loadStates(const unsigned char* states, int numRows, int numCols,
+                           unsigned char occupiedState) {
+    setDimensions(numRows, numCols);
+    if (numRows > 0 && numCols > 0) {
+        for (int row = 0; row < numRows; row++) {
+            const unsigned char* src = states + row * numCols;
+            unsigned char* dst = rowAt(row);
+            for (int col = 0; col < numCols; col++) {
+                dst[col] = src[col] == occupiedState;
+            }
+        }
+        fillEdgeColumns(0, numRows);
+        fillEdgeRows();
+    }
+}
+
+void HaloBoard::setDimensions(int numRows, int numCols) {
+    if (numRows != this->numRows || numCols != this->numCols) {
+        this->numRows = numRows;
+        this->numCols = numCols;
+        cells.resize(numRows, numCols);
+    }
+}
+
+void HaloBoard::copyInterior(const Grid<int>& board) {
+    setDimensions(board.numRows(), board.numCols());
+    for (int row = 0; row < numRows; row++) {
+        Grid<int>::ConstRowSpan src = board.rowSpan(row);
+        unsigned char* dst = rowAt(row);
+        for (int col = 0; col < numCols; col++) {
+            dst[col] = src[col] != 0;
+        }
+    }
+}
+
+/*
+ * Implementation notes: fillEdgeColumns, fillEdgeRows
+ * ---------------------------------------------------
+ * The left and right ghost cells of the given rows are filled first, and
+ * then whole rows (ghost cells included) are copied into the top and
+ * bottom ghost rows.  Doing the columns first makes the four ghost corners
+ * come out right without any special cases.  The mode is consulted once
+ * per call, never per cell.
+ */
+void HaloBoard::fillEdgeColumns(int firstRow, int lastRow) {
+    for (int row = firstRow; row < lastRow; row++) {
+        unsigned char* cur = rowAt(row);
+        switch (mode) {
+        case TOROIDAL:
+            cur[-1] = cur[numCols - 1];
+            cur[numCols] = cur[0];
+            break;
+        case REFLECTIVE:
+            cur[-1] = cur[0];
+            cur[numCols] = cur[numCols - 1];
+            break;
+        default:
+            cur[-1] = 0;
+            cur[numCols] = 0;
+            break;
+        }
+    }
+}
+
+void HaloBoard::fillEdgeRows() {
+    unsigned char* top = rowAt(-1) - 1;
+    unsigned char* bottom = rowAt(numRows) - 1;
+    int width = numCols + 2;
+    switch (mode) {
+    case TOROIDAL:
+        memcpy(top, rowAt(numRows - 1) - 1, width);
+        memcpy(bottom, rowAt(0) - 1, width);
+        break;
+    case REFLECTIVE:
+        memcpy(top, rowAt(0) - 1, width);
+        memcpy(bottom, rowAt(numRows - 1) - 1, width);
+        break;
+    default:
+        memset(top, 0, width);
+        memset(bottom, 0, width);
+        break;
+    }
+}
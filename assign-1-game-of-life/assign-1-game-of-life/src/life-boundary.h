@@ -0,0 +1,116 @@
+/**
+ * File: life-boundary.h
+ * ---------------------
+ * Defines the boundary modes supported by the simulation and the
+ * HaloBoard class used to count neighbours without any bounds tests.
+ */
+
+#pragma once
+#include <string>    // for std::string
+#include "grid.h"    // for Grid
+
+/**
+ * Type: BoundaryMode
+ * ------------------
+ * Determines what lies beyond the edges of the board.
+ *
+ *   DEAD_EDGES: everything outside the board is permanently empty
+ *   TOROIDAL:   the board wraps around, so the top edge touches the bottom
+ *               edge and the left edge touches the right edge
+ *   REFLECTIVE: the board is mirrored across each edge, so the cell just
+ *               outside an edge looks like the cell just inside it
+ */
+enum BoundaryMode {
+    DEAD_EDGES,
+    TOROIDAL,
+    REFLECTIVE
+};
+
+/**
+ * Returns a short human-readable name for the given mode, e.g. "wrap-around".
+ */
+std::string boundaryModeName(BoundaryMode mode);
+
+/**
+ * Class: HaloBoard
+ * ----------------
+ * Holds a copy of the occupancy of the current generation surrounded by a
+ * one-cell ghost border (the "halo").  The halo is filled in by edge code
+ * specific to the chosen boundary mode, after which every board cell --
+ * including those along the edges -- has eight real neighbours in memory,
+ * and the neighbour count is plain arithmetic with no branches.
+ *
+ * The cells are kept in a Grid with a one-cell border and cache-line
+ * aligned rows, which is reused from one generation to the next, so only
+ * the first load after a change of dimensions allocates.
+ */
+class HaloBoard {
+public:
+/**
+ * Constructs an empty halo board using the given boundary mode.
+ */
+    explicit HaloBoard(BoundaryMode mode = DEAD_EDGES);
+
+/**
+ * Returns or changes the boundary mode used by subsequent loads.
+ */
+    BoundaryMode getMode() const { return mode; }
+    void setMode(BoundaryMode mode) { this->mode = mode; }
+
+/**
+ * Copies the occupancy of the given board into the interior of the halo
+ * board and then fills the ghost border according to the boundary mode.
+ */
+    void load(const Grid<int>& board);
+
+/**
+ * Like load, but for one horizontal band of a larger board.  The occupancy
+ * of the rows just above and just below the band (numCols flags each) is
+ * supplied by the caller, and only the left and right edges are handled
+ * according to the boundary mode.
+ */
+    void loadBand(const Grid<int>& band,
+                  const unsigned char* above, const unsigned char* below);
+
+/**
+ * Like load, but takes a plain row-major plane of cell states, counting a
+ * cell as occupied when its state equals occupiedState.
+ */
+    void loadStates(const unsigned char* states, int numRows, int numCols,
+                    unsigned char occupiedState);
+
+/**
+ * Returns a pointer to column 0 of the given row of the halo board, for
+ * kernels that walk whole rows.  Rows -1 and numRows are the ghost rows,
+ * and each row's ghost cells are at indexes -1 and numCols.
+ */
+    const unsigned char* haloRow(int row) const { return cells.rowSpan(row).data(); }
+
+/**
+ * Returns the number of occupied cells among the eight neighbours of the
+ * given board location.  No bounds checking is performed; row and col
+ * must lie within the board that was most recently loaded.
+ */
+    int liveNeighbours(int row, int col) const {
+        int pitch = cells.pitch();
+        const unsigned char* mid  = cells.data() + row * pitch + col - 1;
+        const unsigned char* up   = mid - pitch;
+        const unsigned char* down = mid + pitch;
+        return up[0]   + up[1]   + up[2]
+             + mid[0]            + mid[2]
+             + down[0] + down[1] + down[2];
+    }
+
+private:
+    BoundaryMode mode;
+    int numRows;                      // dimensions of the board, not the halo
+    int numCols;
+    Grid<unsigned char> cells;        // 1 = occupied, with a one-cell border
+
+    unsigned char* rowAt(int row) { return cells.rowSpan(row).data(); }
+
+    void setDimensions(int numRows, int numCols);
+    void copyInterior(const Grid<int>& board);
+    void fillEdgeColumns(int firstRow, int lastRow);
+    void fillEdgeRows();
+};
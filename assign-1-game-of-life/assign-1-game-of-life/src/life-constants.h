@@ -1,8 +1,7 @@
 /**
  * File: life-constants.h
  * ----------------------
- * Defines those constants which are shared by both the
- * life-graphics module and the main life module.
+ * Defines those constants which are shared by the life modules.
  */
 
 #pragma once
@@ -16,3 +15,9 @@
  */
 const int kMaxAge = 12;
 
+/**
+ * Whole-board loops hand rows to the shared thread pool in bands of at
+ * least kMinRowsPerTask rows, so small boards stay on the calling thread.
+ */
+const int kMinRowsPerTask = 64;
+
@@ -0,0 +1,403 @@
+/**
+ * File: life-export.cpp
+ * ---------------------
+ * Implements the FrameExporter class.  The simulation thread only copies
+ * boards into recycled frame buffers; all encoding and file output is done
+ * by a single writer thread that drains a small bounded queue.
+ */
+
+#include <algorithm> // for min
+#include <cstdio>    // for snprintf
+using namespace std;
+#include "error.h"   // for error
+
+#include "life-constants.h"  // for kMaxAge
+#include "life-export.h"
+
+/*
+ * Shade used for a cell of the given age in grayscale output: dead cells
+ * are white, newborn cells are darkest and they fade as they age, the same
+ * way LifeDisplay shades them.
+ */
+static unsigned char grayForAge(int age) {
+    return age == 0 ? 255 : static_cast<unsigned char>(220 * age / kMaxAge);
+}
+
+/*
+ * GIF frames use a 16-color global palette; index i is the color of a cell
+ * of age i, and the entries past kMaxAge are never used.
+ */
+static const int kGifPaletteBits = 4;
+static const int kGifPaletteSize = 1 << kGifPaletteBits;
+static const int kGifMaxCode = 4095;
+
+/*
+ * Class: GifCodeWriter
+ * --------------------
+ * Packs variable-width LZW codes least-significant-bit first and writes
+ * them out as GIF data sub-blocks of at most 255 bytes each.
+ */
+class GifCodeWriter {
+public:
+    explicit GifCodeWriter(ostream& out) : out(out), bits(0), numBits(0), blockSize(0) {}
+
+    void write(int code, int width) {
+        bits |= static_cast<unsigned long>(code) << numBits;
+        numBits += width;
+        while (numBits >= 8) {
+            putByte(static_cast<unsigned char>(bits & 0xff));
+            bits >>= 8;
+            numBits -= 8;
+        }
+    }
+
+    void finish() {
+        if (numBits > 0) {
+            putByte(static_cast<unsigned char>(bits & 0xff));
+        }
+        flushBlock();
+        out.put(0);  // block terminator
+    }
+
+private:
+    ostream& out;
+    unsigned long bits;
+    int numBits;
+    int blockSize;
+    unsigned char block[255];
+
+    void putByte(unsigned char byte) {
+        block[blockSize++] = byte;
+        if (blockSize == 255) {
+            flushBlock();
+        }
+    }
+
+    void flushBlock() {
+        if (blockSize > 0) {
+            out.put(static_cast<char>(blockSize));
+            out.write(reinterpret_cast<const char*>(block), blockSize);
+            blockSize = 0;
+        }
+    }
+};
+
+static void writeLittleEndian16(ostream& out, int value) {
+    out.put(static_cast<char>(value & 0xff));
+    out.put(static_cast<char>((value >> 8) & 0xff));
+}
+
+FrameExporter::FrameExporter()
+        : format(EXPORT_PBM),
+          numRows(0),
+          numCols(0),
+          every(1),
+          cellSize(1),
+          delayCs(10),
+          recording(false),
+          boardsSeen(0),
+          framesQueued(0),
+          closing(false) {
+    // empty
+}
+
+FrameExporter::~FrameExporter() {
+    finish();
+}
+
+void FrameExporter::start(const string& prefix, ExportFormat format,
+                          int numRows, int numCols,
+                          int every, int cellSize, int delayMs) {
+    if (numRows <= 0 || numCols <= 0 || every <= 0 || cellSize <= 0 || delayMs <= 0) {
+        error("FrameExporter::start: dimensions, frame interval, cell size and delay must all be positive");
+    }
+    finish();
+
+    this->prefix = prefix;
+    this->format = format;
+    this->numRows = numRows;
+    this->numCols = numCols;
+    this->every = every;
+    this->cellSize = cellSize;
+    this->delayCs = max(1, delayMs / 10);
+    boardsSeen = 0;
+    framesQueued = 0;
+    closing = false;
+    errorMessage.clear();
+    spares.clear();
+    recording = true;
+    writer = thread(&FrameExporter::writerLoop, this);
+}
+
+void FrameExporter::submit(const Grid<int>& board) {
+    if (!recording) {
+        return;
+    }
+    if (board.numRows() != numRows || board.numCols() != numCols) {
+        error("FrameExporter::submit: board dimensions changed during a recording");
+    }
+    if (boardsSeen++ % every != 0) {
+        return;
+    }
+
+    Frame frame;
+    {
+        unique_lock<mutex> guard(lock);
+        slotFree.wait(guard, [this] { return static_cast<int>(queue.size()) < kQueueCapacity; });
+        if (!spares.empty()) {
+            frame = std::move(spares.back());
+            spares.pop_back();
+        }
+    }
+
+    frame.index = ++framesQueued;
+    frame.ages.resize(numRows * numCols);
+    // rows may be padded (see Grid::pitch), so copy them one at a time
+    unsigned char* dst = frame.ages.data();
+    for (int row = 0; row < numRows; row++) {
+        for (int cell : board.rowSpan(row)) {
+            *dst++ = static_cast<unsigned char>(min(cell, kMaxAge));
+        }
+    }
+
+    {
+        lock_guard<mutex> guard(lock);
+        queue.push_back(std::move(frame));
+    }
+    frameReady.notify_one();
+}
+
+bool FrameExporter::finish() {
+    if (!recording) {
+        return true;
+    }
+    {
+        lock_guard<mutex> guard(lock);
+        closing = true;
+    }
+    frameReady.notify_one();
+    writer.join();
+    recording = false;
+    return getErrorMessage().empty();
+}
+
+string FrameExporter::getErrorMessage() const {
+    lock_guard<mutex> guard(lock);
+    return errorMessage;
+}
+
+void FrameExporter::fail(const string& message) {
+    lock_guard<mutex> guard(lock);
+    if (errorMessage.empty()) {
+        errorMessage = message;
+    }
+}
+
+/*
+ * Implementation notes: writerLoop
+ * --------------------------------
+ * Frames are written outside the lock, so the simulation thread can keep
+ * queueing while the writer is busy with the disk.  Once a write has
+ * failed, the remaining frames are still drained (so submit never blocks
+ * forever) but are discarded.
+ */
+void FrameExporter::writerLoop() {
+    if (format == EXPORT_GIF) {
+        beginGif();
+    }
+    while (true) {
+        Frame frame;
+        {
+            unique_lock<mutex> guard(lock);
+            frameReady.wait(guard, [this] { return closing || !queue.empty(); });
+            if (queue.empty()) {
+                break;
+            }
+            frame = std::move(queue.front());
+            queue.pop_front();
+        }
+        slotFree.notify_one();
+
+        if (getErrorMessage().empty()) {
+            writeFrame(frame);
+        }
+
+        lock_guard<mutex> guard(lock);
+        spares.push_back(std::move(frame));
+    }
+    if (format == EXPORT_GIF) {
+        endGif();
+    }
+}
+
+void FrameExporter::writeFrame(const Frame& frame) {
+    expandPixels(frame);
+    if (format == EXPORT_GIF) {
+        writeGifFrame();
+    } else {
+        writePnm(frame);
+    }
+}
+
+/*
+ * Scales the frame up so that each cell covers cellSize x cellSize pixels.
+ * The result holds one age (palette index) per pixel.
+ */
+void FrameExporter::expandPixels(const Frame& frame) {
+    int width = numCols * cellSize;
+    pixels.resize(width * numRows * cellSize);
+    unsigned char* dst = pixels.data();
+    for (int row = 0; row < numRows; row++) {
+        const unsigned char* src = &frame.ages[row * numCols];
+        unsigned char* first = dst;
+        for (int col = 0; col < numCols; col++) {
+            for (int i = 0; i < cellSize; i++) {
+                *dst++ = src[col];
+            }
+        }
+        for (int i = 1; i < cellSize; i++) {
+            dst = copy(first, first + width, dst);
+        }
+    }
+}
+
+void FrameExporter::writePnm(const Frame& frame) {
+    int width = numCols * cellSize;
+    int height = numRows * cellSize;
+    char name[32];
+    snprintf(name, sizeof(name), "-%06d.%s", frame.index, format == EXPORT_PBM ? "pbm" : "pgm");
+
+    ofstream out(prefix + name, ios::binary);
+    if (!out) {
+        fail("Unable to open \"" + prefix + name + "\" for writing.");
+        return;
+    }
+
+    if (format == EXPORT_PBM) {
+        // rows are packed 8 pixels per byte, most significant bit first, 1 = black
+        int rowBytes = (width + 7) / 8;
+        packed.assign(rowBytes * height, 0);
+        for (int y = 0; y < height; y++) {
+            const unsigned char* src = &pixels[y * width];
+            unsigned char* dst = &packed[y * rowBytes];
+            for (int x = 0; x < width; x++) {
+                dst[x >> 3] |= (src[x] != 0) << (7 - (x & 7));
+            }
+        }
+        out << "P4\n" << width << " " << height << "\n";
+    } else {
+        packed.resize(pixels.size());
+        for (size_t i = 0; i < pixels.size(); i++) {
+            packed[i] = grayForAge(pixels[i]);
+        }
+        out << "P5\n" << width << " " << height << "\n255\n";
+    }
+    out.write(reinterpret_cast<const char*>(packed.data()), packed.size());
+    if (!out) {
+        fail("Unable to write \"" + prefix + name + "\".");
+    }
+}
+
+void FrameExporter::beginGif() {
+    gif.open(prefix + ".gif", ios::binary);
+    if (!gif) {
+        fail("Unable to open \"" + prefix + ".gif\" for writing.");
+        return;
+    }
+
+    // header and logical screen descriptor with a 16-entry global color table
+    gif.write("GIF89a", 6);
+    writeLittleEndian16(gif, numCols * cellSize);
+    writeLittleEndian16(gif, numRows * cellSize);
+    gif.put(static_cast<char>(0xf0 | (kGifPaletteBits - 1)));
+    gif.put(0);  // background color index
+    gif.put(0);  // no pixel aspect ratio
+    for (int age = 0; age < kGifPaletteSize; age++) {
+        unsigned char gray = grayForAge(min(age, kMaxAge));
+        gif.put(static_cast<char>(gray));
+        gif.put(static_cast<char>(gray));
+        gif.put(static_cast<char>(gray));
+    }
+
+    // application extension asking viewers to loop forever
+    gif.write("\x21\xff\x0bNETSCAPE2.0\x03\x01\x00\x00\x00", 19);
+}
+
+/*
+ * Implementation notes: writeGifFrame
+ * -----------------------------------
+ * Standard GIF variable-width LZW.  The string table is kept as a trie with
+ * one child slot per palette index, so extending the current string is a
+ * single array lookup.  Codes widen as the table grows, and a clear code
+ * restarts the table once the 12-bit code space is exhausted.
+ */
+void FrameExporter::writeGifFrame() {
+    if (!gif) {
+        return;
+    }
+    int width = numCols * cellSize;
+    int height = numRows * cellSize;
+
+    // graphic control extension (frame delay) and image descriptor
+    gif.write("\x21\xf9\x04\x00", 4);
+    writeLittleEndian16(gif, delayCs);
+    gif.put(0);  // transparent color index (unused)
+    gif.put(0);
+    gif.put(0x2c);
+    writeLittleEndian16(gif, 0);
+    writeLittleEndian16(gif, 0);
+    writeLittleEndian16(gif, width);
+    writeLittleEndian16(gif, height);
+    gif.put(0);  // no local color table, not interlaced
+
+    const int minCodeSize = kGifPaletteBits;
+    const int clearCode = 1 << minCodeSize;
+    gif.put(static_cast<char>(minCodeSize));
+    GifCodeWriter codes(gif);
+
+    vector<short>& children = gifTrie;
+    children.assign((kGifMaxCode + 1) * kGifPaletteSize, -1);
+    int codeSize = minCodeSize + 1;
+    int maxCode = clearCode + 1;
+    codes.write(clearCode, codeSize);
+
+    int current = pixels[0];
+    for (size_t i = 1; i < pixels.size(); i++) {
+        int next = pixels[i];
+        short& child = children[current * kGifPaletteSize + next];
+        if (child >= 0) {
+            current = child;
+            continue;
+        }
+        codes.write(current, codeSize);
+        child = static_cast<short>(++maxCode);
+        if (maxCode >= (1 << codeSize)) {
+            codeSize++;
+        }
+        if (maxCode == kGifMaxCode) {
+            codes.write(clearCode, codeSize);
+            fill(children.begin(), children.end(), -1);
+            codeSize = minCodeSize + 1;
+            maxCode = clearCode + 1;
+        }
+        current = next;
+    }
+    codes.write(current, codeSize);
+    codes.write(clearCode, codeSize);
+    codes.write(clearCode + 1, minCodeSize + 1);
+    codes.finish();
+
+    if (!gif) {
+        fail("Unable to write \"" + prefix + ".gif\".");
+    }
+}
+
+void FrameExporter::endGif() {
+    if (gif.is_open()) {
+        gif.put(0x3b);  // trailer
+        gif.close();
+        if (!gif) {
+            fail("Unable to write \"" + prefix + ".gif\".");
+        }
+    }
+}
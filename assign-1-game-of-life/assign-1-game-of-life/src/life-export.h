@@ -0,0 +1,137 @@
+/**
+ * File: life-export.h
+ * -------------------
+ * Defines the FrameExporter class, which records generations of a
+ * simulation to disk so that long runs can be reviewed offline.
+ */
+
+#pragma once
+#include <condition_variable> // for std::condition_variable
+#include <deque>              // for std::deque
+#include <fstream>            // for std::ofstream
+#include <mutex>              // for std::mutex
+#include <string>             // for std::string
+#include <thread>             // for std::thread
+#include <vector>             // for std::vector
+#include "grid.h"             // for Grid
+
+/**
+ * Type: ExportFormat
+ * ------------------
+ *   EXPORT_PBM: one binary bitmap (P4) per frame; occupied cells are black
+ *   EXPORT_PGM: one binary graymap (P5) per frame; cells are shaded by age
+ *               the same way the display shades them, dead cells are white
+ *   EXPORT_GIF: a single looping animated GIF, shaded by age
+ */
+enum ExportFormat {
+    EXPORT_PBM,
+    EXPORT_PGM,
+    EXPORT_GIF
+};
+
+class FrameExporter {
+public:
+/**
+ * Constructs an exporter that is not yet recording.
+ */
+    FrameExporter();
+
+/**
+ * Stops recording (see finish) and destroys the exporter.
+ */
+    ~FrameExporter();
+
+/**
+ * Starts recording boards of the given dimensions.  Every 'every'-th board
+ * passed to submit is written, starting with the first one.  Each cell
+ * becomes a cellSize x cellSize block of pixels.  PBM and PGM frames are
+ * written to files named like "<prefix>-000001.pbm"; a GIF is written to
+ * "<prefix>.gif", with delayMs between frames.
+ *
+ * Any recording already in progress is finished first.  Signals an error
+ * if any of the numeric arguments is not positive.
+ */
+    void start(const std::string& prefix, ExportFormat format,
+               int numRows, int numCols,
+               int every = 1, int cellSize = 1, int delayMs = 100);
+
+/**
+ * Hands the given board to the exporter.  If this is a board that should
+ * be recorded, its ages are copied into a frame buffer and queued for the
+ * writer thread; the disk is never touched on the caller's thread.  When
+ * the queue is full this waits for the writer to catch up, so memory use
+ * stays bounded even if the disk is slower than the simulation.
+ * Does nothing if the exporter is not recording.
+ */
+    void submit(const Grid<int>& board);
+
+/**
+ * Writes out every queued frame, closes the output and stops the writer
+ * thread.  Returns false if anything could not be written, in which case
+ * getErrorMessage describes the first failure.  Does nothing (and returns
+ * true) if the exporter is not recording.
+ */
+    bool finish();
+
+/**
+ * Returns true between calls to start and finish.
+ */
+    bool isRecording() const { return recording; }
+
+/**
+ * Returns the number of frames queued so far in this recording.
+ */
+    int getFrameCount() const { return framesQueued; }
+
+    std::string getErrorMessage() const;
+
+private:
+    struct Frame {
+        int index;
+        std::vector<unsigned char> ages; // numRows x numCols, clamped to kMaxAge
+    };
+
+    static const int kQueueCapacity = 8;
+
+    // settings, fixed between start and finish
+    std::string prefix;
+    ExportFormat format;
+    int numRows;
+    int numCols;
+    int every;
+    int cellSize;
+    int delayCs;  // GIF frame delay in hundredths of a second
+
+    // simulation-thread state
+    bool recording;
+    int boardsSeen;
+    int framesQueued;
+
+    // shared between the simulation thread and the writer thread
+    mutable std::mutex lock;
+    std::condition_variable frameReady;
+    std::condition_variable slotFree;
+    std::deque<Frame> queue;
+    std::vector<Frame> spares;  // recycled buffers, so steady state never allocates
+    bool closing;
+    std::string errorMessage;
+
+    // writer-thread state
+    std::thread writer;
+    std::ofstream gif;
+    std::vector<unsigned char> pixels;
+    std::vector<unsigned char> packed;
+    std::vector<short> gifTrie;
+
+    void writerLoop();
+    void writeFrame(const Frame& frame);
+    void writePnm(const Frame& frame);
+    void beginGif();
+    void writeGifFrame();
+    void endGif();
+    void expandPixels(const Frame& frame);
+    void fail(const std::string& message);
+
+    FrameExporter(const FrameExporter& original);
+    void operator=(const FrameExporter& rhs) const;
+};
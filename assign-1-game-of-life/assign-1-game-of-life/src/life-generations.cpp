@@ -0,0 +1,268 @@
+/**
+ * File: life-generations.cpp
+ * --------------------------
+ * Implements the GenerationsRule and GenerationsBoard classes.
+ */
+
+#include <cctype>    // for isdigit, toupper
+using namespace std;
+#include "strlib.h"  // for stringSplit
+#include "threadpool.h"  // for ThreadPool
+
+#include "life-constants.h"  // for kMaxAge, kMinRowsPerTask
+#include "life-generations.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/*
+ * Parses a list of neighbour counts such as "345" into a bit mask.
+ * Returns false if any character is not a digit from 0 through 8.
+ */
+static bool parseCounts(const string& digits, unsigned short& mask) {
+    mask = 0;
+    for (char ch : digits) {
+        if (ch < '0' || ch > '8') {
+            return false;
+        }
+        mask |= 1 << (ch - '0');
+    }
+    return true;
+}
+
+/*
+ * Parses a state count such as "4", which must be from 2 through 255.
+ */
+static bool parseStates(const string& digits, int& numStates) {
+    if (digits.empty() || digits.size() > 3) {
+        return false;
+    }
+    int value = 0;
+    for (char ch : digits) {
+        if (!isdigit(static_cast<unsigned char>(ch))) {
+            return false;
+        }
+        value = value * 10 + (ch - '0');
+    }
+    if (value < 2 || value > 255) {
+        return false;
+    }
+    numStates = value;
+    return true;
+}
+
+GenerationsRule::GenerationsRule()
+        : birthMask(1 << 3),
+          survivalMask((1 << 2) | (1 << 3)),
+          numStates(2) {
+    // empty
+}
+
+bool GenerationsRule::parse(const string& text) {
+    Vector<string> parts = stringSplit(toUpperCase(trim(text)), "/");
+    if (parts.size() < 2 || parts.size() > 3) {
+        return false;
+    }
+
+    unsigned short births;
+    unsigned short survivals;
+    int states = 2;
+    if (startsWith(parts[0], 'B')) {
+        // B/S/C notation
+        if (!startsWith(parts[1], 'S')
+                || !parseCounts(parts[0].substr(1), births)
+                || !parseCounts(parts[1].substr(1), survivals)) {
+            return false;
+        }
+        if (parts.size() == 3
+                && (!startsWith(parts[2], 'C') || !parseStates(parts[2].substr(1), states))) {
+            return false;
+        }
+    } else {
+        // Golly's S/B/C notation
+        if (!parseCounts(parts[0], survivals) || !parseCounts(parts[1], births)) {
+            return false;
+        }
+        if (parts.size() == 3 && !parseStates(parts[2], states)) {
+            return false;
+        }
+    }
+
+    birthMask = births;
+    survivalMask = survivals;
+    numStates = states;
+    return true;
+}
+
+bool GenerationsRule::isConway() const {
+    return *this == GenerationsRule();
+}
+
+bool GenerationsRule::operator ==(const GenerationsRule& other) const {
+    return birthMask == other.birthMask
+            && survivalMask == other.survivalMask
+            && numStates == other.numStates;
+}
+
+string GenerationsRule::toString() const {
+    string result = "B";
+    for (int n = 0; n <= 8; n++) {
+        if (isBirth(n)) {
+            result += static_cast<char>('0' + n);
+        }
+    }
+    result += "/S";
+    for (int n = 0; n <= 8; n++) {
+        if (isSurvival(n)) {
+            result += static_cast<char>('0' + n);
+        }
+    }
+    if (numStates > 2) {
+        result += "/C" + integerToString(numStates);
+    }
+    return result;
+}
+
+GenerationsBoard::GenerationsBoard()
+        : numRows(0),
+          numCols(0) {
+    // empty
+}
+
+void GenerationsBoard::load(const Grid<int>& board) {
+    numRows = board.numRows();
+    numCols = board.numCols();
+    states.resize(numRows * numCols);
+    nextStates.resize(numRows * numCols);
+    // rows may be padded (see Grid::pitch), so read them one at a time
+    unsigned char* dst = states.data();
+    for (int row = 0; row < numRows; row++) {
+        for (int cell : board.rowSpan(row)) {
+            *dst++ = cell != 0;
+        }
+    }
+}
+
+void GenerationsBoard::step() {
+    if (numRows == 0 || numCols == 0) {
+        return;
+    }
+    halo.loadStates(states.data(), numRows, numCols, 1);
+    ThreadPool::shared().parallelFor(0, numRows, [this](int firstRow, int lastRow) {
+        for (int row = firstRow; row < lastRow; row++) {
+            stepRow(row);
+        }
+    }, kMinRowsPerTask);
+    states.swap(nextStates);
+}
+
+/*
+ * Implementation notes: stepRow
+ * -----------------------------
+ * Neighbour counts are the sum of eight shifted loads from the halo board,
+ * which holds a 1 for every live cell.  Membership of a count in the birth
+ * or survival set is tested by comparing it against each count in the set,
+ * so the cost depends on the rule but never on the cells.  The new state
+ * is then chosen with masks:
+ *
+ *   live next generation  = (empty and count in B) or (alive and count in S)
+ *   otherwise, if nonzero = state + 1, or 0 if that would be numStates
+ *
+ * which covers live cells that start to decay as well as decaying ones.
+ * Any columns left over after the last full block of 16 are done one at a
+ * time with the same logic.
+ */
+void GenerationsBoard::stepRow(int row) {
+    const unsigned char* up = halo.haloRow(row - 1);
+    const unsigned char* mid = halo.haloRow(row);
+    const unsigned char* down = halo.haloRow(row + 1);
+    const unsigned char* cur = &states[row * numCols];
+    unsigned char* out = &nextStates[row * numCols];
+    const int lastState = rule.getNumStates() - 1;
+    int col = 0;
+
+#ifdef __SSE2__
+    __m128i births[9];
+    __m128i survivals[9];
+    int numBirths = 0;
+    int numSurvivals = 0;
+    for (int n = 0; n <= 8; n++) {
+        if (rule.isBirth(n)) {
+            births[numBirths++] = _mm_set1_epi8(static_cast<char>(n));
+        }
+        if (rule.isSurvival(n)) {
+            survivals[numSurvivals++] = _mm_set1_epi8(static_cast<char>(n));
+        }
+    }
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i wrap = _mm_set1_epi8(static_cast<char>(lastState + 1));
+
+#define LOAD(p) _mm_loadu_si128(reinterpret_cast<const __m128i*>(p))
+    for (; col + 16 <= numCols; col += 16) {
+        __m128i count = _mm_add_epi8(
+                _mm_add_epi8(_mm_add_epi8(LOAD(up + col - 1), LOAD(up + col)),
+                             _mm_add_epi8(LOAD(up + col + 1), LOAD(mid + col - 1))),
+                _mm_add_epi8(_mm_add_epi8(LOAD(mid + col + 1), LOAD(down + col - 1)),
+                             _mm_add_epi8(LOAD(down + col), LOAD(down + col + 1))));
+        __m128i inBirths = zero;
+        for (int i = 0; i < numBirths; i++) {
+            inBirths = _mm_or_si128(inBirths, _mm_cmpeq_epi8(count, births[i]));
+        }
+        __m128i inSurvivals = zero;
+        for (int i = 0; i < numSurvivals; i++) {
+            inSurvivals = _mm_or_si128(inSurvivals, _mm_cmpeq_epi8(count, survivals[i]));
+        }
+
+        __m128i state = LOAD(cur + col);
+        __m128i empty = _mm_cmpeq_epi8(state, zero);
+        __m128i alive = _mm_cmpeq_epi8(state, one);
+        __m128i live = _mm_or_si128(_mm_and_si128(empty, inBirths),
+                                    _mm_and_si128(alive, inSurvivals));
+        __m128i aged = _mm_add_epi8(state, one);
+        aged = _mm_andnot_si128(_mm_or_si128(empty, _mm_cmpeq_epi8(aged, wrap)), aged);
+        __m128i result = _mm_or_si128(_mm_and_si128(live, one), _mm_andnot_si128(live, aged));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + col), result);
+    }
+#undef LOAD
+#endif // __SSE2__
+
+    for (; col < numCols; col++) {
+        int count = up[col - 1] + up[col] + up[col + 1]
+                  + mid[col - 1] + mid[col + 1]
+                  + down[col - 1] + down[col] + down[col + 1];
+        int state = cur[col];
+        bool live = (state == 0 && rule.isBirth(count)) || (state == 1 && rule.isSurvival(count));
+        if (live) {
+            out[col] = 1;
+        } else if (state == 0 || state == lastState) {
+            out[col] = 0;
+        } else {
+            out[col] = static_cast<unsigned char>(state + 1);
+        }
+    }
+}
+
+int GenerationsBoard::store(Grid<int>& board) const {
+    // every cell is overwritten below
+    board.resize(numRows, numCols, /* retain */ true);
+    int lastState = rule.getNumStates() - 1;
+    int numLive = 0;
+    const unsigned char* src = states.data();
+    for (int row = 0; row < numRows; row++) {
+        int* dst = board.data() + row * board.pitch();
+        for (int col = 0; col < numCols; col++) {
+            int state = *src++;
+            int age = 0;
+            if (state == 1) {
+                age = 1;
+                numLive++;
+            } else if (state > 1) {
+                age = 1 + (state - 1) * (kMaxAge - 1) / lastState;
+            }
+            dst[col] = age;
+        }
+    }
+    return numLive;
+}
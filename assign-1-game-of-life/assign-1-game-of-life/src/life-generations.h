@@ -0,0 +1,114 @@
+/**
+ * File: life-generations.h
+ * ------------------------
+ * Defines support for rules of the "Generations" family, such as Brian's
+ * Brain and Star Wars, in which a cell that dies does not disappear at
+ * once but passes through a number of decaying states first.
+ */
+
+#pragma once
+#include <string>           // for std::string
+#include <vector>           // for std::vector
+#include "grid.h"           // for Grid
+#include "life-boundary.h"  // for BoundaryMode, class HaloBoard
+
+/**
+ * Class: GenerationsRule
+ * ----------------------
+ * A rule with C states: 0 is empty, 1 is alive, and 2 through C - 1 are
+ * the decaying states.  Only live cells count as neighbours.  An empty
+ * cell with a neighbour count in the birth set becomes alive; a live cell
+ * with a count in the survival set stays alive and otherwise starts to
+ * decay; a decaying cell moves on to the next state, and the last one
+ * empties.  With C = 2 this is an ordinary B/S rule.
+ */
+class GenerationsRule {
+public:
+/**
+ * Constructs Conway's rule, B3/S23.
+ */
+    GenerationsRule();
+
+/**
+ * Parses a rule in B/S/C notation, such as "B2/S/C3" (Brian's Brain) or
+ * "B2/S345/C4" (Star Wars); the C part may be left off for two-state
+ * rules.  Also accepts Golly's S/B/C notation, such as "345/2/4".
+ * Returns false, leaving the rule unchanged, if the text is not a valid
+ * rule with 2 to 255 states.
+ */
+    bool parse(const std::string& text);
+
+    bool isBirth(int neighbours) const { return (birthMask >> neighbours) & 1; }
+    bool isSurvival(int neighbours) const { return (survivalMask >> neighbours) & 1; }
+    int getNumStates() const { return numStates; }
+
+/**
+ * Returns true for B3/S23 (the rule the age-tracking engine implements).
+ */
+    bool isConway() const;
+
+    bool operator ==(const GenerationsRule& other) const;
+
+/**
+ * Returns the rule in B/S/C notation.
+ */
+    std::string toString() const;
+
+private:
+    unsigned short birthMask;     // bit n set if n neighbours cause a birth
+    unsigned short survivalMask;  // bit n set if n neighbours let a live cell survive
+    int numStates;
+};
+
+/**
+ * Class: GenerationsBoard
+ * -----------------------
+ * Steps a board under a Generations rule.  Cell states are kept between
+ * generations in a plane of bytes, one per cell, and each generation is
+ * computed 16 cells at a time with SIMD compares where available.
+ */
+class GenerationsBoard {
+public:
+    GenerationsBoard();
+
+/**
+ * Sets the rule and boundary mode used by subsequent steps.
+ */
+    void setRule(const GenerationsRule& rule) { this->rule = rule; }
+    void setMode(BoundaryMode mode) { halo.setMode(mode); }
+    const GenerationsRule& getRule() const { return rule; }
+
+/**
+ * Takes the starting colony from the given board: every nonzero location
+ * becomes a live cell.
+ */
+    void load(const Grid<int>& board);
+
+/**
+ * Advances the board by one generation.
+ */
+    void step();
+
+/**
+ * Writes the board into the given grid as display ages: live cells are
+ * age 1 and the decaying states are spread over the ages up to kMaxAge,
+ * so they fade the same way aging cells do.  Returns the number of live
+ * cells.
+ */
+    int store(Grid<int>& board) const;
+
+/**
+ * Returns the state of the given cell (0 through numStates - 1).
+ */
+    int getState(int row, int col) const { return states[row * numCols + col]; }
+
+private:
+    GenerationsRule rule;
+    HaloBoard halo;                     // occupancy of live cells, for neighbour counts
+    int numRows;
+    int numCols;
+    std::vector<unsigned char> states;  // numRows x numCols, row-major
+    std::vector<unsigned char> nextStates;
+
+    void stepRow(int row);
+};
@@ -0,0 +1,23 @@
+/**
+ * File: life-rules.h
+ * ------------------
+ * Defines the rule that turns one generation into the next, shared by
+ * every module that steps a board.
+ */
+
+#pragma once
+
+/**
+ * Function: nextAge
+ * -----------------
+ * Returns the age of a location in the next generation, given its age now
+ * (0 if empty) and its number of occupied neighbours.  A location is
+ * occupied next generation if it has three neighbours, or if it has two
+ * and is occupied now; occupied locations age by one and newborn cells
+ * start at age 1.  Written as arithmetic so that callers' loops stay
+ * free of data-dependent branches.
+ */
+inline int nextAge(int age, int neighbours) {
+    int occupied = (neighbours == 3) | ((neighbours == 2) & (age != 0));
+    return occupied * (age + 1);
+}
@@ -0,0 +1,329 @@
+/**
+ * File: life-shard.cpp
+ * --------------------
+ * Implements sharded simulation with forked worker processes.
+ *
+ * The shared memory segment holds, in order:
+ *   - a header with the run's parameters and the process-shared barrier
+ *   - the full board, used only to hand bands out and collect them back
+ *   - one population count per worker per generation
+ *   - the edge rows: for each of two generation parities, for each worker,
+ *     the occupancy of the top and bottom rows of its band
+ * Edge rows are double-buffered by generation parity so that a single
+ * barrier per generation suffices: a worker cannot start overwriting the
+ * buffers it published two generations ago until every other worker has
+ * reached the following barrier, i.e. has finished reading them.
+ */
+
+#include <cstring>   // for memcpy, strerror
+using namespace std;
+
+#include "life-rules.h"  // for nextAge
+#include "life-shard.h"
+#include "threadpool.h"  // for ThreadPool
+
+#ifdef __linux__
+#include <cerrno>        // for errno
+#include <fcntl.h>       // for O_* constants
+#include <pthread.h>     // for pthread_barrier_t
+#include <signal.h>      // for kill
+#include <sys/mman.h>    // for shm_open, mmap
+#include <sys/wait.h>    // for waitpid
+#include <unistd.h>      // for fork, ftruncate, getpid
+
+namespace {
+
+struct ShardHeader {
+    pthread_barrier_t barrier;
+    int numRows;
+    int numCols;
+    int numWorkers;
+    int numGenerations;
+};
+
+size_t alignToCacheLine(size_t n) {
+    return (n + 63) & ~static_cast<size_t>(63);
+}
+
+/*
+ * Class: ShardSegment
+ * -------------------
+ * Computes where everything lives in the shared segment.
+ */
+class ShardSegment {
+public:
+    ShardSegment(int numRows, int numCols, int numWorkers, int numGenerations)
+            : base(nullptr) {
+        boardOffset = alignToCacheLine(sizeof(ShardHeader));
+        populationsOffset = boardOffset
+                + alignToCacheLine(sizeof(int) * numRows * numCols);
+        edgesOffset = populationsOffset
+                + alignToCacheLine(sizeof(long long) * numGenerations * numWorkers);
+        totalSize = edgesOffset + alignToCacheLine(2 * numWorkers * 2 * numCols);
+    }
+
+    ShardHeader* header() const { return reinterpret_cast<ShardHeader*>(base); }
+    int* board() const { return reinterpret_cast<int*>(base + boardOffset); }
+    long long* populations() const { return reinterpret_cast<long long*>(base + populationsOffset); }
+
+    /* which = 0 for the top row of the worker's band, 1 for the bottom row */
+    unsigned char* edgeRow(int parity, int worker, int which) const {
+        const ShardHeader* h = header();
+        return reinterpret_cast<unsigned char*>(base + edgesOffset)
+                + ((parity * h->numWorkers + worker) * 2 + which) * h->numCols;
+    }
+
+    /* first board row owned by the given worker (worker == numWorkers gives numRows) */
+    int bandStart(int worker) const {
+        const ShardHeader* h = header();
+        return static_cast<int>(static_cast<long long>(h->numRows) * worker / h->numWorkers);
+    }
+
+    char* base;
+    size_t totalSize;
+
+private:
+    size_t boardOffset;
+    size_t populationsOffset;
+    size_t edgesOffset;
+};
+
+/*
+ * Publishes the occupancy of one board row into an edge row.
+ */
+void publishRow(const Grid<int>& band, int row, unsigned char* dst) {
+    Grid<int>::ConstRowSpan src = band.rowSpan(row);
+    for (int col = 0; col < src.size(); col++) {
+        dst[col] = src[col] != 0;
+    }
+}
+
+/*
+ * The body of one worker process.
+ */
+void runWorker(const ShardSegment& segment, BoundaryMode mode, int worker) {
+    ShardHeader* header = segment.header();
+    int numCols = header->numCols;
+    int lastWorker = header->numWorkers - 1;
+    int firstRow = segment.bandStart(worker);
+    int numRows = segment.bandStart(worker + 1) - firstRow;
+
+    // take this worker's band from the shared board
+    Grid<int> bands[2];
+    bands[0].resize(numRows, numCols);
+    bands[1].resize(numRows, numCols);
+    memcpy(bands[0].data(), segment.board() + firstRow * numCols, sizeof(int) * numRows * numCols);
+
+    HaloBoard halo(mode);
+    vector<unsigned char> deadRow(numCols, 0);
+    for (int gen = 0; gen < header->numGenerations; gen++) {
+        int parity = gen & 1;
+        Grid<int>& current = bands[parity];
+        Grid<int>& next = bands[1 - parity];
+
+        publishRow(current, 0, segment.edgeRow(parity, worker, 0));
+        publishRow(current, numRows - 1, segment.edgeRow(parity, worker, 1));
+        pthread_barrier_wait(&header->barrier);
+
+        // ghost rows: a neighbouring band's edge, or the board's edge
+        const unsigned char* above;
+        const unsigned char* below;
+        if (worker > 0) {
+            above = segment.edgeRow(parity, worker - 1, 1);
+        } else if (mode == TOROIDAL) {
+            above = segment.edgeRow(parity, lastWorker, 1);
+        } else if (mode == REFLECTIVE) {
+            above = segment.edgeRow(parity, worker, 0);
+        } else {
+            above = deadRow.data();
+        }
+        if (worker < lastWorker) {
+            below = segment.edgeRow(parity, worker + 1, 0);
+        } else if (mode == TOROIDAL) {
+            below = segment.edgeRow(parity, 0, 0);
+        } else if (mode == REFLECTIVE) {
+            below = segment.edgeRow(parity, worker, 1);
+        } else {
+            below = deadRow.data();
+        }
+        halo.loadBand(current, above, below);
+
+        long long population = 0;
+        const int* cur = current.data();
+        int* out = next.data();
+        for (int row = 0; row < numRows; row++) {
+            for (int col = 0; col < numCols; col++) {
+                int age = nextAge(cur[row * numCols + col], halo.liveNeighbours(row, col));
+                out[row * numCols + col] = age;
+                population += age != 0;
+            }
+        }
+        segment.populations()[gen * header->numWorkers + worker] = population;
+    }
+
+    // hand the final band back
+    const Grid<int>& result = bands[header->numGenerations & 1];
+    memcpy(segment.board() + firstRow * numCols, result.data(), sizeof(int) * numRows * numCols);
+}
+
+string systemError(const string& what) {
+    return what + " failed: " + strerror(errno);
+}
+
+} // namespace
+
+/*
+ * Implementation notes: runSharded
+ * --------------------------------
+ * The segment's name is unlinked as soon as it has been mapped; the
+ * workers inherit the mapping across fork, and nothing is left behind in
+ * /dev/shm even if the program is killed mid-run.
+ *
+ * The workers are put in a process group of their own so that the
+ * coordinator can wait for whichever finishes first without reaping
+ * anybody else's children.  If a worker dies, the others would wait at
+ * the barrier forever, so the whole group is killed.  Workers leave with
+ * _exit so that none of the parent's exit handlers run in them.
+ *
+ * The parent has other threads by the time this runs (the GUI thread,
+ * and the shared ThreadPool's workers once anything has used it).  Only
+ * the forking thread exists in a worker, so a worker must not touch
+ * anything those threads could have been holding a lock on at the time
+ * of the fork.  The shared pool's fork handlers take care of the pool:
+ * fork waits for any parallelFor in progress, and the workers get a pool
+ * with no threads.  Forking from inside a parallelFor would bypass that,
+ * hence the check at the top.  Beyond that, runWorker only allocates
+ * memory, which glibc makes safe across fork, and never draws or prints.
+ */
+bool runSharded(Grid<int>& board, BoundaryMode mode,
+                int numWorkers, int numGenerations, ShardReport& report) {
+    report.populations.clear();
+    report.errorMessage.clear();
+    if (numWorkers <= 0 || numGenerations < 0) {
+        report.errorMessage = "runSharded: need at least one worker and a non-negative number of generations";
+        return false;
+    }
+    if (ThreadPool::isInsideParallelFor()) {
+        report.errorMessage = "runSharded: cannot start worker processes from inside a parallel loop";
+        return false;
+    }
+    int numRows = board.numRows();
+    int numCols = board.numCols();
+    if (numRows == 0 || numCols == 0) {
+        report.populations.assign(numGenerations, 0);
+        return true;
+    }
+    if (numWorkers > numRows) {
+        numWorkers = numRows;
+    }
+
+    // create and map the segment
+    static int runCount = 0;
+    string name = "/life-shard-" + to_string(getpid()) + "-" + to_string(++runCount);
+    ShardSegment segment(numRows, numCols, numWorkers, numGenerations);
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        report.errorMessage = systemError("shm_open");
+        return false;
+    }
+    void* mapped = MAP_FAILED;
+    if (ftruncate(fd, segment.totalSize) == 0) {
+        mapped = mmap(nullptr, segment.totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (mapped == MAP_FAILED) {
+        report.errorMessage = systemError("mapping shared memory");
+    }
+    close(fd);
+    shm_unlink(name.c_str());
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    segment.base = static_cast<char*>(mapped);
+
+    // fill in the header and scatter the board
+    ShardHeader* header = segment.header();
+    header->numRows = numRows;
+    header->numCols = numCols;
+    header->numWorkers = numWorkers;
+    header->numGenerations = numGenerations;
+    pthread_barrierattr_t attr;
+    pthread_barrierattr_init(&attr);
+    pthread_barrierattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_barrier_init(&header->barrier, &attr, numWorkers);
+    pthread_barrierattr_destroy(&attr);
+    // the grid's rows may be padded (see Grid::pitch); the segment's are not
+    int* shared = segment.board();
+    for (int row = 0; row < numRows; row++) {
+        memcpy(shared + row * numCols, board.rowSpan(row).data(), sizeof(int) * numCols);
+    }
+
+    // start the workers
+    pid_t group = 0;
+    int started = 0;
+    for (; started < numWorkers; started++) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            report.errorMessage = systemError("fork");
+            break;
+        } else if (pid == 0) {
+            setpgid(0, group);
+            int status = 0;
+            try {
+                runWorker(segment, mode, started);
+            } catch (...) {
+                status = 1;
+            }
+            _exit(status);
+        }
+        setpgid(pid, group);
+        if (group == 0) {
+            group = pid;
+        }
+    }
+
+    // wait for them, giving up on all of them if any fails
+    bool ok = started == numWorkers;
+    if (!ok && started > 0) {
+        kill(-group, SIGKILL);
+    }
+    for (int i = 0; i < started; i++) {
+        int status;
+        if (waitpid(-group, &status, 0) < 0) {
+            report.errorMessage = systemError("waitpid");
+            ok = false;
+            break;
+        }
+        if (ok && (!WIFEXITED(status) || WEXITSTATUS(status) != 0)) {
+            report.errorMessage = "runSharded: a worker process failed";
+            ok = false;
+            kill(-group, SIGKILL);
+        }
+    }
+
+    // gather the results
+    if (ok) {
+        for (int row = 0; row < numRows; row++) {
+            memcpy(board.rowSpan(row).data(), shared + row * numCols, sizeof(int) * numCols);
+        }
+        const long long* populations = segment.populations();
+        report.populations.assign(numGenerations, 0);
+        for (int gen = 0; gen < numGenerations; gen++) {
+            for (int worker = 0; worker < numWorkers; worker++) {
+                report.populations[gen] += populations[gen * numWorkers + worker];
+            }
+        }
+    }
+    pthread_barrier_destroy(&header->barrier);
+    munmap(mapped, segment.totalSize);
+    return ok;
+}
+
+#else // __linux__
+
+bool runSharded(Grid<int>&, BoundaryMode, int, int, ShardReport& report) {
+    report.populations.clear();
+    report.errorMessage = "Sharded simulation is only available on Linux.";
+    return false;
+}
+
+#endif // __linux__
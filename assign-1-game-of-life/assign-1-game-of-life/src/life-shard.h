@@ -0,0 +1,49 @@
+/**
+ * File: life-shard.h
+ * ------------------
+ * Defines a way to simulate one board with several local worker processes,
+ * each of which holds only its own horizontal band of the board.
+ */
+
+#pragma once
+#include <string>           // for std::string
+#include <vector>           // for std::vector
+#include "grid.h"           // for Grid
+#include "life-boundary.h"  // for BoundaryMode
+
+/**
+ * Type: ShardReport
+ * -----------------
+ * What the coordinator collects from the workers during a sharded run.
+ * populations[g] is the number of occupied cells after generation g + 1.
+ */
+struct ShardReport {
+    std::vector<long long> populations;
+    std::string errorMessage;
+};
+
+/**
+ * Function: runSharded
+ * --------------------
+ * Advances the board by numGenerations generations using numWorkers worker
+ * processes forked from this one.  Each worker owns a contiguous band of
+ * rows; once per generation the workers publish the top and bottom rows of
+ * their bands in a POSIX shared memory segment, meet at a process-shared
+ * barrier, and read their neighbours' rows as their own ghost rows.  The
+ * calling process acts as coordinator: it scatters the starting board,
+ * waits for the workers, and gathers the final board and the population
+ * counts into the report.
+ *
+ * The result is the same as advancing the board one generation at a time
+ * with the given boundary mode.  Returns false (leaving the board
+ * unchanged) if the run could not be completed, in which case the report's
+ * errorMessage says why.  Only available on Linux.
+ *
+ * The workers are forked from a process that already has other threads,
+ * so they are limited to work that is safe after fork: they use neither
+ * the graphics window nor the console, and a ThreadPool::shared() in a
+ * worker has no threads of its own.  Must not be called from inside the
+ * body of a ThreadPool::parallelFor; that is reported as an error.
+ */
+bool runSharded(Grid<int>& board, BoundaryMode mode,
+                int numWorkers, int numGenerations, ShardReport& report);
@@ -0,0 +1,91 @@
+/**
+ * File: life-soup.cpp
+ * -------------------
+ * Implements seeded soup generation.  Randomness is a pure function of
+ * (seed, stream, counter), with one occupancy stream and one age stream
+ * per board row, which is what makes the result independent of how the
+ * rows are divided among worker threads.
+ */
+
+#include <random>    // for random_device
+#include <sstream>   // for istringstream
+using namespace std;
+#include "threadpool.h"  // for ThreadPool
+
+#include "life-constants.h"  // for kMaxAge, kMinRowsPerTask
+#include "life-soup.h"
+
+/*
+ * Implementation notes: soupRandom
+ * --------------------------------
+ * The seed, stream and counter are combined with two rounds of the
+ * SplitMix64 finalizer, whose avalanche behavior means that neighbouring
+ * counters (and neighbouring streams) give unrelated outputs.
+ */
+static uint64_t mix64(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+uint64_t soupRandom(uint64_t seed, uint64_t stream, uint64_t counter) {
+    uint64_t key = mix64(seed + stream * 0x9e3779b97f4a7c15ULL);
+    return mix64(key + counter * 0xd1b54a32d192ed03ULL);
+}
+
+uint64_t newSoupSeed() {
+    random_device device;
+    return (static_cast<uint64_t>(device()) << 32) ^ device();
+}
+
+bool stringToSoupSeed(const string& str, uint64_t& seed) {
+    istringstream input(str);
+    if (str.size() > 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+        input.ignore(2);
+        input >> hex;
+    }
+    uint64_t value;
+    if (!(input >> value) || !(input >> ws).eof() || str.find('-') != string::npos) {
+        return false;
+    }
+    seed = value;
+    return true;
+}
+
+/*
+ * Fills rows [firstRow, lastRow) of a row-major board of the given width
+ * whose rows are pitch cells apart.
+ * Occupancy comes from stream 2 * row, one 64-bit word per 64 cells; ages
+ * come from stream 2 * row + 1, four 16-bit lanes per word, scaled into
+ * the range 1..kMaxAge.  Age words are drawn for every fourth column
+ * whether or not the cells turn out to be occupied, so a cell's age only
+ * depends on its position.
+ */
+static void fillRows(int* cells, int numCols, int pitch, uint64_t seed,
+                     int firstRow, int lastRow) {
+    for (int row = firstRow; row < lastRow; row++) {
+        int* dst = cells + row * pitch;
+        uint64_t occupancy = 0;
+        uint64_t ages = 0;
+        for (int col = 0; col < numCols; col++) {
+            if ((col & 63) == 0) {
+                occupancy = soupRandom(seed, 2 * row, col >> 6);
+            }
+            if ((col & 3) == 0) {
+                ages = soupRandom(seed, 2 * row + 1, col >> 2);
+            }
+            int occupied = static_cast<int>((occupancy >> (col & 63)) & 1);
+            int lane = static_cast<int>((ages >> (16 * (col & 3))) & 0xffff);
+            dst[col] = occupied * (1 + ((lane * kMaxAge) >> 16));
+        }
+    }
+}
+
+void fillSoup(Grid<int>& board, uint64_t seed) {
+    int* cells = board.data();
+    int numCols = board.numCols();
+    int pitch = board.pitch();
+    ThreadPool::shared().parallelFor(0, board.numRows(), [=](int firstRow, int lastRow) {
+        fillRows(cells, numCols, pitch, seed, firstRow, lastRow);
+    }, kMinRowsPerTask);
+}
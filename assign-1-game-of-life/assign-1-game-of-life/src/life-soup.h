@@ -0,0 +1,60 @@
+/**
+ * File: life-soup.h
+ * -----------------
+ * Defines the functions that generate random starting colonies ("soups")
+ * from an explicit 64-bit seed, so that any run can be reproduced exactly.
+ */
+
+#pragma once
+#include <cstdint>   // for uint64_t
+#include <string>    // for std::string
+#include "grid.h"    // for Grid
+
+/**
+ * Constants
+ * ---------
+ * fillSoup only ever uses streams 0 through 2 * numRows - 1, so
+ * kSoupSpareStream is free for callers that want a few extra numbers
+ * derived from the same seed (such as the board dimensions).
+ */
+const uint64_t kSoupSpareStream = ~0ULL;
+
+/**
+ * Function: soupRandom
+ * --------------------
+ * Counter-based generator: returns 64 random bits that depend only on the
+ * seed, a stream number and a counter within that stream.  There is no
+ * hidden state, so any worker can produce any part of the sequence
+ * without coordinating with the others.
+ */
+uint64_t soupRandom(uint64_t seed, uint64_t stream, uint64_t counter);
+
+/**
+ * Function: newSoupSeed
+ * ---------------------
+ * Returns a fresh seed from the system's entropy source, for runs where
+ * the user did not ask for a particular one.
+ */
+uint64_t newSoupSeed();
+
+/**
+ * Function: stringToSoupSeed
+ * --------------------------
+ * Parses a seed typed in by the user (decimal, or hexadecimal with a 0x
+ * prefix).  Returns false if the string is not a valid 64-bit seed.
+ */
+bool stringToSoupSeed(const std::string& str, uint64_t& seed);
+
+/**
+ * Function: fillSoup
+ * ------------------
+ * Fills the board, at its current dimensions, with a random soup: each
+ * cell is occupied with probability 1/2, and occupied cells get a random
+ * age from 1 to kMaxAge.
+ *
+ * Each board row is its own random stream, and occupancy is drawn 64 cells
+ * per generator call, so the rows are filled by the shared thread pool.
+ * The same seed always produces the same board, however the rows happen
+ * to be divided among the threads.
+ */
+void fillSoup(Grid<int>& board, uint64_t seed);
@@ -4,6 +4,7 @@
  * Implements the Game of Life.
  */
 
+#include <algorithm> // for max
 #include <iostream>  // for cout
 #include <fstream>   // for files
 #include <string>    // for strings
@@ -14,18 +15,41 @@ using namespace std;
 #include "gevents.h" // for mouse event detection
 #include "gtimer.h"
 #include "strlib.h"
-#include "random.h"
 #include "filelib.h" // for files
+#include "threadpool.h" // for ThreadPool
 
-#include "life-constants.h"  // for kMaxAge
+#include "life-constants.h"  // for kMaxAge, kMinRowsPerTask
 #include "life-graphics.h"   // for class LifeDisplay
+#include "life-boundary.h"   // for BoundaryMode, class HaloBoard
+#include "life-rules.h"      // for nextAge
+#include "life-shard.h"      // for runSharded
+#include "life-export.h"     // for class FrameExporter
+#include "life-generations.h" // for GenerationsRule, class GenerationsBoard
+#include "life-soup.h"       // for fillSoup
 
-static void computeNext(LifeDisplay& display, Grid<int>& current, Grid<int>& next);
-static bool isNumNeighboursCorrect(Grid<int>& current, int row, int col,
-                                   int neighbours);
-static bool isDirectionEmpty(Grid<int>& current, int row, int col,
-                             int drow, int dcol);
-static bool isEmpty(Grid<int>& current, int row, int col);
+/**
+ * Type: LifeSession
+ * -----------------
+ * Everything besides the boards themselves that carries over from one
+ * generation to the next.
+ */
+struct LifeSession {
+    HaloBoard halo;                // neighbour counting with the chosen boundary mode
+    GenerationsBoard generations;  // steps the colony instead when the rule is not Conway's
+    FrameExporter exporter;        // records generations to disk when requested
+};
+
+/**
+ * Constants
+ * ---------
+ * Exported frames draw each cell as a kExportCellSize x kExportCellSize
+ * block of pixels, and animated GIFs use the "not too fast" speed.
+ */
+const int kExportCellSize = 4;
+const int kExportDelayMs = 100;
+
+static void computeNext(LifeDisplay& display, HaloBoard& halo,
+                        const Grid<int>& current, Grid<int>& next);
 
 /**
  * Function: welcome
@@ -43,32 +67,50 @@ static void welcome() {
     getLine("Hit [enter] to continue....   ");
 }
 
+/**
+ * Function: drawBoard
+ * -----------------
+ * Draws every cell of the board (the caller repaints).
+ */
+static void drawBoard(LifeDisplay& display, Grid<int>& current) {
+    for (int i = 0; i < current.numRows(); i++) {
+        for (int j = 0; j < current.numCols(); j++) {
+            display.drawCellAt(i, j, current.get(i, j));
+        }
+    }
+}
+
 /**
  * Function: randomInitialization
  * -----------------
  * Initialize a grid randomly.
+ * Everything about the colony, including its dimensions, is derived from
+ * a 64-bit seed that is shown to the user, so any colony can be recreated
+ * by entering its seed again.
  */
 static void randomInitialize(LifeDisplay& display, Grid<int>& current) {
+    // Get the seed.
+    uint64_t seed = 0;
+    string response = getLine("Enter a seed for the colony (or RETURN for a new one): ");
+    while (response != "" && !stringToSoupSeed(response, seed)) {
+        response = getLine("Please enter a non-negative 64-bit number (or RETURN for a new one): ");
+    }
+    if (response == "") {
+        seed = newSoupSeed();
+    }
+    cout << "Using seed " << seed << "." << endl;
+
     // Get a random row and column.
-    int row = randomInteger(40, 60),
-        col = randomInteger(40, 60);
+    int row = 40 + soupRandom(seed, kSoupSpareStream, 0) % 21,
+        col = 40 + soupRandom(seed, kSoupSpareStream, 1) % 21;
     current.resize(row, col);
 
     // initialize the grid
     display.setDimensions(current.numRows(), current.numCols());
 
     // set randomly
-    for (int i = 0; i < current.numRows(); i++) {
-        for (int j = 0; j < current.numCols(); j++) {
-            int prob = randomInteger(0, 100);
-            if (prob < 50) {
-                current[i][j] = 0;
-            } else {
-                current[i][j] = randomInteger(1, kMaxAge);
-            }
-            display.drawCellAt(i, j, current.get(i, j));
-        }
-    }
+    fillSoup(current, seed);
+    drawBoard(display, current);
     display.repaint();
 }
 
@@ -138,108 +180,181 @@ static void initialize(LifeDisplay& display, Grid<int>& current) {
 }
 
 /**
- * Function: computeNext
+ * Function: chooseBoundary
  * --------------
- * The rule for computing the next generation:
- * Rule 1
-   A location that has zero or one neighbour will be empty in the next generation.
-   Rule 2
-   A location with two neighbours is stable.
-   Rule 3
-   A location with three neighbours will contain a cell in the next generation.
-   If unoccupied, a new cell is born. If occupied, the cell remains.
-   Rule 4
-   A location with four or more neighbours will be empty in the next generation.
-   Rule 5
-   The births and deaths that tranform one generation to the next must take effect
-   simultaneously.
+ * Asks the user what lies beyond the edges of the board.
  */
-static void computeNext(LifeDisplay& display, Grid<int>& current, Grid<int>& next) {
-    next.resize(current.numRows(), current.numCols());
-    for (int i = 0; i < current.numRows(); i++) {
-        for (int j = 0; j < current.numCols(); j++) {
-            if (isNumNeighboursCorrect(current, i, j, 0) ||
-                isNumNeighboursCorrect(current, i, j, 1)) {    // empty in the next generation
-                next[i][j] = 0;
-            } else if (isNumNeighboursCorrect(current, i, j, 2)) {  // stable in the next generation
-                if (isEmpty(current, i, j)) {
-                    next[i][j] = 0; // remain empty
-                } else {
-                    next[i][j] = current[i][j] + 1; // the cell ages
-                }
-            } else if (isNumNeighboursCorrect(current, i, j, 3)) {
-                if (isEmpty(current, i, j)) {   // Empty before, a new cell is born.
-                    next[i][j] = 1;
-                } else {      // Currently contains a cell, it remains.
-                    next[i][j] = current[i][j] + 1; // the cell ages
-                }
-            } else {     // four or more neighbours
-                next[i][j] = 0; // empty in the next generation
-            }
-            display.drawCellAt(i, j, next.get(i, j));
+static void chooseBoundary(HaloBoard& halo) {
+    cout << "You choose what happens at the edges of the board." << endl;
+    cout << "\t1 = Cells beyond the edges are always dead." << endl;
+    cout << "\t2 = The board wraps around (top meets bottom, left meets right)." << endl;
+    cout << "\t3 = The board is mirrored across each edge." << endl;
+
+    while (true) {
+        int choice = getInteger("Your choice: ");
+        if (choice == 1) {
+            halo.setMode(DEAD_EDGES);
+            break;
+        } else if (choice == 2) {
+            halo.setMode(TOROIDAL);
+            break;
+        } else if (choice == 3) {
+            halo.setMode(REFLECTIVE);
+            break;
+        } else {
+            cout << "Please enter a number between 1 and 3!" << endl;
         }
     }
+    cout << "Using " << boundaryModeName(halo.getMode()) << " boundaries." << endl;
 }
 
 /**
- * Function: isNumNeighboursCorrect
+ * Function: chooseRule
  * --------------
- * Checks if the number of neighbours is correct compared to the given number.
- * Check the eight directions, if not empty, add one to numNeighbours.
- * if numNeighbours is equal to the given number, return true.
+ * Asks the user which rule the colony lives by.  Conway's rule is stepped
+ * by computeNext, which tracks the age of every cell; any other rule is
+ * treated as a Generations rule, and the colony is handed over to the
+ * Generations engine, where every occupied location starts out alive.
  */
-static bool isNumNeighboursCorrect(Grid<int>& current, int row, int col,
-                                   int neighbours) {
-    int numNeighbours = 0;
-
-    for (int drow = -1; drow <= 1; drow ++) {
-        for (int dcol = -1; dcol <= 1; dcol ++) {
-            if (!isDirectionEmpty(current, row, col, drow, dcol)) {
-                numNeighbours ++;
+static void chooseRule(LifeDisplay& display, LifeSession& session, Grid<int>& current) {
+    cout << "You choose the rule the colony lives by." << endl;
+    cout << "\t1 = Conway's Life (B3/S23), as described above." << endl;
+    cout << "\t2 = Brian's Brain (B2/S/C3): every cell dies right away, fading for a generation." << endl;
+    cout << "\t3 = Star Wars (B2/S345/C4): dying cells fade for two generations." << endl;
+    cout << "\t4 = Enter another rule in B/S/C notation." << endl;
+
+    GenerationsRule rule;
+    while (true) {
+        int choice = getInteger("Your choice: ");
+        if (choice == 1) {
+            break;
+        } else if (choice == 2) {
+            rule.parse("B2/S/C3");
+            break;
+        } else if (choice == 3) {
+            rule.parse("B2/S345/C4");
+            break;
+        } else if (choice == 4) {
+            while (!rule.parse(getLine("Rule (e.g. B36/S23 or B2/S34/C5): "))) {
+                cout << "Please enter a rule such as B2/S345/C4 (birth counts, survival counts, states)." << endl;
             }
+            break;
+        } else {
+            cout << "Please enter a number between 1 and 4!" << endl;
         }
     }
-    if (numNeighbours == neighbours) {
-        return true;
+    cout << "Using rule " << rule.toString() << "." << endl;
+
+    session.generations.setRule(rule);
+    session.generations.setMode(session.halo.getMode());
+    if (!rule.isConway()) {
+        session.generations.load(current);
+        session.generations.store(current);
+        drawBoard(display, current);
+        display.repaint();
     }
-    return false;
 }
 
 /**
- * Function: isDirectionEmpty
+ * Function: chooseExport
  * --------------
- * Check if the eight directions are empty.
- * If the location is the corner or the edge, then first check the directions
- * that are within the grid.
+ * Asks the user whether to record this run to disk, and if so starts the
+ * exporter and hands it the initial generation.
  */
-static bool isDirectionEmpty(Grid<int>& current, int row, int col,
-                             int drow, int dcol){
-    // calculate the coordiante of the given direction
-    row += drow;
-    col += dcol;
-
-    // assume the location do not affect numNeighbour
-    if (drow == 0 && dcol == 0) {
-        return true;
+static void chooseExport(FrameExporter& exporter, Grid<int>& current) {
+    string prefix = getLine("Enter a file prefix to record frames to (or RETURN to skip): ");
+    if (prefix == "") {
+        return;
     }
 
-    // check if the direction is within the grid
-    // if so, check if it is empty
-    // if outside the grid, return true, which means that there are no neighbours
-    if (current.inBounds(row, col)) {
-        return current[row][col] == 0;
+    cout << "You choose how to record the simulation." << endl;
+    cout << "\t1 = One black-and-white PBM image per frame." << endl;
+    cout << "\t2 = One grayscale PGM image per frame, shaded by age." << endl;
+    cout << "\t3 = A single animated GIF, shaded by age." << endl;
+
+    ExportFormat format;
+    while (true) {
+        int choice = getInteger("Your choice: ");
+        if (choice == 1) {
+            format = EXPORT_PBM;
+            break;
+        } else if (choice == 2) {
+            format = EXPORT_PGM;
+            break;
+        } else if (choice == 3) {
+            format = EXPORT_GIF;
+            break;
+        } else {
+            cout << "Please enter a number between 1 and 3!" << endl;
+        }
+    }
+
+    int every = getInteger("Record every how many generations? ");
+    while (every <= 0) {
+        every = getInteger("Please enter a positive number: ");
+    }
+
+    exporter.start(prefix, format, current.numRows(), current.numCols(),
+                   every, kExportCellSize, kExportDelayMs);
+    exporter.submit(current);
+}
+
+/**
+ * Function: finishExport
+ * --------------
+ * Waits for any recorded frames to reach the disk and reports the result.
+ */
+static void finishExport(FrameExporter& exporter) {
+    if (!exporter.isRecording()) {
+        return;
+    }
+    if (exporter.finish()) {
+        cout << "Recorded " << exporter.getFrameCount() << " frame(s)." << endl;
     } else {
-        return true;
+        cout << exporter.getErrorMessage() << endl;
     }
 }
 
 /**
- * Function: isEmpty
+ * Function: computeNext
  * --------------
- * Check if the location is empty.
+ * The rule for computing the next generation:
+ * Rule 1
+   A location that has zero or one neighbour will be empty in the next generation.
+   Rule 2
+   A location with two neighbours is stable.
+   Rule 3
+   A location with three neighbours will contain a cell in the next generation.
+   If unoccupied, a new cell is born. If occupied, the cell remains.
+   Rule 4
+   A location with four or more neighbours will be empty in the next generation.
+   Rule 5
+   The births and deaths that tranform one generation to the next must take effect
+   simultaneously.
+ *
+ * The current generation is first copied into the halo board, which takes
+ * care of the edges according to the chosen boundary mode.  After that,
+ * every location has eight neighbours in memory and the rules above reduce
+ * to arithmetic (see nextAge).  The rows are computed by the shared thread
+ * pool, and the new generation is drawn afterwards on this thread.
  */
-static bool isEmpty(Grid<int>& current, int row, int col) {
-    return current[row][col] == 0;
+static void computeNext(LifeDisplay& display, HaloBoard& halo,
+                        const Grid<int>& current, Grid<int>& next) {
+    // every cell is overwritten below, so keep next's storage as it is
+    next.resize(current.numRows(), current.numCols(), /* retain */ true);
+    halo.load(current);
+    int* out = next.data();
+    int pitch = next.pitch();
+    ThreadPool::shared().parallelFor(0, current.numRows(), [&](int firstRow, int lastRow) {
+        for (int i = firstRow; i < lastRow; i++) {
+            Grid<int>::ConstRowSpan cur = current.rowSpan(i);
+            int* dst = out + i * pitch;
+            for (int j = 0; j < cur.size(); j++) {
+                dst[j] = nextAge(cur[j], halo.liveNeighbours(i, j));
+            }
+        }
+    }, kMinRowsPerTask);
+    drawBoard(display, next);
 }
 
 /**
@@ -247,9 +362,17 @@ static bool isEmpty(Grid<int>& current, int row, int col) {
  * --------------
  * Advace the grid.
  */
-static void advance(LifeDisplay& display, Grid<int>& current, Grid<int>& next) {
-    computeNext(display, current, next);
-    current = next;
+static void advance(LifeDisplay& display, LifeSession& session,
+                    Grid<int>& current, Grid<int>& next) {
+    if (session.generations.getRule().isConway()) {
+        computeNext(display, session.halo, current, next);
+        current = next;
+    } else {
+        session.generations.step();
+        session.generations.store(current);
+        drawBoard(display, current);
+    }
+    session.exporter.submit(current);
     display.repaint();
 }
 
@@ -260,13 +383,14 @@ static void advance(LifeDisplay& display, Grid<int>& current, Grid<int>& next) {
  * ms controls the speed of the animation.
  * When the mouse is clicked, the animation stops.
  */
-static void runAnimation(LifeDisplay& display, Grid<int>& current, Grid<int>& next, int ms) {
+static void runAnimation(LifeDisplay& display, LifeSession& session,
+                         Grid<int>& current, Grid<int>& next, int ms) {
     GTimer timer(ms);
     timer.start();
     while (true) {
         GEvent event = waitForEvent(TIMER_EVENT + MOUSE_EVENT);
         if (event.getEventClass() == TIMER_EVENT) {
-            advance(display, current, next);
+            advance(display, session, current, next);
         } else if (event.getEventType() == MOUSE_PRESSED) {
             break;
         }
@@ -274,17 +398,61 @@ static void runAnimation(LifeDisplay& display, Grid<int>& current, Grid<int>& ne
     timer.stop();
 }
 
+/**
+ * Function: runInWorkers
+ * --------------
+ * Advances many generations at once by splitting the board across several
+ * worker processes, reports how the population changed along the way, and
+ * shows where the colony ended up.
+ */
+static void runInWorkers(LifeDisplay& display, LifeSession& session, Grid<int>& current) {
+    if (!session.generations.getRule().isConway()) {
+        cout << "Worker processes can only run Conway's rule." << endl;
+        return;
+    }
+
+    int generations = getInteger("How many generations? ");
+    while (generations <= 0) {
+        generations = getInteger("Please enter a positive number: ");
+    }
+    int workers = getInteger("How many worker processes? ");
+    while (workers <= 0) {
+        workers = getInteger("Please enter a positive number: ");
+    }
+
+    ShardReport report;
+    if (!runSharded(current, session.halo.getMode(), workers, generations, report)) {
+        cout << report.errorMessage << endl;
+        return;
+    }
+
+    // report about ten evenly spaced population counts, always including the last
+    int step = max(1, generations / 10);
+    for (int gen = step; gen <= generations; gen += step) {
+        cout << "\tGeneration " << gen << ": " << report.populations[gen - 1] << " cells" << endl;
+    }
+    if (generations % step != 0) {
+        cout << "\tGeneration " << generations << ": " << report.populations.back() << " cells" << endl;
+    }
+
+    drawBoard(display, current);
+    session.exporter.submit(current);
+    display.repaint();
+}
+
 /**
  * Function: setSpeed
  * --------------
  * Set the speed of the animation.
  */
-static int setSpeed(LifeDisplay& display, Grid<int>& current, Grid<int>& next) {
+static int setSpeed(LifeDisplay& display, LifeSession& session,
+                    Grid<int>& current, Grid<int>& next) {
     cout << "You choose how fast to run the simulation." << endl;
     cout << "\t1 = As fast as this chip can go!" << endl;
     cout << "\t2 = Not too fast, this is a school zone." << endl;
     cout << "\t3 = Nice and slow so I can watch everything that happens." << endl;
     cout << "\t4 = Require enter key be pressed before advancing to next generation." << endl;
+    cout << "\t5 = Jump ahead many generations using several worker processes." << endl;
 
     int ms = 0;     // speed of the animation
 
@@ -305,12 +473,15 @@ static int setSpeed(LifeDisplay& display, Grid<int>& current, Grid<int>& next) {
                if (adv == "quit") {
                    break;
                } else {
-                   advance(display, current, next);
+                   advance(display, session, current, next);
                }
             }
             break;
+        } else if (choice == 5) {
+            runInWorkers(display, session, current);
+            break;
         } else {
-            cout << "Please enter a number between 1 and 4!" << endl;
+            cout << "Please enter a number between 1 and 5!" << endl;
         }
     }
     return ms;
@@ -321,26 +492,32 @@ static int setSpeed(LifeDisplay& display, Grid<int>& current, Grid<int>& next) {
  * --------------
  * Start the game.
  */
-static void start(LifeDisplay& display, Grid<int>& current, Grid<int>& next) {
+static void start(LifeDisplay& display, LifeSession& session,
+                  Grid<int>& current, Grid<int>& next) {
     // initialization
     initialize(display, current);
+    chooseBoundary(session.halo);
+    chooseRule(display, session, current);
+    chooseExport(session.exporter, current);
 
     // animate the world
-    int ms = setSpeed(display, current, next);
+    int ms = setSpeed(display, session, current, next);
     if (ms != 0) {
-        runAnimation(display, current, next, ms);
+        runAnimation(display, session, current, next, ms);
     }
+    finishExport(session.exporter);
 }
 /**
  * Function: restart
  * --------------
  * Restart the game.
  */
-static void restart(LifeDisplay& display, Grid<int>& current, Grid<int>& next) {
+static void restart(LifeDisplay& display, LifeSession& session,
+                    Grid<int>& current, Grid<int>& next) {
     while (true) {
         string run = getLine("Would you like to run another?");
         if (run == "yes") {
-            start(display, current, next);
+            start(display, session, current, next);
         } else if (run == "no") {
             break;
         } else {
@@ -361,10 +538,11 @@ int main() {
 
     Grid<int> current;
     Grid<int> next;
+    LifeSession session;
 
     // Play the game.
-    start(display, current, next);
-    restart(display, current, next);
+    start(display, session, current, next);
+    restart(display, session, current, next);
 
     return 0;
 }